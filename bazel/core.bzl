@@ -278,6 +278,8 @@ MLN_CORE_SOURCE = [
     "src/mbgl/renderer/cross_faded_property_evaluator.cpp",
     "src/mbgl/renderer/cross_faded_property_evaluator.hpp",
     "src/mbgl/renderer/data_driven_property_evaluator.hpp",
+    "src/mbgl/renderer/frame_budget.cpp",
+    "src/mbgl/renderer/frame_budget.hpp",
     "src/mbgl/renderer/group_by_layout.cpp",
     "src/mbgl/renderer/group_by_layout.hpp",
     "src/mbgl/renderer/image_atlas.cpp",
@@ -376,6 +378,8 @@ MLN_CORE_SOURCE = [
     "src/mbgl/storage/resource_options.cpp",
     "src/mbgl/storage/resource_transform.cpp",
     "src/mbgl/storage/response.cpp",
+    "src/mbgl/storage/response_buffer_pool.cpp",
+    "src/mbgl/storage/response_buffer_pool.hpp",
     "src/mbgl/style/collection.hpp",
     "src/mbgl/style/conversion/color_ramp_property_value.cpp",
     "src/mbgl/style/conversion/constant.cpp",
@@ -525,6 +529,8 @@ MLN_CORE_SOURCE = [
     "src/mbgl/text/glyph_range.hpp",
     "src/mbgl/text/language_tag.cpp",
     "src/mbgl/text/language_tag.hpp",
+    "src/mbgl/text/local_glyph_cache.cpp",
+    "src/mbgl/text/local_glyph_cache.hpp",
     "src/mbgl/text/local_glyph_rasterizer.hpp",
     "src/mbgl/text/placement.cpp",
     "src/mbgl/text/placement.hpp",
@@ -570,6 +576,8 @@ MLN_CORE_SOURCE = [
     "src/mbgl/util/camera.hpp",
     "src/mbgl/util/bounding_volumes.hpp",
     "src/mbgl/util/bounding_volumes.cpp",
+    "src/mbgl/util/cache_file.cpp",
+    "src/mbgl/util/cache_file.hpp",
     "src/mbgl/util/chrono.cpp",
     "src/mbgl/util/client_options.cpp",
     "src/mbgl/util/color.cpp",
@@ -615,6 +623,7 @@ MLN_CORE_SOURCE = [
     "src/mbgl/util/quaternion.hpp",
     "src/mbgl/gfx/polyline_generator.cpp",
     "src/mbgl/gfx/fill_generator.cpp",
+    "src/mbgl/gfx/drawable_geometry.cpp",
     "src/mbgl/util/rapidjson.cpp",
     "src/mbgl/util/rapidjson.hpp",
     "src/mbgl/util/rect.hpp",
@@ -824,6 +833,7 @@ MLN_CORE_HEADERS = [
     "include/mbgl/util/platform.hpp",
     "include/mbgl/gfx/polyline_generator.hpp",
     "include/mbgl/gfx/fill_generator.hpp",
+    "include/mbgl/gfx/drawable_geometry.hpp",
     "include/mbgl/util/premultiply.hpp",
     "include/mbgl/util/projection.hpp",
     "include/mbgl/util/range.hpp",
@@ -850,6 +860,8 @@ MLN_CORE_HEADERS = [
 MLN_OPENGL_SOURCE = [
     "src/mbgl/gl/attribute.cpp",
     "src/mbgl/gl/attribute.hpp",
+    "src/mbgl/gl/buffer_allocator.cpp",
+    "src/mbgl/gl/buffer_allocator.hpp",
     "src/mbgl/gl/command_encoder.cpp",
     "src/mbgl/gl/command_encoder.hpp",
     "src/mbgl/gl/context.cpp",
@@ -869,6 +881,8 @@ MLN_OPENGL_SOURCE = [
     "src/mbgl/gl/offscreen_texture.cpp",
     "src/mbgl/gl/offscreen_texture.hpp",
     "src/mbgl/gl/program.hpp",
+    "src/mbgl/gl/program_binary_cache.cpp",
+    "src/mbgl/gl/program_binary_cache.hpp",
     "src/mbgl/gl/render_pass.cpp",
     "src/mbgl/gl/render_pass.hpp",
     "src/mbgl/gl/renderbuffer_resource.hpp",
@@ -995,6 +1009,8 @@ MLN_DRAWABLES_HEADERS = [
 ]
 
 MLN_DRAWABLES_GL_SOURCE = [
+    "src/mbgl/gl/command_list.cpp",
+    "src/mbgl/gl/command_list.hpp",
     "src/mbgl/gl/drawable_gl.cpp",
     "src/mbgl/gl/drawable_gl_builder.cpp",
     "src/mbgl/gl/drawable_gl_impl.hpp",
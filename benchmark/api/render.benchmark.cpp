@@ -15,6 +15,7 @@
 #include <mbgl/util/io.hpp>
 #include <mbgl/util/run_loop.hpp>
 
+#include <cstdio>
 #include <sstream>
 #include <optional>
 
@@ -60,9 +61,12 @@ static void API_renderStill_reuse_map(::benchmark::State& state) {
             ResourceOptions().withCachePath(cachePath).withApiKey("foobar")};
     prepare(map);
 
+    gfx::RenderingStats stats;
     for (auto _ : state) {
-        frontend.render(map);
+        stats = frontend.render(map).stats;
     }
+
+    state.counters["drawCalls"] = stats.numDrawCalls;
 }
 
 static void API_renderStill_reuse_map_formatted_labels(::benchmark::State& state) {
@@ -123,6 +127,51 @@ static void API_renderStill_recreate_map_2(::benchmark::State& state) {
     }
 }
 
+static void API_renderStill_pitched(::benchmark::State& state) {
+    RenderBenchmark bench;
+    HeadlessFrontend frontend{size, pixelRatio};
+    Map map{frontend,
+            MapObserver::nullObserver(),
+            MapOptions().withMapMode(MapMode::Static).withSize(size).withPixelRatio(pixelRatio),
+            ResourceOptions().withCachePath(cachePath).withApiKey("foobar")};
+    prepare(map);
+    map.jumpTo(CameraOptions().withPitch(60.0).withBearing(30.0));
+
+    gfx::RenderingStats stats;
+    for (auto _ : state) {
+        stats = frontend.render(map).stats;
+    }
+
+    // Tile drawables skipped by culling, compared to the ones drawn
+    state.counters["culledDrawables"] = stats.numCulledDrawables;
+    state.counters["drawCalls"] = stats.numDrawCalls;
+    // Bindings skipped because the previous drawable left them in place
+    state.counters["elidedBinds"] = stats.numElidedBinds;
+}
+
+// Time to the first frame of a new map, which includes compiling its shaders unless they were
+// loaded from the program binary cache kept next to the cache database
+static void API_renderStill_first_frame(::benchmark::State& state) {
+    const bool cachedPrograms = state.range(0) != 0;
+    RenderBenchmark bench;
+
+    for (auto _ : state) {
+        if (!cachedPrograms) {
+            state.PauseTiming();
+            std::remove((cachePath + "-programs").c_str());
+            state.ResumeTiming();
+        }
+
+        HeadlessFrontend frontend{size, pixelRatio};
+        Map map{frontend,
+                MapObserver::nullObserver(),
+                MapOptions().withMapMode(MapMode::Static).withSize(size).withPixelRatio(pixelRatio),
+                ResourceOptions().withCachePath(cachePath).withApiKey("foobar")};
+        prepare(map);
+        frontend.render(map);
+    }
+}
+
 static void API_renderStill_multiple_sources(::benchmark::State& state) {
     using namespace mbgl::style;
     RenderBenchmark bench;
@@ -159,4 +208,11 @@ BENCHMARK(API_renderStill_reuse_map_formatted_labels)->Unit(benchmark::kMillisec
 BENCHMARK(API_renderStill_reuse_map_switch_styles)->Unit(benchmark::kMillisecond)->Iterations(50);
 BENCHMARK(API_renderStill_recreate_map)->Unit(benchmark::kMillisecond)->Iterations(50);
 BENCHMARK(API_renderStill_recreate_map_2)->Unit(benchmark::kMillisecond)->Iterations(50);
+BENCHMARK(API_renderStill_pitched)->Unit(benchmark::kMillisecond)->Iterations(50);
+BENCHMARK(API_renderStill_first_frame)
+    ->ArgName("cachedPrograms")
+    ->Arg(0)
+    ->Arg(1)
+    ->Unit(benchmark::kMillisecond)
+    ->Iterations(20);
 BENCHMARK(API_renderStill_multiple_sources)->Unit(benchmark::kMillisecond)->Iterations(50);
@@ -0,0 +1,133 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/layout/symbol_projection.hpp>
+#include <mbgl/map/transform.hpp>
+#include <mbgl/renderer/buckets/symbol_bucket.hpp>
+#include <mbgl/util/constants.hpp>
+#include <mbgl/util/tile_cover.hpp>
+
+#include <cmath>
+
+using namespace mbgl;
+
+namespace {
+
+// A street-level view looking towards the horizon.
+TransformState pitchedStreetView() {
+    Transform transform;
+    transform.resize({1024, 768});
+    transform.jumpTo(
+        CameraOptions().withCenter(LatLng{37.7749, -122.4194}).withZoom(17.0).withBearing(30.0).withPitch(60.0));
+    return transform.getState();
+}
+
+mat4 labelPlaneMatrixFor(const TransformState& state) {
+    const UnwrappedTileID id = util::tileCover(state, 17).front().toUnwrapped();
+    mat4 projMatrix;
+    state.getProjMatrix(projMatrix);
+    mat4 posMatrix;
+    state.matrixFor(posMatrix, id);
+    matrix::multiply(posMatrix, projMatrix, posMatrix);
+    const float pixelsToTileUnits = id.pixelsToTileUnits(1.0f, static_cast<float>(state.getZoom()));
+    return getLabelPlaneMatrix(posMatrix, false, false, state, pixelsToTileUnits);
+}
+
+// A curvy road crossing the tile.
+GeometryCoordinates curvyLine() {
+    GeometryCoordinates line;
+    for (int16_t i = 0; i < 256; ++i) {
+        line.emplace_back(static_cast<int16_t>(i * util::EXTENT / 256),
+                          static_cast<int16_t>(util::EXTENT / 2 + std::sin(i * 0.2) * 300));
+    }
+    return line;
+}
+
+PlacedSymbol curvyLabel() {
+    const GeometryCoordinates line = curvyLine();
+    const std::size_t segment = line.size() / 2;
+    PlacedSymbol symbol(convertPoint<float>(line[segment]),
+                        segment,
+                        16.0f,
+                        16.0f,
+                        {{0.0f, 0.0f}},
+                        WritingModeType::Horizontal,
+                        line,
+                        std::vector<float>(line.size(), 0.0f));
+    // 24 glyphs, centered on the anchor.
+    for (int i = -12; i < 12; ++i) {
+        symbol.glyphOffsets.push_back(i * 10.0f + 5.0f);
+    }
+    return symbol;
+}
+
+} // namespace
+
+static void SymbolProjection_ProjectLinePerPoint(benchmark::State& state) {
+    const mat4 labelPlaneMatrix = labelPlaneMatrixFor(pitchedStreetView());
+    const GeometryCoordinates line = curvyLine();
+    std::vector<PointAndCameraDistance> projected(line.size());
+
+    while (state.KeepRunning()) {
+        for (std::size_t i = 0; i < line.size(); ++i) {
+            projected[i] = project(convertPoint<float>(line[i]), labelPlaneMatrix);
+        }
+        benchmark::DoNotOptimize(projected.data());
+    }
+}
+
+static void SymbolProjection_ProjectLineBatched(benchmark::State& state) {
+    const mat4 labelPlaneMatrix = labelPlaneMatrixFor(pitchedStreetView());
+    const GeometryCoordinates line = curvyLine();
+    std::vector<PointAndCameraDistance> projected(line.size());
+
+    while (state.KeepRunning()) {
+        projectPoints(line, 0, line.size(), labelPlaneMatrix, projected.data());
+        benchmark::DoNotOptimize(projected.data());
+    }
+}
+
+static void placeGlyphs(benchmark::State& state, bool shareProjectedLine) {
+    const mat4 labelPlaneMatrix = labelPlaneMatrixFor(pitchedStreetView());
+    const PlacedSymbol symbol = curvyLabel();
+    const Point<float> anchorPoint = project(symbol.anchorPoint, labelPlaneMatrix).first;
+    const float fontScale = 16.0f / util::ONE_EM;
+    ProjectedLineCache projectedLine;
+    PlacedSymbol pair = symbol;
+
+    while (state.KeepRunning()) {
+        if (shareProjectedLine) {
+            projectedLine.reset(symbol.line, labelPlaneMatrix);
+        }
+        // Place glyphs pairwise from the outside in, as each glyph is placed
+        // independently along the line.
+        for (std::size_t i = 0; i < symbol.glyphOffsets.size() / 2; ++i) {
+            pair.glyphOffsets = {symbol.glyphOffsets[i], symbol.glyphOffsets[symbol.glyphOffsets.size() - 1 - i]};
+            auto placed = shareProjectedLine
+                              ? placeFirstAndLastGlyph(
+                                    fontScale, 0, 0, false, anchorPoint, symbol.anchorPoint, pair, projectedLine, false)
+                              : placeFirstAndLastGlyph(fontScale,
+                                                       0,
+                                                       0,
+                                                       false,
+                                                       anchorPoint,
+                                                       symbol.anchorPoint,
+                                                       pair,
+                                                       labelPlaneMatrix,
+                                                       false);
+            benchmark::DoNotOptimize(placed);
+        }
+    }
+}
+
+static void SymbolProjection_PlaceGlyphsAlongLine(benchmark::State& state) {
+    placeGlyphs(state, false);
+}
+
+static void SymbolProjection_PlaceGlyphsAlongProjectedLine(benchmark::State& state) {
+    placeGlyphs(state, true);
+}
+
+BENCHMARK(SymbolProjection_ProjectLinePerPoint);
+BENCHMARK(SymbolProjection_ProjectLineBatched);
+BENCHMARK(SymbolProjection_PlaceGlyphsAlongLine);
+BENCHMARK(SymbolProjection_PlaceGlyphsAlongProjectedLine);
@@ -0,0 +1,82 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/style/layers/symbol_layer_properties.hpp>
+#include <mbgl/text/glyph.hpp>
+#include <mbgl/text/quads.hpp>
+#include <mbgl/tile/vector_tile_data.hpp>
+#include <mbgl/util/io.hpp>
+
+using namespace mbgl;
+
+namespace {
+
+// One single-line shaping per named feature of a street tile, with a glyph of
+// fixed metrics for every non-space character of the name.
+std::vector<Shaping> shapeTileLabels() {
+    auto data = std::make_shared<std::string>(
+        util::read_file("test/fixtures/api/assets/streets/10-163-395.vector.pbf"));
+    VectorTileData tile(data);
+
+    const GlyphMetrics metrics{/*width=*/14, /*height=*/18, /*left=*/1, /*top=*/-4, /*advance=*/16};
+    std::vector<Shaping> shapings;
+    for (const auto& name : tile.layerNames()) {
+        auto layer = tile.getLayer(name);
+        if (!layer) continue;
+        for (std::size_t i = 0; i < layer->featureCount(); ++i) {
+            const auto value = layer->getFeature(i)->getValue("name");
+            if (!value || !value->is<std::string>()) continue;
+            const auto& text = value->get<std::string>();
+
+            Shaping shaping(0, 0, WritingModeType::Horizontal);
+            shaping.positionedLines.emplace_back();
+            float x = 0;
+            for (const char c : text) {
+                if (c != ' ') {
+                    shaping.positionedLines.back().positionedGlyphs.emplace_back(
+                        static_cast<GlyphID>(static_cast<unsigned char>(c)),
+                        x,
+                        0.0f,
+                        false,
+                        0,
+                        1.0f,
+                        Rect<uint16_t>{0, 0, 20, 24},
+                        metrics,
+                        std::nullopt);
+                }
+                x += metrics.advance;
+            }
+            shapings.push_back(std::move(shaping));
+        }
+    }
+    return shapings;
+}
+
+} // namespace
+
+// Memory held by the glyph quads of a tile's labels between layout and bucket
+// creation, as float quads and in the packed form symbol instances keep.
+static void Layout_SymbolQuads(::benchmark::State& state) {
+    const auto shapings = shapeTileLabels();
+    const style::SymbolLayoutProperties::Evaluated layout;
+
+    std::size_t floatBytes = 0;
+    std::size_t packedBytes = 0;
+    for (auto _ : state) {
+        floatBytes = 0;
+        packedBytes = 0;
+        for (const auto& shaping : shapings) {
+            const auto quads = getGlyphQuads(
+                shaping, {{0.0f, 0.0f}}, layout, style::SymbolPlacementType::Point, {}, false);
+            const auto packed = packSymbolQuads(quads);
+            floatBytes += quads.size() * sizeof(SymbolQuad);
+            packedBytes += packed.size() * sizeof(PackedSymbolQuad);
+            benchmark::DoNotOptimize(packed.data());
+        }
+    }
+
+    state.counters["labels"] = static_cast<double>(shapings.size());
+    state.counters["floatQuadBytes"] = static_cast<double>(floatBytes);
+    state.counters["packedQuadBytes"] = static_cast<double>(packedBytes);
+}
+
+BENCHMARK(Layout_SymbolQuads);
@@ -0,0 +1,107 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/storage/http_file_source.hpp>
+#include <mbgl/storage/resource.hpp>
+#include <mbgl/storage/resource_options.hpp>
+#include <mbgl/storage/response.hpp>
+#include <mbgl/util/client_options.hpp>
+#include <mbgl/util/monotonic_timer.hpp>
+#include <mbgl/util/run_loop.hpp>
+#include <mbgl/util/string.hpp>
+
+#define CPPHTTPLIB_THREAD_POOL_COUNT 8
+#include <httplib.h>
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace mbgl;
+
+namespace {
+
+constexpr int serverPort = 3001;
+constexpr std::size_t burstSize = 64;
+constexpr std::size_t tileSize = 32 * 1024;
+
+// Serves tile-sized responses after a short delay, standing in for a tile server's latency
+class TileServer {
+public:
+    TileServer() {
+        server.Get(R"(/tiles/(\d+))", [](const httplib::Request&, httplib::Response& res) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            res.set_header("Cache-Control", "max-age=3600");
+            res.set_content(std::string(tileSize, 'x'), "application/x-protobuf");
+        });
+        thread = std::thread([this] { server.listen("127.0.0.1", serverPort); });
+        while (!server.is_running()) {
+            std::this_thread::yield();
+        }
+    }
+
+    ~TileServer() {
+        server.stop();
+        thread.join();
+    }
+
+private:
+    httplib::Server server;
+    std::thread thread;
+};
+
+// Requests bursts of tiles like a map moving to a new area, and measures the time from
+// issuing each request to its response.
+void HTTPFileSource_TileBurst(benchmark::State& state, ClientOptions clientOptions) {
+    TileServer server;
+    util::RunLoop loop;
+    HTTPFileSource fileSource(ResourceOptions(), clientOptions);
+
+    double totalLatency = 0;
+    std::size_t responses = 0;
+    std::size_t errors = 0;
+    std::size_t tile = 0;
+
+    for (auto _ : state) {
+        std::vector<std::unique_ptr<AsyncRequest>> requests;
+        requests.reserve(burstSize);
+        std::size_t pending = burstSize;
+        for (std::size_t i = 0; i < burstSize; ++i) {
+            const auto url = "http://127.0.0.1:" + util::toString(serverPort) + "/tiles/" + util::toString(tile++);
+            const auto start = util::MonotonicTimer::now();
+            requests.push_back(fileSource.request(Resource(Resource::Kind::Tile, url), [&, start](Response res) {
+                totalLatency += (util::MonotonicTimer::now() - start).count();
+                responses++;
+                errors += res.error ? 1 : 0;
+                if (--pending == 0) {
+                    loop.stop();
+                }
+            }));
+        }
+        loop.run();
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(responses));
+    state.SetBytesProcessed(static_cast<int64_t>(responses * tileSize));
+    state.counters["latency_ms"] = responses ? 1000 * totalLatency / responses : 0;
+    state.counters["errors"] = static_cast<double>(errors);
+}
+
+void HTTPFileSource_TileBurst_Unlimited(benchmark::State& state) {
+    HTTPFileSource_TileBurst(state, ClientOptions());
+}
+
+void HTTPFileSource_TileBurst_PerHost(benchmark::State& state) {
+    HTTPFileSource_TileBurst(state,
+                             ClientOptions().withMaximumConnectionsPerHost(static_cast<uint32_t>(state.range(0))));
+}
+
+void HTTPFileSource_TileBurst_NoReuse(benchmark::State& state) {
+    // A single pooled connection, so nearly every request pays for a new connection
+    HTTPFileSource_TileBurst(state, ClientOptions().withHTTP2(false).withConnectionPoolSize(1));
+}
+
+} // namespace
+
+BENCHMARK(HTTPFileSource_TileBurst_Unlimited)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(HTTPFileSource_TileBurst_PerHost)->Arg(2)->Arg(6)->Arg(16)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(HTTPFileSource_TileBurst_NoReuse)->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -6,8 +6,30 @@
 #include <mbgl/storage/sqlite3.hpp>
 #include <mbgl/util/string.hpp>
 #include <mbgl/util/logging.hpp>
+#include <mbgl/util/io.hpp>
 
+#include <atomic>
+#include <mutex>
+#include <optional>
 #include <random>
+#include <thread>
+
+namespace {
+
+// Stand-ins for vector tiles, which deflate well, and for raster tiles, which
+// are already compressed.
+std::shared_ptr<std::string> makeTileData(bool raster) {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<> dis(0, raster ? 255 : 31);
+
+    auto data = std::make_shared<std::string>(raster ? std::string("\x89PNG\r\n\x1a\n", 8) : std::string());
+    while (data->size() < 50 * 1024) {
+        data->push_back(static_cast<char>(dis(gen)));
+    }
+    return data;
+}
+
+} // namespace
 
 class OfflineDatabase : public benchmark::Fixture {
 public:
@@ -200,3 +222,132 @@ BENCHMARK_F(OfflineDatabase, ResizeDatabase)(benchmark::State& state) {
         }
     }
 }
+
+// Arguments: codec (mbgl::OfflineCompression), raster (0 or 1)
+BENCHMARK_DEFINE_F(OfflineDatabase, PutTileWithCompression)(benchmark::State& state) {
+    using namespace mbgl;
+
+    db.setCompression(static_cast<OfflineCompression>(state.range(0)));
+    Response tile;
+    tile.data = makeTileData(state.range(1) != 0);
+
+    uint64_t storedSize = 0;
+    while (state.KeepRunning()) {
+        const Resource ambient = Resource::tile(
+            "mapbox://PutTileWithCompression" + util::toString(state.iterations()), 1, 0, 0, 0, Tileset::Scheme::XYZ);
+        storedSize += db.put(ambient, tile).second;
+    }
+
+    state.SetBytesProcessed(state.iterations() * tile.data->size());
+    state.counters["stored"] = static_cast<double>(storedSize) / state.iterations();
+}
+
+BENCHMARK_REGISTER_F(OfflineDatabase, PutTileWithCompression)
+    ->ArgNames({"codec", "raster"})
+    ->Args({0, 0})
+    ->Args({1, 0})
+    ->Args({0, 1})
+    ->Args({1, 1});
+
+BENCHMARK_DEFINE_F(OfflineDatabase, GetTileWithCompression)(benchmark::State& state) {
+    using namespace mbgl;
+
+    db.setCompression(static_cast<OfflineCompression>(state.range(0)));
+    Response tile;
+    tile.data = makeTileData(state.range(1) != 0);
+    for (unsigned i = 0; i < tileCount; ++i) {
+        db.put(Resource::tile("mapbox://GetTileWithCompression" + util::toString(i), 1, 0, 0, 0, Tileset::Scheme::XYZ),
+               tile);
+    }
+
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<> dis(0, tileCount - 1);
+
+    while (state.KeepRunning()) {
+        auto res = db.get(Resource::tile(
+            "mapbox://GetTileWithCompression" + util::toString(dis(gen)), 1, 0, 0, 0, Tileset::Scheme::XYZ));
+        assert(res != std::nullopt);
+    }
+
+    state.SetBytesProcessed(state.iterations() * tile.data->size());
+}
+
+BENCHMARK_REGISTER_F(OfflineDatabase, GetTileWithCompression)
+    ->ArgNames({"codec", "raster"})
+    ->Args({0, 0})
+    ->Args({1, 0})
+    ->Args({0, 1})
+    ->Args({1, 1});
+
+// Cache hits while another thread keeps storing tiles, like DatabaseFileSource
+// during an offline download. The reads either share the writer's connection,
+// queueing behind its writes, or use a read-only connection of their own.
+static void OfflineDatabase_GetTileDuringWrites(benchmark::State& state) {
+    using namespace mbgl;
+    using namespace std::chrono_literals;
+
+    const std::string path = "benchmark/fixtures/offline_database.db";
+    const auto deleteDatabaseFiles = [&] {
+        for (const char* suffix : {"", "-wal", "-shm", "-journal"}) {
+            util::deleteFile(path + suffix);
+        }
+    };
+    deleteDatabaseFiles();
+
+    {
+        const unsigned tileCount = 100;
+        mbgl::OfflineDatabase writer(path, TileServerOptions::DefaultConfiguration());
+
+        Response response;
+        response.data = std::make_shared<std::string>(50 * 1024, 0);
+        response.mustRevalidate = false;
+        response.expires = util::now() + 1h;
+        for (unsigned i = 0; i < tileCount; ++i) {
+            writer.put(Resource::tile("mapbox://tile_ambient" + util::toString(i), 1, 0, 0, 0, Tileset::Scheme::XYZ),
+                       response);
+        }
+
+        std::optional<mbgl::OfflineDatabase> reader;
+        if (state.range(0) != 0) {
+            reader.emplace(path, TileServerOptions::DefaultConfiguration(), true /*readOnly*/);
+        }
+
+        std::mutex writerMutex;
+        std::atomic<bool> done{false};
+        std::thread downloads([&] {
+            for (unsigned i = 0; !done; ++i) {
+                {
+                    std::lock_guard<std::mutex> lock(writerMutex);
+                    writer.put(
+                        Resource::tile("mapbox://tile_download" + util::toString(i), 1, 0, 0, 0, Tileset::Scheme::XYZ),
+                        response);
+                }
+                // Leave a gap for the network, which paces real downloads.
+                std::this_thread::sleep_for(100us);
+            }
+        });
+
+        std::mt19937 gen(42);
+        std::uniform_int_distribution<> dis(0, tileCount - 1);
+
+        while (state.KeepRunning()) {
+            const auto resource = Resource::tile(
+                "mapbox://tile_ambient" + util::toString(dis(gen)), 1, 0, 0, 0, Tileset::Scheme::XYZ);
+            if (reader) {
+                auto res = reader->get(resource);
+                assert(res != std::nullopt);
+            } else {
+                std::lock_guard<std::mutex> lock(writerMutex);
+                auto res = writer.get(resource);
+                assert(res != std::nullopt);
+            }
+        }
+
+        done = true;
+        downloads.join();
+    }
+
+    deleteDatabaseFiles();
+}
+
+BENCHMARK(OfflineDatabase_GetTileDuringWrites)->ArgName("reader")->Arg(0)->Arg(1)->UseRealTime();
@@ -18,7 +18,9 @@ class SegmentBase;
 namespace gfx {
 
 class DrawableTweaker;
+struct FillGeometry;
 class IndexVectorBase;
+struct PolylineGeometry;
 class ShaderProgramBase;
 class VertexAttributeArray;
 
@@ -201,6 +203,12 @@ public:
     /// Add a polyline. If the last point equals the first it will be closed, otherwise open
     void addPolyline(const GeometryCoordinates& coordinates, const gfx::PolylineGeneratorOptions&);
 
+    /// Use polylines generated ahead of time, possibly on another thread. The data is shared, not copied.
+    void setPolylineGeometry(gfx::Context&, const PolylineGeometry&);
+
+    /// Use fills generated ahead of time, possibly on another thread. The data is shared, not copied.
+    void setFillGeometry(gfx::Context&, const FillGeometry&);
+
     /// return the curent vertex count
     std::size_t curVertexCount() const;
 
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <mbgl/gfx/index_vector.hpp>
+#include <mbgl/gfx/polyline_generator.hpp>
+#include <mbgl/gfx/vertex_vector.hpp>
+#include <mbgl/programs/fill_program.hpp>
+#include <mbgl/programs/line_program.hpp>
+#include <mbgl/tile/geometry_tile_data.hpp>
+
+#include <memory>
+
+namespace mbgl {
+namespace gfx {
+
+/// Vertices, indexes and segments for thick polylines, generated ahead of the drawables that use them.
+///
+/// Generating geometry needs neither a context nor a drawable builder, so it can be done on a worker
+/// thread, leaving only drawable setup and the upload to the render thread. Drawables share the data
+/// rather than copying it, so it must not be modified once handed to a builder. Tile layers don't use
+/// this yet: their buckets are tessellated on the tile workers, but their vertex attributes and drawables
+/// are still prepared on the render thread, in `RenderLayer::update`.
+struct PolylineGeometry {
+    std::shared_ptr<VertexVector<LineLayoutVertex>> vertices = std::make_shared<VertexVector<LineLayoutVertex>>();
+    std::shared_ptr<IndexVector<Triangles>> indexes = std::make_shared<IndexVector<Triangles>>();
+    SegmentVector<LineAttributes> segments;
+
+    /// Append a polyline
+    void add(const GeometryCoordinates&, const PolylineGeneratorOptions&);
+
+    bool empty() const { return vertices->empty(); }
+};
+
+/// Vertices, indexes and segments for filled polygons, see `PolylineGeometry`
+struct FillGeometry {
+    std::shared_ptr<VertexVector<FillLayoutVertex>> vertices = std::make_shared<VertexVector<FillLayoutVertex>>();
+    std::shared_ptr<IndexVector<Triangles>> indexes = std::make_shared<IndexVector<Triangles>>();
+    SegmentVector<FillAttributes> segments;
+
+    /// Append polygons, without outlines
+    void add(const GeometryCollection&);
+
+    bool empty() const { return vertices->empty(); }
+};
+
+} // namespace gfx
+} // namespace mbgl
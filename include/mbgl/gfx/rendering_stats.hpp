@@ -16,6 +16,14 @@ struct RenderingStats {
     int numDrawCalls = 0;
     /// Total number of draw calls executed during all the frames
     int totalDrawCalls = 0;
+    /// Number of tile drawables skipped during the most recent frame because their tile was not visible
+    int numCulledDrawables = 0;
+    /// Number of program, vertex array, texture, sampler and uniform buffer bindings skipped during the most recent
+    /// frame because they were already in place
+    int numElidedBinds = 0;
+
+    /// Total number of programs compiled and linked from source, not counting those loaded from a program binary
+    int numLinkedPrograms = 0;
 
     /// Total number of textures created
     int numCreatedTextures = 0;
@@ -49,8 +57,14 @@ struct RenderingStats {
     int numVertexBuffers = 0;
     std::size_t vertexUpdateBytes = 0;
 
+    /// Net buffers that vertex and index data is sub-allocated from
+    int numBufferSlabs = 0;
+
     int numUniformBuffers = 0;
+    /// Number of times uniform buffer contents changed
     int numUniformUpdates = 0;
+    /// Number of API calls uploading uniform data to the GPU
+    int numUniformUploads = 0;
     std::size_t uniformUpdateBytes = 0;
 
     int memTextures = 0;
@@ -58,6 +72,8 @@ struct RenderingStats {
     int memIndexBuffers = 0;
     int memVertexBuffers = 0;
     int memUniformBuffers = 0;
+    /// Memory reserved by buffer slabs, whether or not it is in use
+    int memBufferSlabs = 0;
 
     int stencilClears = 0;
     int stencilUpdates = 0;
@@ -154,6 +154,20 @@ public:
         return {};
     }
 
+    /// @brief Start creating the shader for a set of data driven properties as uniforms, so that
+    /// a later `getOrCreateShader` doesn't block on it. Backends which can't compile shaders in
+    /// the background create it right away. Calling this again for a shader that's being created
+    /// only checks on its progress.
+    /// @param propertiesAsUniforms Set of data driven properties as uniforms.
+    /// @param firstAttribName Name of the first attribute
+    /// @return Whether `getOrCreateShader` can return the shader without waiting for it
+    virtual bool prewarmShader(gfx::Context& context,
+                               const mbgl::unordered_set<StringIdentity>& propertiesAsUniforms,
+                               std::string_view firstAttribName = "a_pos") {
+        getOrCreateShader(context, propertiesAsUniforms, firstAttribName);
+        return true;
+    }
+
 protected:
     using PropertyHashType = std::uint64_t;
 
@@ -381,12 +381,46 @@ public:
          ...);
     }
 
+    /// Collect the properties which will be constant without reading any attributes, matching
+    /// `readDataDrivenPaintProperties` for buckets with data for each data-driven property.
+    /// @param evaluated Evaluated properties
+    /// @param propertiesAsUniforms [out] A set of string identities for the properties which will be constant
+    template <typename... DataDrivenPaintProperty, typename Evaluated>
+    static void readPropertiesAsUniforms(const Evaluated& evaluated,
+                                         mbgl::unordered_set<StringIdentity>& propertiesAsUniforms) {
+        propertiesAsUniforms.reserve(sizeof...(DataDrivenPaintProperty));
+        (readPropertyAsUniform<DataDrivenPaintProperty>(isConstant<DataDrivenPaintProperty>(evaluated),
+                                                        propertiesAsUniforms),
+         ...);
+    }
+
 protected:
     template <typename DataDrivenPaintProperty, typename Evaluated>
     static bool isConstant(const Evaluated& evaluated) {
         return evaluated.template get<DataDrivenPaintProperty>().isConstant();
     }
 
+    template <typename DataDrivenPaintProperty>
+    static void readPropertyAsUniform(const bool isConstant,
+                                      mbgl::unordered_set<StringIdentity>& propertiesAsUniforms) {
+        if (isConstant) {
+            for (std::size_t attrIndex = 0; attrIndex < DataDrivenPaintProperty::AttributeNames.size(); ++attrIndex) {
+                propertiesAsUniforms.emplace(getAttributeNameID<DataDrivenPaintProperty>(attrIndex));
+            }
+        }
+    }
+
+    /// Get the "a\_" prefixed name ID of one of a property's attributes
+    template <typename DataDrivenPaintProperty>
+    static StringIdentity getAttributeNameID(std::size_t attrIndex) {
+        auto& attributeNameID = DataDrivenPaintProperty::AttributeNameIDs[attrIndex];
+        if (!attributeNameID) {
+            const auto& attributeName = DataDrivenPaintProperty::AttributeNames[attrIndex];
+            attributeNameID = stringIndexer().get(attributePrefix + attributeName.data());
+        }
+        return *attributeNameID;
+    }
+
     /// Place one property from a type pack into an attribute in this collection, replacing if it already exists.
     template <typename DataDrivenPaintProperty, typename Binder>
     void readDataDrivenPaintProperty(const Binder& binder,
@@ -398,18 +432,14 @@ protected:
 
         // Consider each attribute name in the attribute (e.g., pattern_from, pattern_to)
         for (std::size_t attrIndex = 0; attrIndex < DataDrivenPaintProperty::AttributeNames.size(); ++attrIndex) {
-            auto& attributeNameID = DataDrivenPaintProperty::AttributeNameIDs[attrIndex];
-            if (!attributeNameID) {
-                const auto& attributeName = DataDrivenPaintProperty::AttributeNames[attrIndex];
-                attributeNameID = stringIndexer().get(attributePrefix + attributeName.data());
-            }
+            const auto attributeNameID = getAttributeNameID<DataDrivenPaintProperty>(attrIndex);
 
             // Apply the property, or add it to the uniforms collection if it's constant.
             if (!isConstant && binder->getVertexCount() > 0) {
                 using Attribute = typename DataDrivenPaintProperty::Attribute;
-                applyPaintProperty<Attribute>(attrIndex, getOrAdd(*attributeNameID), binder);
+                applyPaintProperty<Attribute>(attrIndex, getOrAdd(attributeNameID), binder);
             } else {
-                propertiesAsUniforms.emplace(*attributeNameID);
+                propertiesAsUniforms.emplace(attributeNameID);
             }
         }
     }
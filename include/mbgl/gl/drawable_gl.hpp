@@ -26,6 +26,8 @@ using UniqueVertexBufferResource = std::unique_ptr<VertexBufferResource>;
 
 namespace gl {
 
+class CommandList;
+class Context;
 class Texture2D;
 class VertexArray;
 
@@ -36,6 +38,9 @@ public:
 
     void draw(PaintParameters&) const override;
 
+    /// Record the draw without making any GL calls, see `CommandList`
+    void record(const PaintParameters&, CommandList&) const;
+
     struct DrawSegmentGL;
     void setIndexData(gfx::IndexVectorBasePtr, std::vector<UniqueDrawSegment> segments) override;
 
@@ -56,16 +61,13 @@ protected:
     DrawableGL(std::unique_ptr<Impl>);
 
 private:
-    gfx::ColorMode makeColorMode(PaintParameters&) const;
-    gfx::StencilMode makeStencilMode(PaintParameters&) const;
+    gfx::ColorMode makeColorMode(const PaintParameters&) const;
+    gfx::StencilMode makeStencilMode(const PaintParameters&) const;
 
     void uploadTextures() const;
 
-    void bindUniformBuffers() const;
-    void unbindUniformBuffers() const;
-
-    void bindTextures() const;
-    void unbindTextures() const;
+    void recordUniformBuffers(CommandList&) const;
+    void recordTextures(CommandList&) const;
 };
 
 } // namespace gl
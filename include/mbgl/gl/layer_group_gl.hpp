@@ -1,6 +1,11 @@
 #pragma once
 
+#include <mbgl/gfx/stencil_mode.hpp>
 #include <mbgl/renderer/layer_group.hpp>
+#include <mbgl/tile/tile_id.hpp>
+#include <mbgl/util/containers.hpp>
+
+#include <vector>
 
 namespace mbgl {
 namespace gl {
@@ -17,6 +22,21 @@ public:
     void render(RenderOrchestrator&, PaintParameters&) override;
 
 protected:
+    /// Reorder drawables so that consecutive draws share as much GL state as possible
+    void sortByState(std::vector<gfx::Drawable*>&);
+
+    /// Run the tweakers of and draw each drawable in turn
+    void renderInOrder(PaintParameters&, bool features3d, const gfx::StencilMode& stencilMode3d);
+
+    // Per-frame scratch space, kept to avoid allocations
+    struct StateKey {
+        std::size_t tileOrdinal;
+        const void* shader;
+        gfx::Drawable* drawable;
+    };
+    std::vector<gfx::Drawable*> drawOrder;
+    std::vector<StateKey> stateKeys;
+    mbgl::unordered_map<OverscaledTileID, std::size_t> tileOrdinals;
 };
 
 /**
@@ -49,11 +49,11 @@ public:
 
     void updateSamplerConfiguration() noexcept;
 
-    /// @brief Bind this texture to the specified texture unit
-    /// @param location Location index of texture sampler in a shader
+    /// @brief Bind this texture to the specified texture unit, unless it's already bound there
     /// @param textureUnit Unit to bind to. A maximum of gl::MaxActiveTextureUnits
     /// texture units are available for binding.
-    void bind(int32_t location, int32_t textureUnit) noexcept;
+    /// @details Pointing shader samplers at the unit is up to the caller, see `ShaderProgramGL::setSamplerUnit`
+    void bind(int32_t textureUnit) noexcept;
 
     /// @brief Unbind the texture, if it was bound
     void unbind() noexcept;
@@ -76,7 +76,6 @@ private:
     bool storageDirty{false};
 
     int32_t boundTextureUnit{-1};
-    int32_t boundLocation{-1};
 };
 
 } // namespace gl
@@ -3,26 +3,103 @@
 #include <mbgl/gfx/uniform_buffer.hpp>
 #include <mbgl/gl/types.hpp>
 
+#include <array>
+#include <map>
+#include <memory>
+#include <vector>
+
 namespace mbgl {
 namespace gl {
 
+class Context;
+
+/// Sub-allocates uniform buffers from a ring of large GL buffers.
+///
+/// Uniform data is written to a CPU-side copy of the whole arena. Writes are
+/// uploaded lazily, right before the next binding, with one `glBufferSubData`
+/// per group of nearby written ranges, and buffers are bound with
+/// `glBindBufferRange`. At the end of each frame the next buffer of the ring
+/// becomes current, so that writes never touch a buffer the GPU may still be
+/// reading from for a previous frame.
+///
+/// The allocator is owned by the context, uniform buffers only keep a weak
+/// reference to it so that they can outlive the context.
+class UniformBufferAllocator {
+public:
+    static constexpr std::size_t ringSize = 3;
+    /// Written ranges closer than this are uploaded together with the bytes between them
+    static constexpr std::size_t maxRangeGap = 4 * 1024;
+    /// Pending ranges per buffer, the closest ones are merged beyond that
+    static constexpr std::size_t maxPendingRanges = 8;
+
+    UniformBufferAllocator(Context&);
+    UniformBufferAllocator(const UniformBufferAllocator&) = delete;
+    UniformBufferAllocator& operator=(const UniformBufferAllocator&) = delete;
+    ~UniformBufferAllocator();
+
+    /// Reserve a block of at least `size` bytes, returns its offset
+    std::size_t allocate(std::size_t size);
+    void release(std::size_t offset, std::size_t size);
+
+    /// Copy data into a block.
+    /// @return False if the block already contained the same data
+    bool write(std::size_t offset, const void* data, std::size_t size);
+    const uint8_t* read(std::size_t offset) const { return shadow.data() + offset; }
+
+    /// Upload pending writes to the current buffer
+    /// @return The buffer to bind blocks from
+    BufferID flush();
+
+    /// Advance to the next buffer of the ring
+    void endFrame();
+
+    /// Delete the GL buffers, they are re-created on the next flush
+    void releaseBuffers();
+
+    Context& getContext() const { return context; }
+
+private:
+    struct Range {
+        std::size_t begin = 0;
+        std::size_t end = 0;
+    };
+
+    /// Add a written range to the pending uploads of every buffer of the ring
+    void addPending(Range);
+
+    Context& context;
+    const std::size_t alignment;
+
+    std::vector<uint8_t> shadow;
+    std::size_t used = 0;
+    // Released blocks by aligned size, UBO sizes are few and repeat often
+    std::map<std::size_t, std::vector<std::size_t>> freeBlocks;
+
+    std::array<BufferID, ringSize> buffers{};
+    std::array<std::size_t, ringSize> bufferSizes{};
+    // Written ranges not yet uploaded to each buffer, sorted and disjoint
+    std::array<std::vector<Range>, ringSize> pending{};
+    std::size_t current = 0;
+};
+
 class UniformBufferGL final : public gfx::UniformBuffer {
     UniformBufferGL(const UniformBufferGL&);
 
 public:
-    UniformBufferGL(const void* data, std::size_t size_);
-    UniformBufferGL(UniformBufferGL&& other)
-        : UniformBuffer(std::move(other)) {}
+    UniformBufferGL(const void* data, std::size_t size_, const std::shared_ptr<UniformBufferAllocator>&);
+    UniformBufferGL(UniformBufferGL&& other);
     ~UniformBufferGL() override;
 
-    BufferID getID() const { return id; }
+    /// Bind the block to a uniform buffer binding point
+    void bind(int binding) const;
     void update(const void* data, std::size_t size_) override;
 
     UniformBufferGL clone() const { return {*this}; }
 
 protected:
-    BufferID id = 0;
-    uint32_t hash;
+    // Expired once the context is gone, along with the arena holding the block
+    std::weak_ptr<UniformBufferAllocator> allocator;
+    std::size_t offset;
 };
 
 /// Stores a collection of uniform buffers by name
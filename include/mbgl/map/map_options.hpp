@@ -87,6 +87,24 @@ public:
      */
     bool crossSourceCollisions() const;
 
+    /**
+     * @brief Specify whether symbol layers that cannot collide with each
+     * other may be placed concurrently on the background thread pool. The
+     * resulting placement is identical to the sequential one. By default,
+     * it is set to false.
+     *
+     * @param enableParallelPlacement true to enable, false to disable
+     * @return MapOptions for chaining options together.
+     */
+    MapOptions& withParallelPlacement(bool enableParallelPlacement);
+
+    /**
+     * @brief Gets the previously set (or default) parallelPlacement value.
+     *
+     * @return true if parallel symbol placement is enabled, false otherwise.
+     */
+    bool parallelPlacement() const;
+
     /**
      * @brief Sets the orientation of the Map. By default, it is set to
      * Upwards.
@@ -164,6 +164,9 @@ public:
     void setStencilTiles(RenderTiles);
 
 protected:
+    /// Whether a drawable can be skipped because its tile is outside the view, see `PaintParameters::isTileCulled`
+    static bool isCulled(const gfx::Drawable&, const PaintParameters&);
+
     // When stencil clipping is enabled for the layer, this is the set
     // of tile IDs that need to be rendered to the stencil buffer.
     RenderTiles stencilTiles;
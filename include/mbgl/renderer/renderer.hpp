@@ -2,6 +2,7 @@
 
 #include <mbgl/renderer/query.hpp>
 #include <mbgl/annotation/annotation.hpp>
+#include <mbgl/util/chrono.hpp>
 #include <mbgl/util/geo.hpp>
 #include <mbgl/util/geojson.hpp>
 
@@ -53,6 +54,11 @@ public:
 
     void render(const std::shared_ptr<UpdateParameters>&);
 
+    /// Limit the time spent on each frame by leaving work such as building the drawables of newly
+    /// loaded tiles to the following frames.  Only applies to continuous rendering.  Zero, the
+    /// default, does all the work in the frame it's needed in.
+    void setFrameTimeBudget(Duration);
+
     /// Feature queries
     std::vector<Feature> queryRenderedFeatures(const ScreenLineString&, const RenderedQueryOptions& options = {}) const;
     std::vector<Feature> queryRenderedFeatures(const ScreenCoordinate& point,
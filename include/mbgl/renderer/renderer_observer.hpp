@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <exception>
 #include <functional>
@@ -44,6 +45,10 @@ public:
         onDidFinishRenderingFrame(mode, repaint, placementChanged);
     }
 
+    /// The frame took longer than the frame time budget, in seconds. `deferredTiles` counts the tiles
+    /// whose drawables were left for later frames.
+    virtual void onFrameBudgetExceeded(double /*frameTime*/, double /*budget*/, std::size_t /*deferredTiles*/) {}
+
     /// Final frame
     virtual void onDidFinishRenderingMap() {}
 
@@ -20,10 +20,6 @@ public:
     gfx::ShaderPtr getOrCreateShader(gfx::Context& context,
                                      const mbgl::unordered_set<StringIdentity>& propertiesAsUniforms,
                                      std::string_view firstAttribName) override {
-        constexpr auto& name = shaders::ShaderSource<ShaderID, gfx::Backend::Type::OpenGL>::name;
-        constexpr auto& vert = shaders::ShaderSource<ShaderID, gfx::Backend::Type::OpenGL>::vertex;
-        constexpr auto& frag = shaders::ShaderSource<ShaderID, gfx::Backend::Type::OpenGL>::fragment;
-
         // We could cache these by key here to avoid creating a string key each time, but we
         // would need another mutex.  We could also push string IDs down into `ShaderGroup`.
         const std::string shaderName = getShaderName(name, propertyHash(propertiesAsUniforms));
@@ -32,7 +28,57 @@ public:
             return shader;
         }
 
-        // No match, we need to create the shader.
+        // No match, we need to create the shader, or finish the one started by `prewarmShader`.
+        auto& glContext = static_cast<gl::Context&>(context);
+        if (auto it = pendingPrograms.find(shaderName); it != pendingPrograms.end()) {
+            auto build = std::move(it->second);
+            pendingPrograms.erase(it);
+            shader = ShaderProgramGL::finish(glContext, std::move(build));
+        } else {
+            shader = ShaderProgramGL::create(glContext,
+                                             programParameters,
+                                             shaderName,
+                                             firstAttribName,
+                                             vert,
+                                             frag,
+                                             getAdditionalDefines(propertiesAsUniforms));
+        }
+        if (!shader || !registerShader(shader, shaderName)) {
+            throw std::runtime_error("Failed to register " + shaderName + " with shader group!");
+        }
+        return shader;
+    }
+
+    bool prewarmShader(gfx::Context& context,
+                       const mbgl::unordered_set<StringIdentity>& propertiesAsUniforms,
+                       std::string_view firstAttribName) override {
+        const std::string shaderName = getShaderName(name, propertyHash(propertiesAsUniforms));
+        if (isShader(shaderName)) {
+            return true;
+        }
+
+        auto& glContext = static_cast<gl::Context&>(context);
+        auto it = pendingPrograms.find(shaderName);
+        if (it == pendingPrograms.end()) {
+            it = pendingPrograms
+                     .emplace(shaderName,
+                              ShaderProgramGL::start(glContext,
+                                                     programParameters,
+                                                     firstAttribName,
+                                                     vert,
+                                                     frag,
+                                                     getAdditionalDefines(propertiesAsUniforms)))
+                     .first;
+        }
+        return glContext.isProgramReady(it->second);
+    }
+
+private:
+    static constexpr auto& name = shaders::ShaderSource<ShaderID, gfx::Backend::Type::OpenGL>::name;
+    static constexpr auto& vert = shaders::ShaderSource<ShaderID, gfx::Backend::Type::OpenGL>::vertex;
+    static constexpr auto& frag = shaders::ShaderSource<ShaderID, gfx::Backend::Type::OpenGL>::fragment;
+
+    static std::string getAdditionalDefines(const mbgl::unordered_set<StringIdentity>& propertiesAsUniforms) {
         std::string additionalDefines;
         additionalDefines.reserve(propertiesAsUniforms.size() * 48);
         for (const auto nameID : propertiesAsUniforms) {
@@ -47,18 +93,14 @@ public:
             additionalDefines += prefix;
             additionalDefines += "\n";
         }
-
-        auto& glContext = static_cast<gl::Context&>(context);
-        shader = ShaderProgramGL::create(
-            glContext, programParameters, shaderName, firstAttribName, vert, frag, additionalDefines);
-        if (!shader || !registerShader(shader, shaderName)) {
-            throw std::runtime_error("Failed to register " + shaderName + " with shader group!");
-        }
-        return shader;
+        return additionalDefines;
     }
 
-private:
     ProgramParameters programParameters;
+
+    // Programs started by `prewarmShader`, which the driver may still be compiling.
+    // Like all GL calls, these are only used on the render thread.
+    mbgl::unordered_map<std::string, Context::ProgramBuild> pendingPrograms;
 };
 
 } // namespace gl
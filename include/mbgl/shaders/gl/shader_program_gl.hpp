@@ -37,6 +37,17 @@ public:
                                                    const std::string& fragmentSource,
                                                    const std::string& additionalDefines = "") noexcept(false);
 
+    /// Start compiling and linking a program, without waiting for the driver
+    static Context::ProgramBuild start(Context&,
+                                       const ProgramParameters& programParameters,
+                                       const std::string_view firstAttribName,
+                                       const std::string& vertexSource,
+                                       const std::string& fragmentSource,
+                                       const std::string& additionalDefines = "");
+
+    /// Create the shader from a program started with `start`, waiting for it to be linked if needed
+    static std::shared_ptr<ShaderProgramGL> finish(Context&, Context::ProgramBuild&&) noexcept(false);
+
     std::optional<uint32_t> getSamplerLocation(const StringIdentity id) const override;
 
     const gfx::UniformBlockArray& getUniformBlocks() const override { return uniformBlocks; }
@@ -45,6 +56,10 @@ public:
 
     ProgramID getGLProgramID() const { return glProgram; }
 
+    /// Point a sampler uniform at a texture unit, unless it already is.  The program must be in use.
+    /// @return true if the uniform was changed
+    bool setSamplerUnit(int32_t location, int32_t textureUnit);
+
 protected:
     gfx::UniformBlockArray& mutableUniformBlocks() override { return uniformBlocks; }
 
@@ -54,6 +69,9 @@ protected:
     UniformBlockArrayGL uniformBlocks;
     VertexAttributeArrayGL vertexAttributes;
     SamplerLocationMap samplerLocations;
+
+    // Texture unit assigned to each sampler location, uniform values are per-program state
+    std::unordered_map<int32_t, int32_t> samplerUnits;
 };
 
 } // namespace gl
@@ -117,4 +117,17 @@ constexpr const char* MAX_CONCURRENT_REQUESTS_KEY = "max-concurrent-requests";
 /// database opens in read-write-create mode otherwise. type: bool
 constexpr const char* READ_ONLY_MODE_KEY = "read-only-mode";
 
+/// Property to set the codec of the data written to the database: "deflate"
+/// (default) or "none". Data written before keeps its codec. type: std::string
+constexpr const char* COMPRESSION_KEY = "compression";
+
+/// Property to set the journal mode of the database: "delete" (default) or
+/// "wal". In WAL mode, cache reads and writes don't wait for each other, but
+/// the database can't be opened in a read-only directory. type: std::string
+constexpr const char* JOURNAL_MODE_KEY = "journal-mode";
+
+/// Property to set the number of pages the write-ahead log holds before it's
+/// checkpointed into the database, in WAL mode. Defaults to 1000. type: uint64_t
+constexpr const char* WAL_CHECKPOINT_PAGES_KEY = "wal-checkpoint-pages";
+
 } // namespace mbgl
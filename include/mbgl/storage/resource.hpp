@@ -23,9 +23,13 @@ public:
         Image
     };
 
-    enum class Priority : bool {
-        Regular,
-        Low
+    // Lower values are loaded first; requests of equal priority load in the
+    // order they were made. Any value between `High` and `Low` is valid, see
+    // `priorityAt()`.
+    enum class Priority : uint8_t {
+        High = 0,
+        Regular = 128,
+        Low = 255
     };
 
     enum class Usage : bool {
@@ -66,6 +70,7 @@ public:
           tileData(std::move(tileData_)) {}
 
     void setPriority(Priority p) { priority = p; }
+    static constexpr Priority priorityAt(uint8_t value) { return static_cast<Priority>(value); }
     void setUsage(Usage u) { usage = u; }
 
     bool hasLoadingMethod(LoadingMethod method) const;
@@ -92,8 +92,23 @@ public:
      */
     void addPolyline(const GeometryCoordinates& coordinates);
 
+    /**
+     * @brief Add polylines generated ahead of time, e.g., on a worker thread.
+     * The line options used to generate them take the place of the current ones.
+     *
+     * @param geometry Polyline geometry, shared with the drawable
+     */
+    void addPolylines(const gfx::PolylineGeometry& geometry);
+
     void addFill(const GeometryCollection& geometry);
 
+    /**
+     * @brief Add fills generated ahead of time, e.g., on a worker thread
+     *
+     * @param geometry Fill geometry, shared with the drawable
+     */
+    void addFill(const gfx::FillGeometry& geometry);
+
     /**
      * @brief Finish the current drawable building session
      *
@@ -72,6 +72,14 @@ public:
     bool isVolatile() const noexcept;
     void setVolatile(bool) noexcept;
 
+    // Cached tiles that have expired and must be revalidated are shown while
+    // they are being revalidated, instead of only once the server has
+    // confirmed them. Changed tiles replace them when they arrive.
+    //
+    // Default value is `false`.
+    bool isStaleWhileRevalidate() const noexcept;
+    void setStaleWhileRevalidate(bool) noexcept;
+
     // Private implementation
     /// @cond FALSE
 
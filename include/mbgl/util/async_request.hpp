@@ -1,5 +1,6 @@
 #pragma once
 
+#include <mbgl/storage/resource.hpp>
 #include <mbgl/util/noncopyable.hpp>
 
 namespace mbgl {
@@ -7,6 +8,10 @@ namespace mbgl {
 class AsyncRequest : private util::noncopyable {
 public:
     virtual ~AsyncRequest() = default;
+
+    // Changes the priority of a request that is waiting or in flight. Requests
+    // that can't be reordered ignore it.
+    virtual void setPriority(Resource::Priority) {}
 };
 
 } // namespace mbgl
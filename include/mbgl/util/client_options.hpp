@@ -1,5 +1,8 @@
 #pragma once
 
+#include <mbgl/util/chrono.hpp>
+
+#include <cstdint>
 #include <memory>
 #include <string>
 
@@ -52,6 +55,86 @@ public:
      */
     const std::string& version() const;
 
+    /**
+     * @brief Sets whether to request HTTP/2 for HTTPS connections and multiplex
+     * concurrent requests to a host over a single connection. Defaults to true.
+     *
+     * @param enabled Whether to use HTTP/2.
+     * @return ClientOptions for chaining options together.
+     */
+    ClientOptions& withHTTP2(bool enabled);
+
+    /**
+     * @brief Gets whether HTTP/2 is used, see `withHTTP2`.
+     *
+     * @return true if HTTP/2 is used
+     */
+    bool http2() const;
+
+    /**
+     * @brief Sets the maximum number of simultaneous connections to a single host.
+     * Requests beyond the limit wait for a connection to become available, or are
+     * multiplexed over an existing HTTP/2 connection. Defaults to 0, no limit.
+     *
+     * @param count Maximum number of connections per host, 0 for no limit.
+     * @return ClientOptions for chaining options together.
+     */
+    ClientOptions& withMaximumConnectionsPerHost(uint32_t count);
+
+    /**
+     * @brief Gets the maximum number of simultaneous connections to a single host.
+     *
+     * @return maximum number of connections per host, 0 for no limit
+     */
+    uint32_t maximumConnectionsPerHost() const;
+
+    /**
+     * @brief Sets the number of idle connections kept open for reuse by later requests.
+     * Defaults to 0, which leaves the size of the pool to the HTTP library.
+     *
+     * @param count Size of the connection pool.
+     * @return ClientOptions for chaining options together.
+     */
+    ClientOptions& withConnectionPoolSize(uint32_t count);
+
+    /**
+     * @brief Gets the number of idle connections kept open for reuse.
+     *
+     * @return size of the connection pool, 0 for the HTTP library's default
+     */
+    uint32_t connectionPoolSize() const;
+
+    /**
+     * @brief Sets how long a connection may be idle before TCP keep-alive probes are sent,
+     * which keeps pooled connections from being dropped by the network. Defaults to 60 seconds.
+     *
+     * @param idle Idle time before the first probe, 0 to disable keep-alive probes.
+     * @return ClientOptions for chaining options together.
+     */
+    ClientOptions& withTCPKeepAlive(Seconds idle);
+
+    /**
+     * @brief Gets the idle time before TCP keep-alive probes are sent.
+     *
+     * @return idle time, 0 if keep-alive probes are disabled
+     */
+    Seconds tcpKeepAlive() const;
+
+    /**
+     * @brief Sets how long resolved host names are cached. Defaults to 60 seconds.
+     *
+     * @param timeout Time to keep resolved host names for.
+     * @return ClientOptions for chaining options together.
+     */
+    ClientOptions& withDNSCacheTimeout(Seconds timeout);
+
+    /**
+     * @brief Gets how long resolved host names are cached.
+     *
+     * @return time to keep resolved host names for
+     */
+    Seconds dnsCacheTimeout() const;
+
 private:
     ClientOptions(const ClientOptions&);
 
@@ -17,6 +17,8 @@ public:
     ~FileSourceRequest() final;
 
     void onCancel(std::function<void()>&& callback);
+    void onPriorityChange(std::function<void(Resource::Priority)>&& callback);
+    void setPriority(Resource::Priority) final;
     void setResponse(const Response& res);
 
     ActorRef<FileSourceRequest> actor();
@@ -24,6 +26,7 @@ public:
 private:
     FileSource::Callback responseCallback = nullptr;
     std::function<void()> cancelCallback = nullptr;
+    std::function<void(Resource::Priority)> priorityCallback = nullptr;
 
     std::shared_ptr<Mailbox> mailbox;
 };
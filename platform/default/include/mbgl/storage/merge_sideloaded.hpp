@@ -18,19 +18,6 @@ static constexpr const char* mergeSideloadedDatabaseSQL =
     "    FROM side.regions sr\n"
     "    JOIN regions r ON sr.definition = r.definition  AND sr.description IS "
     "r.description;\n"
-    "REPLACE INTO tiles\n"
-    "    SELECT t.id,\n"
-    "        st.url_template, st.pixel_ratio, st.z, st.x, st.y,\n"
-    "        st.expires, st.modified, st.etag, st.data, st.compressed, "
-    "st.accessed, st.must_revalidate\n"
-    "    FROM (SELECT DISTINCT sti.* FROM side.region_tiles srt JOIN "
-    "side.tiles sti ON srt.tile_id = sti.id)\n"
-    "    AS st\n"
-    "    LEFT JOIN tiles t ON st.url_template = t.url_template AND "
-    "st.pixel_ratio = t.pixel_ratio AND st.z = t.z AND "
-    "st.x = t.x AND st.y = t.y\n"
-    "        WHERE t.id IS NULL\n"
-    "        OR st.modified > t.modified;\n"
     "INSERT OR IGNORE INTO region_tiles\n"
     "    SELECT rm.main_region_id, sti.id\n"
     "    FROM side.region_tiles srt\n"
@@ -10,16 +10,8 @@ CREATE TEMPORARY TABLE region_mapping AS
     FROM side.regions sr
     JOIN regions r ON sr.definition = r.definition  AND sr.description IS r.description;
 
---Insert /Update tiles
-REPLACE INTO tiles
-    SELECT t.id, -- use the old ID in case we run a REPLACE. If it doesn't exist yet, it'll be NULL which will auto-assign a new ID.
-        st.url_template, st.pixel_ratio, st.z, st.x, st.y,
-        st.expires, st.modified, st.etag, st.data, st.compressed, st.accessed, st.must_revalidate
-    FROM (SELECT DISTINCT sti.* FROM side.region_tiles srt JOIN side.tiles sti ON srt.tile_id = sti.id)   -- ensure that we're only considering region tiles, and not ambient tiles.
-    AS st
-    LEFT JOIN tiles t ON st.url_template = t.url_template AND st.pixel_ratio = t.pixel_ratio AND st.z = t.z AND st.x = t.x AND st.y = t.y
-        WHERE t.id IS NULL -- only consider tiles that don't exist yet in the original database.
-        OR st.modified > t.modified; -- ...or tiles that are newer in the side loaded DB.
+-- Tiles are inserted/updated by OfflineDatabase::mergeTiles() before this
+-- script runs, because their contents need to be deduplicated.
 
 -- Update region_tiles usage
 INSERT OR IGNORE INTO region_tiles
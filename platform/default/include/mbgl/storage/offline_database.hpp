@@ -7,12 +7,16 @@
 #include <mbgl/util/constants.hpp>
 #include <mbgl/util/mapbox.hpp>
 #include <mbgl/util/expected.hpp>
+#include <mbgl/util/range.hpp>
+#include <mbgl/util/tileset.hpp>
 
+#include <functional>
 #include <list>
 #include <map>
 #include <memory>
 #include <string>
 #include <optional>
+#include <vector>
 
 namespace mapbox {
 namespace sqlite {
@@ -37,9 +41,51 @@ struct MapboxTileLimitExceededException : util::Exception {
         : util::Exception("Mapbox tile limit exceeded") {}
 };
 
+// Progress through the tile cover of one tile URL template of a region: the
+// first `position` tiles were all handled, and `tileCount` of them, taking
+// `tileSize` bytes, are stored. The position only holds for the cover of the
+// same zoom range, and for tiles of the same scheme.
+struct OfflineTileCheckpoint {
+    Range<uint8_t> zoomRange{0, 0};
+    Tileset::Scheme scheme = Tileset::Scheme::XYZ;
+    uint64_t position = 0;
+    uint64_t tileCount = 0;
+    uint64_t tileSize = 0;
+};
+
+using OfflineTileCheckpoints = std::map<std::string, OfflineTileCheckpoint>;
+
+// Codec of the data of a stored resource or tile. It's recorded with every row,
+// so rows written with any codec stay readable when the setting changes. Rows
+// tagged with a codec missing here, e.g. by a newer version, fail to read.
+// There's no zstd codec yet: it would need the library, and a table for the
+// trained dictionaries that rows compressed with one refer to.
+enum class OfflineCompression : uint8_t {
+    // Stored as is.
+    None = 0,
+    // zlib, kept only when it makes the data smaller. Data that is already in a
+    // compressed format (PNG, JPEG, WebP, gzip) is stored as is.
+    Deflate = 1,
+};
+
+// Journal mode of the database file. See https://www.sqlite.org/wal.html
+enum class OfflineJournalMode : uint8_t {
+    // Rollback journal with FULL sync. Readers wait while the writer commits,
+    // and the writer waits for readers to finish. Works in read-only directories.
+    Delete,
+    // Write-ahead log with NORMAL sync. Readers and the writer don't wait for
+    // each other, but the last commits can be lost on power failure. Readers
+    // need the directory to be writable, to open the -shm file.
+    WAL,
+};
+
 class OfflineDatabase {
 public:
-    OfflineDatabase(std::string path, const TileServerOptions& options);
+    static constexpr uint32_t defaultWALCheckpointPages = 1000;
+
+    // A read-only database doesn't create or migrate the file, and doesn't update
+    // the timestamps of what it reads; see updateAccessed().
+    OfflineDatabase(std::string path, const TileServerOptions& options, bool readOnly = false);
     ~OfflineDatabase();
 
     void changePath(const std::string&);
@@ -50,6 +96,10 @@ public:
     // Return value is (inserted, stored size)
     std::pair<bool, uint64_t> put(const Resource&, const Response&);
 
+    // Updates the timestamp used for LRU eviction, for a read served by a
+    // read-only connection to the same database.
+    void updateAccessed(const Resource&);
+
     // Force Mapbox GL Native to revalidate tiles stored in the ambient
     // cache with the tile server before using them, making sure they
     // are the latest version. This is more efficient than cleaning the
@@ -78,7 +128,14 @@ public:
     std::optional<std::pair<Response, uint64_t>> getRegionResource(const Resource&);
     std::optional<int64_t> hasRegionResource(const Resource&);
     uint64_t putRegionResource(int64_t regionID, const Resource&, const Response&);
-    void putRegionResources(int64_t regionID, const std::list<std::tuple<Resource, Response>>&, OfflineRegionStatus&);
+    // Return value is the stored size of each resource, or empty if the resources couldn't be written
+    std::vector<uint64_t> putRegionResources(int64_t regionID,
+                                             const std::list<std::tuple<Resource, Response>>&,
+                                             OfflineRegionStatus&);
+
+    // Keyed by tile URL template
+    OfflineTileCheckpoints getRegionCheckpoints(int64_t regionID);
+    void putRegionCheckpoints(int64_t regionID, const OfflineTileCheckpoints&);
 
     expected<OfflineRegionDefinition, std::exception_ptr> getRegionDefinition(int64_t regionID);
     expected<OfflineRegionStatus, std::exception_ptr> getRegionCompletedStatus(int64_t regionID);
@@ -93,12 +150,31 @@ public:
     std::exception_ptr pack();
     void runPackDatabaseAutomatically(bool autopack_) { autopack = autopack_; }
 
+    // Codec for the data written from now on. Defaults to Deflate.
+    void setCompression(OfflineCompression compression_) { compression = compression_; }
+
+    // Journal mode of the database file, set by this connection each time it
+    // opens the file. Defaults to Delete. Leaving WAL mode fails while another
+    // connection has the file open. Read-only connections use the file's mode.
+    void setJournalMode(OfflineJournalMode);
+
+    // In WAL mode, the log is checkpointed into the database once it holds this
+    // many pages, and truncated back to that size afterwards. pack() empties it.
+    void setWALCheckpointPages(uint32_t);
+
     void reopenDatabaseReadOnly(bool readOnly);
 
+    // Called each time the database file has been opened again, after changePath(),
+    // resetDatabase() or replacing a corrupt database, so that read-only connections
+    // to the same path can follow.
+    void setReopenedCallback(std::function<void()> callback) { reopenedCallback = std::move(callback); }
+
 private:
     class DatabaseSizeChangeStats;
 
     void initialize();
+    void openDatabase();
+    void applyJournalMode();
     void handleError(const mapbox::sqlite::Exception&, const char* action);
     void handleError(const util::IOException&, const char* action);
     void handleError(const std::runtime_error& ex, const char* action);
@@ -110,6 +186,9 @@ private:
     void migrateToVersion5();
     void migrateToVersion3();
     void migrateToVersion6();
+    void migrateToVersion7();
+    void migrateToVersion8();
+    void createTileDataTriggers();
     void cleanup();
     bool disabled();
     void vacuum();
@@ -117,13 +196,20 @@ private:
 
     mapbox::sqlite::Statement& getStatement(const char*);
 
+    void updateResourceAccessed(const Resource&);
+    void updateTileAccessed(const Resource::TileData&);
+
     std::optional<std::pair<Response, uint64_t>> getTile(const Resource::TileData&);
     std::optional<int64_t> hasTile(const Resource::TileData&);
-    bool putTile(const Resource::TileData&, const Response&, const std::string&, bool compressed);
+    bool putTile(const Resource::TileData&, const Response&, const std::string&, OfflineCompression);
+
+    // Returns the id of the tile_data row holding the given contents, adding one if there is none yet.
+    int64_t putTileData(const std::string&, OfflineCompression);
+    void mergeTiles(int64_t sideUserVersion);
 
     std::optional<std::pair<Response, uint64_t>> getResource(const Resource&);
     std::optional<int64_t> hasResource(const Resource&);
-    bool putResource(const Resource&, const Response&, const std::string&, bool compressed);
+    bool putResource(const Resource&, const Response&, const std::string&, OfflineCompression);
 
     uint64_t putRegionResourceInternal(int64_t regionID, const Resource&, const Response&);
 
@@ -184,6 +270,10 @@ private:
 
     bool autopack = true;
     bool readOnly = false;
+    OfflineCompression compression = OfflineCompression::Deflate;
+    OfflineJournalMode journalMode = OfflineJournalMode::Delete;
+    uint32_t walCheckpointPages = defaultWALCheckpointPages;
+    std::function<void()> reopenedCallback;
 };
 
 } // namespace mbgl
@@ -3,15 +3,17 @@
 #include <mbgl/storage/file_source.hpp>
 #include <mbgl/storage/offline.hpp>
 #include <mbgl/storage/resource.hpp>
+#include <mbgl/storage/offline_database.hpp>
+#include <mbgl/util/chrono.hpp>
 
 #include <list>
 #include <unordered_set>
 #include <memory>
 #include <deque>
+#include <optional>
 
 namespace mbgl {
 
-class OfflineDatabase;
 class FileSource;
 class AsyncRequest;
 class Response;
@@ -37,6 +39,14 @@ public:
     OfflineRegionStatus getStatus() const;
 
 private:
+    struct TileCursor;
+
+    // A tile of one of the `tileCursors`, identified by its position in the cursor's tile cover.
+    struct TileSlot {
+        TileCursor* cursor;
+        uint64_t index;
+    };
+
     void activateDownload();
     void continueDownload();
     void deactivateDownload();
@@ -47,7 +57,20 @@ private:
      * While the request is in progress, it is recorded in `requests`. If the download
      * is deactivated, all in progress requests are cancelled.
      */
-    void ensureResource(Resource&&, std::function<void(Response)> = {});
+    void ensureResource(Resource&&, std::function<void(Response)> = {}, TileSlot = {});
+
+    /*
+     * Record that a tile is stored (with its stored size) or missing, moving its
+     * cursor's checkpoint along once all the tiles before it are stored too. A
+     * missing tile stops the checkpoint.
+     */
+    void finishTile(const TileSlot&, std::optional<uint64_t> storedSize);
+    void saveCheckpoints();
+
+    bool hasRemainingResources();
+    uint32_t maximumConcurrentRequests();
+    void onRequestCompleted(Duration latency);
+    void onRequestFailed();
 
     void onMapboxTileCountLimitExceeded();
 
@@ -59,10 +82,22 @@ private:
     std::unique_ptr<OfflineRegionObserver> observer;
 
     std::list<std::unique_ptr<AsyncRequest>> requests;
+    // Requests that failed and are waiting to be retried
+    size_t retryingRequests = 0;
     std::set<std::string> requiredSourceURLs;
     std::deque<Resource> resourcesRemaining;
+    std::list<std::unique_ptr<TileCursor>> tileCursors;
+    OfflineTileCheckpoints checkpoints;
     std::list<Resource> resourcesToBeMarkedAsUsed;
     std::list<std::tuple<Resource, Response>> buffer;
+    std::list<TileSlot> bufferSlots;
+
+    // Congestion window limiting the number of concurrent requests, adapted to
+    // the request latencies and errors.
+    double requestWindow;
+    double requestWindowThreshold;
+    Duration minimumLatency = Duration::zero();
+    TimePoint lastWindowDecrease;
 
     void queueResource(Resource&&);
     void queueTiles(style::SourceType, uint16_t tileSize, const Tileset&);
@@ -19,6 +19,13 @@ static constexpr const char* offlineDatabaseSchema =
     "  must_revalidate INTEGER NOT NULL DEFAULT 0,\n"
     "  UNIQUE (url)\n"
     ");\n"
+    "CREATE TABLE tile_data (\n"
+    "  id INTEGER NOT NULL PRIMARY KEY AUTOINCREMENT,\n"
+    "  hash INTEGER NOT NULL,\n"
+    "  data BLOB NOT NULL,\n"
+    "  compressed INTEGER NOT NULL DEFAULT 0,\n"
+    "  ref_count INTEGER NOT NULL DEFAULT 0\n"
+    ");\n"
     "CREATE TABLE tiles (\n"
     "  id INTEGER NOT NULL PRIMARY KEY AUTOINCREMENT,\n"
     "  url_template TEXT NOT NULL,\n"
@@ -29,8 +36,7 @@ static constexpr const char* offlineDatabaseSchema =
     "  expires INTEGER,\n"
     "  modified INTEGER,\n"
     "  etag TEXT,\n"
-    "  data BLOB,\n"
-    "  compressed INTEGER NOT NULL DEFAULT 0,\n"
+    "  data_id INTEGER REFERENCES tile_data(id),\n"
     "  accessed INTEGER NOT NULL,\n"
     "  must_revalidate INTEGER NOT NULL DEFAULT 0,\n"
     "  UNIQUE (url_template, pixel_ratio, z, x, y)\n"
@@ -50,6 +56,17 @@ static constexpr const char* offlineDatabaseSchema =
     "  tile_id INTEGER NOT NULL REFERENCES tiles(id),\n"
     "  UNIQUE (region_id, tile_id)\n"
     ");\n"
+    "CREATE TABLE region_checkpoints (\n"
+    "  region_id INTEGER NOT NULL REFERENCES regions(id) ON DELETE CASCADE,\n"
+    "  url_template TEXT NOT NULL,\n"
+    "  min_zoom INTEGER NOT NULL,\n"
+    "  max_zoom INTEGER NOT NULL,\n"
+    "  scheme INTEGER NOT NULL,\n"
+    "  position INTEGER NOT NULL,\n"
+    "  tile_count INTEGER NOT NULL,\n"
+    "  tile_size INTEGER NOT NULL,\n"
+    "  UNIQUE (region_id, url_template)\n"
+    ");\n"
     "CREATE INDEX resources_accessed\n"
     "ON resources (accessed);\n"
     "CREATE INDEX tiles_accessed\n"
@@ -57,6 +74,10 @@ static constexpr const char* offlineDatabaseSchema =
     "CREATE INDEX region_resources_resource_id\n"
     "ON region_resources (resource_id);\n"
     "CREATE INDEX region_tiles_tile_id\n"
-    "ON region_tiles (tile_id);\n";
+    "ON region_tiles (tile_id);\n"
+    "CREATE INDEX tiles_data_id\n"
+    "ON tiles (data_id);\n"
+    "CREATE INDEX tile_data_hash\n"
+    "ON tile_data (hash);\n";
 
 } // namespace mbgl
@@ -29,10 +29,13 @@ CREATE TABLE resources (
 
   data BLOB,                                       -- Contents of the resource.
 
-  compressed INTEGER NOT NULL DEFAULT 0,           -- If the resource is compressed with Deflate or not. Compression is
-                                                   -- optional and should be used when the compression ratio is
-                                                   -- significant. Using compression will make decoding time slower
-                                                   -- because it will add an extra decompression step.
+  compressed INTEGER NOT NULL DEFAULT 0,           -- Codec the resource is stored with, taken from the
+                                                   -- OfflineCompression enumeration:
+                                                   -- none         = 0
+                                                   -- deflate      = 1
+                                                   -- Compression is optional and should be used when the compression
+                                                   -- ratio is significant. Using compression will make decoding time
+                                                   -- slower because it will add an extra decompression step.
 
   accessed INTEGER NOT NULL,                       -- Last time the resource was used by GL Native. Useful for when
                                                    -- evicting the least used resources from the cache.
@@ -42,6 +45,26 @@ CREATE TABLE resources (
   UNIQUE (url)
 );
 
+--
+-- Table containing the contents of the tiles, stored once per distinct
+-- content. Many tiles are byte-for-byte identical (e.g. empty ocean or
+-- land tiles), so the tiles table references these rows instead of
+-- storing its own copy.
+--
+CREATE TABLE tile_data (
+  id INTEGER NOT NULL PRIMARY KEY AUTOINCREMENT,   -- Primary key.
+
+  hash INTEGER NOT NULL,                           -- CRC32 of data, used to look up existing copies. Not unique;
+                                                   -- the data itself is compared as well.
+
+  data BLOB NOT NULL,                              -- Contents of the tile.
+
+  compressed INTEGER NOT NULL DEFAULT 0,           -- Codec the data is stored with, same as resources.compressed.
+
+  ref_count INTEGER NOT NULL DEFAULT 0             -- Number of tiles referencing this row. Maintained by triggers on
+                                                   -- the tiles table, which delete the row once it drops to zero.
+);
+
 --
 -- Table containing all tiles, both vector and raster.
 --
@@ -72,12 +95,8 @@ CREATE TABLE tiles (
                                                    -- get re-downloaded. See:
                                                    -- https://developer.mozilla.org/en-US/docs/Web/HTTP/Headers/ETag
 
-  data BLOB,                                       -- Contents of the tile.
-
-  compressed INTEGER NOT NULL DEFAULT 0,           -- If the tile is compressed with Deflate or not. Compression is
-                                                   -- optional and should be used when the compression ratio is
-                                                   -- significant. Using compression will make decoding time slower
-                                                   -- because it will add an extra decompression step.
+  data_id INTEGER REFERENCES tile_data(id),        -- Contents of the tile, NULL if the tile doesn't exist on the
+                                                   -- server.
 
   accessed INTEGER NOT NULL,                       -- Last time the tile was used by GL Native. Useful for when
                                                    -- evicting the least used tiles from the cache.
@@ -148,6 +167,25 @@ CREATE TABLE region_tiles (
   UNIQUE (region_id, tile_id)
 );
 
+--
+-- Progress of the tile downloads of a region, one row per tile URL
+-- template. The first `position` tiles of the template's tile cover
+-- from `min_zoom` to `max_zoom`, in the given tile `scheme`, were all
+-- handled; `tile_count` of them are stored, taking `tile_size` bytes,
+-- and the rest don't exist on the server.
+--
+CREATE TABLE region_checkpoints (
+  region_id INTEGER NOT NULL REFERENCES regions(id) ON DELETE CASCADE,
+  url_template TEXT NOT NULL,
+  min_zoom INTEGER NOT NULL,
+  max_zoom INTEGER NOT NULL,
+  scheme INTEGER NOT NULL,
+  position INTEGER NOT NULL,
+  tile_count INTEGER NOT NULL,
+  tile_size INTEGER NOT NULL,
+  UNIQUE (region_id, url_template)
+);
+
 --
 -- Indexes for efficient eviction queries.
 --
@@ -163,3 +201,9 @@ ON region_resources (resource_id);
 
 CREATE INDEX region_tiles_tile_id
 ON region_tiles (tile_id);
+
+CREATE INDEX tiles_data_id
+ON tiles (data_id);
+
+CREATE INDEX tile_data_hash
+ON tile_data (hash);
@@ -12,34 +12,62 @@
 #include <mbgl/util/platform.hpp>
 #include <mbgl/util/thread.hpp>
 
+#include <atomic>
+#include <limits>
 #include <map>
 #include <utility>
+#include <vector>
 
 namespace mbgl {
+
+namespace {
+
+std::optional<Response> getFromDatabase(OfflineDatabase& db, const Resource& resource) {
+    return (resource.storagePolicy != Resource::StoragePolicy::Volatile) ? db.get(resource) : std::nullopt;
+}
+
+void respond(std::optional<Response> offlineResponse, const ActorRef<FileSourceRequest>& req) {
+    if (!offlineResponse) {
+        offlineResponse.emplace();
+        offlineResponse->noContent = true;
+        offlineResponse->error = std::make_unique<Response::Error>(Response::Error::Reason::NotFound,
+                                                                   "Not found in offline database");
+    } else if (!offlineResponse->isUsable()) {
+        offlineResponse->error = std::make_unique<Response::Error>(Response::Error::Reason::NotFound,
+                                                                   "Cached resource is unusable");
+    }
+    req.invoke(&FileSourceRequest::setResponse, *offlineResponse);
+}
+
+} // namespace
+
+class DatabaseFileSourceReader;
+
 class DatabaseFileSourceThread {
 public:
     DatabaseFileSourceThread(std::shared_ptr<FileSource> onlineFileSource_, const std::string& cachePath)
         : db(std::make_unique<OfflineDatabase>(cachePath, onlineFileSource_->getResourceOptions().tileServerOptions())),
-          onlineFileSource(std::move(onlineFileSource_)) {}
+          onlineFileSource(std::move(onlineFileSource_)),
+          path(cachePath) {}
 
     void request(const Resource& resource, const ActorRef<FileSourceRequest>& req) {
-        std::optional<Response> offlineResponse = (resource.storagePolicy != Resource::StoragePolicy::Volatile)
-                                                      ? db->get(resource)
-                                                      : std::nullopt;
-        if (!offlineResponse) {
-            offlineResponse.emplace();
-            offlineResponse->noContent = true;
-            offlineResponse->error = std::make_unique<Response::Error>(Response::Error::Reason::NotFound,
-                                                                       "Not found in offline database");
-        } else if (!offlineResponse->isUsable()) {
-            offlineResponse->error = std::make_unique<Response::Error>(Response::Error::Reason::NotFound,
-                                                                       "Cached resource is unusable");
-        }
-        req.invoke(&FileSourceRequest::setResponse, *offlineResponse);
+        respond(getFromDatabase(*db, resource), req);
+    }
+
+    // Opens the readers, once the database has been created or migrated, and
+    // again whenever this connection opens a new database file.
+    void setReaders(std::vector<ActorRef<DatabaseFileSourceReader>> readers_) {
+        readers = std::move(readers_);
+        db->setReopenedCallback([this] { openReaders(); });
+        openReaders();
     }
 
-    void setDatabasePath(const std::string& path, const std::function<void()>& callback) {
-        db->changePath(path);
+    // Called by the readers for the cache hits they served.
+    void updateAccessed(const Resource& resource) { db->updateAccessed(resource); }
+
+    void setDatabasePath(const std::string& path_, const std::function<void()>& callback) {
+        path = path_;
+        db->changePath(path_);
         if (callback) {
             callback();
         }
@@ -127,6 +155,18 @@ public:
 
     void reopenDatabaseReadOnly(bool readOnly) { db->reopenDatabaseReadOnly(readOnly); }
 
+    void setCompression(OfflineCompression compression) { db->setCompression(compression); }
+
+    // The file can't leave WAL mode while the readers have it open, so they
+    // close their connections while the writer switches.
+    void setJournalMode(OfflineJournalMode mode) {
+        closeReaders();
+        db->setJournalMode(mode);
+        openReaders();
+    }
+
+    void setWALCheckpointPages(uint32_t pages) { db->setWALCheckpointPages(pages); }
+
 private:
     expected<OfflineDownload*, std::exception_ptr> getDownload(int64_t regionID) {
         if (!onlineFileSource) {
@@ -147,11 +187,75 @@ private:
         return downloads.emplace(regionID, std::move(download)).first->second.get();
     }
 
+    void openReaders();
+    void closeReaders();
+
     std::unique_ptr<OfflineDatabase> db;
     std::map<int64_t, std::unique_ptr<OfflineDownload>> downloads;
     std::shared_ptr<FileSource> onlineFileSource;
+    std::string path;
+    std::vector<ActorRef<DatabaseFileSourceReader>> readers;
+};
+
+// Serves cache reads on a read-only connection of its own, so that they don't
+// queue behind the writes, evictions and offline region bookkeeping on the
+// DatabaseFileSourceThread, which stays the only writer. Readers see the last
+// committed state and only wait for the writer while it commits. A reader that
+// finds the database corrupt drops its connection; replacing the file is left
+// to the writer, which then opens the readers again.
+class DatabaseFileSourceReader {
+public:
+    DatabaseFileSourceReader(ActorRef<DatabaseFileSourceThread> writer_, const TileServerOptions& tileServerOptions_)
+        : writer(std::move(writer_)),
+          tileServerOptions(tileServerOptions_.clone()) {}
+
+    void open(const std::string& path) {
+        if (path == ":memory:") {
+            // Each connection would get an in-memory database of its own.
+            db.reset();
+        } else {
+            db = std::make_unique<OfflineDatabase>(path, tileServerOptions, /* readOnly = */ true);
+        }
+    }
+
+    // Requests go to the writer until the reader is opened again.
+    void close() { db.reset(); }
+
+    void request(const Resource& resource, const ActorRef<FileSourceRequest>& req) {
+        if (!db) {
+            // The writer hasn't opened the database yet, or it's in memory.
+            writer.invoke(&DatabaseFileSourceThread::request, resource, req);
+            return;
+        }
+
+        auto offlineResponse = getFromDatabase(*db, resource);
+        if (offlineResponse) {
+            // Ahead of the response, so that whatever the requester asks of the
+            // writer next comes after the timestamp update.
+            writer.invoke(&DatabaseFileSourceThread::updateAccessed, resource);
+        }
+        respond(std::move(offlineResponse), req);
+    }
+
+private:
+    ActorRef<DatabaseFileSourceThread> writer;
+    TileServerOptions tileServerOptions;
+    std::unique_ptr<OfflineDatabase> db;
 };
 
+void DatabaseFileSourceThread::openReaders() {
+    for (auto& reader : readers) {
+        reader.invoke(&DatabaseFileSourceReader::open, path);
+    }
+}
+
+void DatabaseFileSourceThread::closeReaders() {
+    // Readers never wait for the writer, so it can wait for them.
+    for (auto& reader : readers) {
+        reader.ask(&DatabaseFileSourceReader::close).wait();
+    }
+}
+
 class DatabaseFileSource::Impl {
 public:
     Impl(std::shared_ptr<FileSource> onlineFileSource,
@@ -163,12 +267,46 @@ public:
               std::move(onlineFileSource),
               resourceOptions_.cachePath())),
           resourceOptions(resourceOptions_.clone()),
-          clientOptions(clientOptions_.clone()) {}
+          clientOptions(clientOptions_.clone()) {
+        std::vector<ActorRef<DatabaseFileSourceReader>> readerRefs;
+        for (std::size_t i = 0; i < readerCount; ++i) {
+            readers.push_back(std::make_unique<util::Thread<DatabaseFileSourceReader>>(
+                util::makeThreadPrioritySetter(platform::EXPERIMENTAL_THREAD_PRIORITY_DATABASE),
+                "DatabaseFileSourceReader",
+                thread->actor(),
+                resourceOptions.tileServerOptions()));
+            readerRefs.push_back(readers.back()->actor());
+        }
+        thread->actor().invoke(&DatabaseFileSourceThread::setReaders, std::move(readerRefs));
+    }
 
     ActorRef<DatabaseFileSourceThread> actor() const { return thread->actor(); }
 
-    void pause() { thread->pause(); }
-    void resume() { thread->resume(); }
+    // Cache reads go to the readers in turn. A disabled ambient cache is left
+    // to the writer, which knows whether there are offline regions to read from.
+    void request(const Resource& resource, const ActorRef<FileSourceRequest>& req) {
+        if (ambientCacheDisabled) {
+            thread->actor().invoke(&DatabaseFileSourceThread::request, resource, req);
+        } else {
+            readers[nextReader++ % readers.size()]->actor().invoke(&DatabaseFileSourceReader::request, resource, req);
+        }
+    }
+
+    void setAmbientCacheDisabled(bool disabled) { ambientCacheDisabled = disabled; }
+
+    void pause() {
+        thread->pause();
+        for (auto& reader : readers) {
+            reader->pause();
+        }
+    }
+
+    void resume() {
+        thread->resume();
+        for (auto& reader : readers) {
+            reader->resume();
+        }
+    }
 
     void setResourceOptions(ResourceOptions options) {
         std::lock_guard<std::mutex> lock(resourceOptionsMutex);
@@ -191,7 +329,14 @@ public:
     }
 
 private:
+    // Cache reads are short and mostly wait on I/O; a couple of readers keep
+    // them off the writer without holding many connections open.
+    static constexpr std::size_t readerCount = 2;
+
     const std::unique_ptr<util::Thread<DatabaseFileSourceThread>> thread;
+    std::vector<std::unique_ptr<util::Thread<DatabaseFileSourceReader>>> readers;
+    std::atomic<std::size_t> nextReader{0};
+    std::atomic<bool> ambientCacheDisabled{false};
     mutable std::mutex resourceOptionsMutex;
     mutable std::mutex clientOptionsMutex;
     ResourceOptions resourceOptions;
@@ -208,7 +353,7 @@ DatabaseFileSource::~DatabaseFileSource() = default;
 
 std::unique_ptr<AsyncRequest> DatabaseFileSource::request(const Resource& resource, Callback callback) {
     auto req = std::make_unique<FileSourceRequest>(std::move(callback));
-    impl->actor().invoke(&DatabaseFileSourceThread::request, resource, req->actor());
+    impl->request(resource, req->actor());
     return req;
 }
 
@@ -257,6 +402,7 @@ void DatabaseFileSource::clearAmbientCache(std::function<void(std::exception_ptr
 }
 
 void DatabaseFileSource::setMaximumAmbientCacheSize(uint64_t size, std::function<void(std::exception_ptr)> callback) {
+    impl->setAmbientCacheDisabled(size == 0);
     impl->actor().invoke(&DatabaseFileSourceThread::setMaximumAmbientCacheSize, size, std::move(callback));
 }
 
@@ -316,6 +462,31 @@ void DatabaseFileSource::setOfflineMapboxTileCountLimit(uint64_t limit) const {
 void DatabaseFileSource::setProperty(const std::string& key, const mapbox::base::Value& value) {
     if (key == READ_ONLY_MODE_KEY && value.getBool()) {
         impl->actor().invoke(&DatabaseFileSourceThread::reopenDatabaseReadOnly, *value.getBool());
+    } else if (key == COMPRESSION_KEY) {
+        const auto* codec = value.getString();
+        if (codec && *codec == "deflate") {
+            impl->actor().invoke(&DatabaseFileSourceThread::setCompression, OfflineCompression::Deflate);
+        } else if (codec && *codec == "none") {
+            impl->actor().invoke(&DatabaseFileSourceThread::setCompression, OfflineCompression::None);
+        } else {
+            Log::Error(Event::General, "Invalid compression property value.");
+        }
+    } else if (key == JOURNAL_MODE_KEY) {
+        const auto* mode = value.getString();
+        if (mode && *mode == "delete") {
+            impl->actor().invoke(&DatabaseFileSourceThread::setJournalMode, OfflineJournalMode::Delete);
+        } else if (mode && *mode == "wal") {
+            impl->actor().invoke(&DatabaseFileSourceThread::setJournalMode, OfflineJournalMode::WAL);
+        } else {
+            Log::Error(Event::General, "Invalid journal-mode property value.");
+        }
+    } else if (key == WAL_CHECKPOINT_PAGES_KEY) {
+        const auto* pages = value.getUint();
+        if (pages && *pages > 0 && *pages <= std::numeric_limits<uint32_t>::max()) {
+            impl->actor().invoke(&DatabaseFileSourceThread::setWALCheckpointPages, static_cast<uint32_t>(*pages));
+        } else {
+            Log::Error(Event::General, "Invalid wal-checkpoint-pages property value.");
+        }
     } else {
         std::string message = "Resource provider does not support property " + key;
         Log::Error(Event::General, message.c_str());
@@ -21,6 +21,16 @@ void FileSourceRequest::onCancel(std::function<void()>&& callback) {
     cancelCallback = std::move(callback);
 }
 
+void FileSourceRequest::onPriorityChange(std::function<void(Resource::Priority)>&& callback) {
+    priorityCallback = std::move(callback);
+}
+
+void FileSourceRequest::setPriority(Resource::Priority priority) {
+    if (priorityCallback) {
+        priorityCallback(priority);
+    }
+}
+
 void FileSourceRequest::setResponse(const Response& response) {
     // Copy, because calling the callback will sometimes self
     // destroy this object. We cannot move because this method
@@ -2,6 +2,7 @@
 #include <mbgl/storage/resource_options.hpp>
 #include <mbgl/storage/resource.hpp>
 #include <mbgl/storage/response.hpp>
+#include <mbgl/storage/response_buffer_pool.hpp>
 #include <mbgl/util/client_options.hpp>
 #include <mbgl/util/logging.hpp>
 
@@ -15,8 +16,12 @@
 #include <curl/curl.h>
 
 #include <dlfcn.h>
+#include <algorithm>
 #include <queue>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
 #include <cassert>
 #include <cstring>
 #include <cstdio>
@@ -64,17 +69,28 @@ public:
     // creating and destroying them all the time.
     std::queue<CURL *> handles;
 
+    // Buffers for the response bodies, which are handed on as the response data without copying.
+    const std::shared_ptr<ResponseBufferPool> bufferPool = std::make_shared<ResponseBufferPool>();
+
     void setResourceOptions(ResourceOptions options);
     ResourceOptions getResourceOptions();
 
     void setClientOptions(ClientOptions options);
     ClientOptions getClientOptions();
 
+    // Applies the connection settings of the client options to the multi handle, if they
+    // changed, and to the easy handle of a new request.
+    void applyConnectionOptions(CURL *handle);
+
 private:
     mutable std::mutex resourceOptionsMutex;
     mutable std::mutex clientOptionsMutex;
     ResourceOptions resourceOptions;
     ClientOptions clientOptions;
+    bool multiOptionsChanged = true;
+
+    // Whether libcurl was built with HTTP/2 support
+    bool http2Supported = false;
 };
 
 class HTTPRequest : public AsyncRequest {
@@ -83,8 +99,11 @@ public:
     ~HTTPRequest() override;
 
     void handleResult(CURLcode code);
+    void setPriority(Resource::Priority) override;
 
 private:
+    void applyStreamWeight();
+
     static size_t headerCallback(char *buffer, size_t size, size_t nmemb, void *userp);
     static size_t writeCallback(void *contents, size_t size, size_t nmemb, void *userp);
 
@@ -113,6 +132,10 @@ HTTPFileSource::Impl::Impl(const ResourceOptions &resourceOptions_, const Client
     }
 
     share = curl_share_init();
+    // Let new connections resume earlier TLS sessions instead of doing a full handshake
+    curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+
+    http2Supported = (curl_version_info(CURLVERSION_NOW)->features & CURL_VERSION_HTTP2) != 0;
 
     multi = curl_multi_init();
     handleError(curl_multi_setopt(multi, CURLMOPT_SOCKETFUNCTION, handleSocket));
@@ -251,6 +274,7 @@ ResourceOptions HTTPFileSource::Impl::getResourceOptions() {
 void HTTPFileSource::Impl::setClientOptions(ClientOptions options) {
     std::lock_guard<std::mutex> lock(clientOptionsMutex);
     clientOptions = options;
+    multiOptionsChanged = true;
 }
 
 ClientOptions HTTPFileSource::Impl::getClientOptions() {
@@ -258,6 +282,49 @@ ClientOptions HTTPFileSource::Impl::getClientOptions() {
     return clientOptions.clone();
 }
 
+void HTTPFileSource::Impl::applyConnectionOptions(CURL *handle) {
+    std::lock_guard<std::mutex> lock(clientOptionsMutex);
+    const bool http2 = http2Supported && clientOptions.http2();
+
+    if (multiOptionsChanged) {
+        multiOptionsChanged = false;
+#if LIBCURL_VERSION_NUM >= ((7) << 16 | (43) << 8 | 0) // Multiplexing added in 7.43.0
+        handleError(curl_multi_setopt(multi, CURLMOPT_PIPELINING, http2 ? CURLPIPE_MULTIPLEX : CURLPIPE_NOTHING));
+#endif
+#if LIBCURL_VERSION_NUM >= ((7) << 16 | (30) << 8 | 0) // Added in 7.30.0
+        handleError(curl_multi_setopt(
+            multi, CURLMOPT_MAX_HOST_CONNECTIONS, static_cast<long>(clientOptions.maximumConnectionsPerHost())));
+#endif
+        // Zero leaves the size of the connection cache to libcurl
+        handleError(
+            curl_multi_setopt(multi, CURLMOPT_MAXCONNECTS, static_cast<long>(clientOptions.connectionPoolSize())));
+    }
+
+#if LIBCURL_VERSION_NUM >= ((7) << 16 | (47) << 8 | 0) // CURL_HTTP_VERSION_2TLS added in 7.47.0
+    if (http2) {
+        // HTTP/2 for HTTPS, which is all that servers offer it for, and HTTP/1.1 otherwise
+        handleError(curl_easy_setopt(handle, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS));
+        // Wait for a connection that's being set up to find out whether it can be multiplexed,
+        // rather than opening another one straight away
+        handleError(curl_easy_setopt(handle, CURLOPT_PIPEWAIT, 1L));
+    } else {
+        handleError(curl_easy_setopt(handle, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_1_1));
+    }
+#endif
+
+#if LIBCURL_VERSION_NUM >= ((7) << 16 | (25) << 8 | 0) // Added in 7.25.0
+    const auto keepAlive = static_cast<long>(clientOptions.tcpKeepAlive().count());
+    if (keepAlive > 0) {
+        handleError(curl_easy_setopt(handle, CURLOPT_TCP_KEEPALIVE, 1L));
+        handleError(curl_easy_setopt(handle, CURLOPT_TCP_KEEPIDLE, keepAlive));
+        handleError(curl_easy_setopt(handle, CURLOPT_TCP_KEEPINTVL, keepAlive));
+    }
+#endif
+
+    handleError(curl_easy_setopt(
+        handle, CURLOPT_DNS_CACHE_TIMEOUT, static_cast<long>(clientOptions.dnsCacheTimeout().count())));
+}
+
 HTTPRequest::HTTPRequest(HTTPFileSource::Impl *context_, Resource resource_, FileSource::Callback callback_)
     : context(context_),
       resource(std::move(resource_)),
@@ -293,11 +360,28 @@ HTTPRequest::HTTPRequest(HTTPFileSource::Impl *context_, Resource resource_, Fil
 #endif
     handleError(curl_easy_setopt(handle, CURLOPT_USERAGENT, "MapboxGL/1.0"));
     handleError(curl_easy_setopt(handle, CURLOPT_SHARE, context->share));
+    context->applyConnectionOptions(handle);
+    applyStreamWeight();
 
     // Start requesting the information.
     handleError(curl_multi_add_handle(context->multi, handle));
 }
 
+void HTTPRequest::setPriority(Resource::Priority priority) {
+    resource.priority = priority;
+    applyStreamWeight();
+}
+
+// Maps the request priority onto an HTTP/2 stream weight, so that streams
+// sharing a connection get bandwidth in proportion to their priority. Has no
+// effect on HTTP/1.1 connections.
+void HTTPRequest::applyStreamWeight() {
+#if LIBCURL_VERSION_NUM >= ((7) << 16 | (46) << 8 | 0) // Added in 7.46.0
+    const long weight = 256 - static_cast<long>(resource.priority);
+    handleError(curl_easy_setopt(handle, CURLOPT_STREAM_WEIGHT, weight));
+#endif
+}
+
 HTTPRequest::~HTTPRequest() {
     if (curl_multi_remove_handle(context->multi, handle) != CURLM_OK) {
         mbgl::Log::Error(mbgl::Event::HttpRequest, "Error removing curl multi handle");
@@ -313,13 +397,28 @@ HTTPRequest::~HTTPRequest() {
 }
 
 // This function is called when we have new data for a request. We just append
-// it to the string containing the previous data.
+// it to the string containing the previous data, which is sized for the whole
+// body when the first chunk arrives.
 size_t HTTPRequest::writeCallback(void *const contents, const size_t size, const size_t nmemb, void *userp) {
     assert(userp);
     auto impl = reinterpret_cast<HTTPRequest *>(userp);
 
     if (!impl->data) {
-        impl->data = std::make_shared<std::string>();
+        // Size the buffer for the whole body up front, if the server told us its length. For
+        // compressed responses this is the compressed size, which is still a good start.
+        std::size_t contentLength = 0;
+#if LIBCURL_VERSION_NUM >= ((7) << 16 | (55) << 8 | 0) // Added in 7.55.0
+        curl_off_t length = -1;
+        if (curl_easy_getinfo(impl->handle, CURLINFO_CONTENT_LENGTH_DOWNLOAD_T, &length) == CURLE_OK && length > 0) {
+            contentLength = static_cast<std::size_t>(length);
+        }
+#else
+        double length = -1;
+        if (curl_easy_getinfo(impl->handle, CURLINFO_CONTENT_LENGTH_DOWNLOAD, &length) == CURLE_OK && length > 0) {
+            contentLength = static_cast<std::size_t>(length);
+        }
+#endif
+        impl->data = impl->context->bufferPool->acquire(std::max(contentLength, size * nmemb));
     }
 
     impl->data->append(static_cast<char *>(contents), size * nmemb);
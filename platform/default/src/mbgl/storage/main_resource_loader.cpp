@@ -10,8 +10,13 @@
 #include <mbgl/util/stopwatch.hpp>
 #include <mbgl/util/thread.hpp>
 
+#include <algorithm>
 #include <cassert>
+#include <cstdint>
 #include <map>
+#include <optional>
+#include <string>
+#include <unordered_map>
 
 namespace mbgl {
 
@@ -29,8 +34,42 @@ public:
           mbtilesFileSource(std::move(mbtilesFileSource_)) {}
 
     void request(AsyncRequest* req, const Resource& resource, const ActorRef<FileSourceRequest>& ref) {
-        auto callback = [ref](const Response& res) {
-            ref.invoke(&FileSourceRequest::setResponse, res);
+        // Attach to an identical request that is already in flight, rather than
+        // looking the resource up in the cache and on the network again.
+        std::string key = coalescingKey(resource);
+        if (auto it = sharedRequests.find(key); it != sharedRequests.end()) {
+            SharedRequest& shared = *it->second;
+            shared.requesters.emplace(req, Requester{ref, resource.priority});
+            requesters.emplace(req, &shared);
+            updatePriority(shared);
+            if (shared.dataResponse) {
+                ref.invoke(&FileSourceRequest::setResponse, *shared.dataResponse);
+            }
+            if (shared.response) {
+                ref.invoke(&FileSourceRequest::setResponse, *shared.response);
+            }
+            return;
+        }
+
+        auto& shared = *sharedRequests.emplace(key, std::make_unique<SharedRequest>()).first->second;
+        shared.key = std::move(key);
+        shared.priorData = resource.priorData;
+        shared.priority = resource.priority;
+        shared.requesters.emplace(req, Requester{ref, resource.priority});
+        requesters.emplace(req, &shared);
+
+        // The shared request is destroyed along with its task, which stops the
+        // callbacks, so it outlives them.
+        auto callback = [sharedPtr = &shared](const Response& res) {
+            if (res.data) {
+                sharedPtr->dataResponse = res;
+                sharedPtr->response.reset();
+            } else {
+                sharedPtr->response = res;
+            }
+            for (const auto& requester : sharedPtr->requesters) {
+                requester.second.ref.invoke(&FileSourceRequest::setResponse, res);
+            }
         };
 
         auto requestFromNetwork = [=](const Resource& res,
@@ -60,28 +99,26 @@ public:
             });
         };
 
-        // Initial tasksSize is used to check whether any of
-        // the sources were able to request a resource.
-        const std::size_t tasksSize = tasks.size();
-
         // Waterfall resource request processing and return early once resource was requested.
         if (assetFileSource && assetFileSource->canRequest(resource)) {
             // Asset request
-            tasks[req] = assetFileSource->request(resource, callback);
+            shared.task = assetFileSource->request(resource, callback);
         } else if (mbtilesFileSource && mbtilesFileSource->canRequest(resource)) {
             // Local file request
-            tasks[req] = mbtilesFileSource->request(resource, callback);
+            shared.task = mbtilesFileSource->request(resource, callback);
         } else if (localFileSource && localFileSource->canRequest(resource)) {
             // Local file request
-            tasks[req] = localFileSource->request(resource, callback);
+            shared.task = localFileSource->request(resource, callback);
         } else if (databaseFileSource && databaseFileSource->canRequest(resource)) {
             // Try cache only request if needed.
             if (resource.loadingMethod == Resource::LoadingMethod::CacheOnly) {
-                tasks[req] = databaseFileSource->request(resource, callback);
+                shared.task = databaseFileSource->request(resource, callback);
             } else {
                 // Cache request with fallback to network with cache control
-                tasks[req] = databaseFileSource->request(resource, [=](const Response& response) {
+                shared.task = databaseFileSource->request(resource, [=, sharedPtr = &shared](const Response& response) {
                     Resource res = resource;
+                    // Pick up priority changes made while the cache was being queried.
+                    res.setPriority(sharedPtr->priority);
 
                     // Resource is in the cache
                     if (!response.noContent) {
@@ -103,16 +140,16 @@ public:
                         res.priorEtag = response.etag;
                     }
 
-                    tasks[req] = requestFromNetwork(res, std::move(tasks[req]));
+                    sharedPtr->task = requestFromNetwork(res, std::move(sharedPtr->task));
                 });
             }
-        } else if (auto networkReq = requestFromNetwork(resource, nullptr)) {
+        } else {
             // Get from the online file source
-            tasks[req] = std::move(networkReq);
+            shared.task = requestFromNetwork(resource, nullptr);
         }
 
-        // If no new tasks were added, notify client that request cannot be processed.
-        if (tasks.size() == tasksSize) {
+        // If none of the sources was able to request the resource, notify client that request cannot be processed.
+        if (!shared.task) {
             Response response;
             response.noContent = true;
             response.error = std::make_unique<Response::Error>(Response::Error::Reason::Other,
@@ -121,18 +158,119 @@ public:
         }
     }
 
+    void setPriority(AsyncRequest* req, Resource::Priority priority) {
+        assert(req);
+        auto it = requesters.find(req);
+        if (it == requesters.end()) {
+            return;
+        }
+        SharedRequest& shared = *it->second;
+        shared.requesters.at(req).priority = priority;
+        updatePriority(shared);
+    }
+
     void cancel(AsyncRequest* req) {
         assert(req);
-        tasks.erase(req);
+        auto it = requesters.find(req);
+        if (it == requesters.end()) {
+            return;
+        }
+        SharedRequest& shared = *it->second;
+        requesters.erase(it);
+        shared.requesters.erase(req);
+        if (shared.requesters.empty()) {
+            sharedRequests.erase(sharedRequests.find(shared.key));
+        } else {
+            updatePriority(shared);
+        }
     }
 
 private:
+    struct Requester {
+        ActorRef<FileSourceRequest> ref;
+        Resource::Priority priority;
+    };
+
+    // A chain of requests through the sources, shared by all concurrent
+    // requests for the same resource. Every requester gets every response.
+    struct SharedRequest {
+        std::string key;
+        // Keeps the address in the key from being reused while this is in flight
+        std::shared_ptr<const std::string> priorData;
+        std::unique_ptr<AsyncRequest> task;
+        std::map<AsyncRequest*, Requester> requesters;
+        // The highest priority of the requesters
+        Resource::Priority priority = Resource::Priority::Regular;
+        // For requesters that attach later: the latest response that carried
+        // data, and the latest response if it came after that one. A 304 or an
+        // error alone would leave them without the data.
+        std::optional<Response> dataResponse;
+        std::optional<Response> response;
+    };
+
+    // Requests are only shared when they would make the same request to the
+    // sources: the database looks tiles up by their tile data, and the prior
+    // data decides what a 304 resolves to, so both are part of the key along
+    // with the conditional request headers. Prior data is compared by identity.
+    static std::string coalescingKey(const Resource& resource) {
+        std::string key = resource.url;
+        key += '\n';
+        key += std::to_string(static_cast<int>(resource.kind));
+        key += '\n';
+        key += std::to_string(static_cast<int>(resource.usage));
+        key += '\n';
+        if (resource.tileData) {
+            const auto& tile = *resource.tileData;
+            key += tile.urlTemplate;
+            key += '\n';
+            key += std::to_string(tile.pixelRatio) + '/' + std::to_string(tile.x) + '/' + std::to_string(tile.y) + '/' +
+                   std::to_string(tile.z);
+        }
+        key += '\n';
+        key += std::to_string(static_cast<int>(resource.loadingMethod));
+        key += '\n';
+        key += std::to_string(static_cast<int>(resource.storagePolicy));
+        key += '\n';
+        key += std::to_string(resource.minimumUpdateInterval.count());
+        key += '\n';
+        if (resource.priorEtag) {
+            key += *resource.priorEtag;
+        }
+        key += '\n';
+        if (resource.priorModified) {
+            key += std::to_string(resource.priorModified->time_since_epoch().count());
+        }
+        key += '\n';
+        if (resource.priorExpires) {
+            key += std::to_string(resource.priorExpires->time_since_epoch().count());
+        }
+        key += '\n';
+        if (resource.priorData) {
+            key += std::to_string(reinterpret_cast<std::uintptr_t>(resource.priorData.get()));
+        }
+        return key;
+    }
+
+    static void updatePriority(SharedRequest& shared) {
+        auto priority = Resource::Priority::Low;
+        for (const auto& requester : shared.requesters) {
+            priority = std::min(priority, requester.second.priority);
+        }
+        if (priority != shared.priority) {
+            shared.priority = priority;
+            if (shared.task) {
+                shared.task->setPriority(priority);
+            }
+        }
+    }
+
     const std::shared_ptr<FileSource> assetFileSource;
     const std::shared_ptr<FileSource> databaseFileSource;
     const std::shared_ptr<FileSource> localFileSource;
     const std::shared_ptr<FileSource> onlineFileSource;
     const std::shared_ptr<FileSource> mbtilesFileSource;
-    std::map<AsyncRequest*, std::unique_ptr<AsyncRequest>> tasks;
+    std::unordered_map<std::string, std::unique_ptr<SharedRequest>> sharedRequests;
+    std::map<AsyncRequest*, SharedRequest*> requesters;
 };
 
 class MainResourceLoader::Impl {
@@ -167,6 +305,9 @@ public:
         req->onCancel([actorRef = thread->actor(), req = req.get()]() {
             actorRef.invoke(&MainResourceLoaderThread::cancel, req);
         });
+        req->onPriorityChange([actorRef = thread->actor(), req = req.get()](Resource::Priority priority) {
+            actorRef.invoke(&MainResourceLoaderThread::setPriority, req, priority);
+        });
         thread->actor().invoke(&MainResourceLoaderThread::request, req.get(), resource, req->actor());
         return req;
     }
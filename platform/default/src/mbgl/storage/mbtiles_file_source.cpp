@@ -205,7 +205,7 @@ public:
         for (mapbox::sqlite::Query q(stmt); q.run();) {
             std::optional<std::string> data = q.get<std::optional<std::string>>(0);
             if (data) {
-                response.data = std::make_shared<std::string>(*data);
+                response.data = std::make_shared<std::string>(std::move(*data));
                 response.noContent = false;
                 response.expires = Timestamp::max();
                 response.etag = resource.url;
@@ -11,11 +11,38 @@
 #include <mbgl/storage/offline_schema.hpp>
 #include <mbgl/storage/merge_sideloaded.hpp>
 
+#include <utility>
+
 namespace mbgl {
 
-OfflineDatabase::OfflineDatabase(std::string path_, const TileServerOptions& options)
+namespace {
+
+// Formats that deflate can't shrink any further; trying would only cost time.
+bool isCompressedFormat(const std::string& data) {
+    const auto startsWith = [&](const char* magic, std::size_t length, std::size_t offset = 0) {
+        return data.size() >= offset + length && data.compare(offset, length, magic, length) == 0;
+    };
+    return startsWith("\x89PNG\r\n\x1a\n", 8) || startsWith("\xff\xd8\xff", 3) ||
+           (startsWith("RIFF", 4) && startsWith("WEBP", 4, 8)) || startsWith("\x1f\x8b", 2);
+}
+
+std::string decodeData(std::string&& data, int64_t codec) {
+    switch (codec) {
+        case static_cast<int64_t>(OfflineCompression::None):
+            return std::move(data);
+        case static_cast<int64_t>(OfflineCompression::Deflate):
+            return util::decompress(data);
+    }
+    // Written by a newer version with a codec we don't know.
+    throw std::runtime_error("Unsupported compression codec " + std::to_string(codec));
+}
+
+} // namespace
+
+OfflineDatabase::OfflineDatabase(std::string path_, const TileServerOptions& options, bool readOnly_)
     : path(std::move(path_)),
-      tileServerOptions(options) {
+      tileServerOptions(options),
+      readOnly(readOnly_) {
     try {
         initialize();
     } catch (...) {
@@ -29,6 +56,16 @@ OfflineDatabase::~OfflineDatabase() {
 }
 
 void OfflineDatabase::initialize() {
+    openDatabase();
+    if (!readOnly) {
+        applyJournalMode();
+    }
+    if (reopenedCallback) {
+        reopenedCallback();
+    }
+}
+
+void OfflineDatabase::openDatabase() {
     assert(!db);
     assert(statements.empty());
 
@@ -67,12 +104,18 @@ void OfflineDatabase::initialize() {
             migrateToVersion6();
             // fall through
         case 6:
+            migrateToVersion7();
+            // fall through
+        case 7:
+            migrateToVersion8();
+            // fall through
+        case 8:
             // Happy path; we're done
             return;
         default:
             // Downgrade: delete the database and try to reinitialize.
             removeExisting();
-            initialize();
+            openDatabase();
     }
 }
 
@@ -109,6 +152,13 @@ void OfflineDatabase::handleError(const mapbox::sqlite::Exception& ex, const cha
         // The database was corruped, moved away, or deleted. We're going to
         // start fresh with a clean slate for the next operation.
         Log::Error(Event::Database, static_cast<int>(ex.code), std::string("Can't ") + action + ": " + ex.what());
+        if (readOnly) {
+            // Another connection may still be writing to the database; leave
+            // replacing it to that one and open it again for the next operation.
+            statements.clear();
+            db.reset();
+            return;
+        }
         try {
             removeExisting();
         } catch (const util::IOException& ioEx) {
@@ -154,6 +204,9 @@ void OfflineDatabase::removeExisting() {
     db.reset();
 
     util::deleteFile(path);
+    // A log left behind would be replayed onto the new database.
+    util::deleteFile(path + "-wal");
+    util::deleteFile(path + "-shm");
 }
 
 void OfflineDatabase::removeOldCacheTable() {
@@ -173,10 +226,38 @@ void OfflineDatabase::createSchema() {
     db->exec("PRAGMA synchronous = FULL");
     mapbox::sqlite::Transaction transaction(*db);
     db->exec(offlineDatabaseSchema);
-    db->exec("PRAGMA user_version = 6");
+    createTileDataTriggers();
+    db->exec("PRAGMA user_version = 8");
     transaction.commit();
 }
 
+void OfflineDatabase::applyJournalMode() {
+    assert(db);
+    checkFlags();
+
+    const bool wal = journalMode == OfflineJournalMode::WAL;
+    std::string mode;
+    {
+        mapbox::sqlite::Statement statement(*db, wal ? "PRAGMA journal_mode = WAL" : "PRAGMA journal_mode = DELETE");
+        mapbox::sqlite::Query query(statement);
+        query.run();
+        mode = query.get<std::string>(0);
+    }
+    // In-memory databases keep a journal mode of their own.
+    if (mode != (wal ? "wal" : "delete") && mode != "memory") {
+        Log::Warning(Event::Database, "Can't change the database journal mode, it stays " + mode);
+    }
+
+    if (mode == "wal") {
+        const auto pageSize = getPragma<int64_t>("PRAGMA page_size");
+        db->exec("PRAGMA synchronous = NORMAL");
+        db->exec("PRAGMA wal_autocheckpoint = " + std::to_string(walCheckpointPages));
+        db->exec("PRAGMA journal_size_limit = " + std::to_string(pageSize * walCheckpointPages));
+    } else {
+        db->exec("PRAGMA synchronous = FULL");
+    }
+}
+
 void OfflineDatabase::migrateToVersion3() {
     assert(db);
     checkFlags();
@@ -215,6 +296,143 @@ void OfflineDatabase::migrateToVersion6() {
     transaction.commit();
 }
 
+void OfflineDatabase::migrateToVersion7() {
+    assert(db);
+    checkFlags();
+
+    mapbox::sqlite::Transaction transaction(*db);
+    db->exec(
+        "CREATE TABLE region_checkpoints ("
+        "  region_id INTEGER NOT NULL REFERENCES regions(id) ON DELETE CASCADE,"
+        "  url_template TEXT NOT NULL,"
+        "  min_zoom INTEGER NOT NULL,"
+        "  max_zoom INTEGER NOT NULL,"
+        "  scheme INTEGER NOT NULL,"
+        "  position INTEGER NOT NULL,"
+        "  tile_count INTEGER NOT NULL,"
+        "  tile_size INTEGER NOT NULL,"
+        "  UNIQUE (region_id, url_template)"
+        ")");
+    db->exec("PRAGMA user_version = 7");
+    transaction.commit();
+}
+
+// Version 8 moves the tile contents out of `tiles` into `tile_data`, storing
+// identical contents only once. Dropping the old columns requires rebuilding
+// the table, with foreign keys disabled so that dropping the old table doesn't
+// violate the references from `region_tiles`. The setting can't be changed
+// inside a transaction.
+void OfflineDatabase::migrateToVersion8() {
+    assert(db);
+    checkFlags();
+
+    db->exec("PRAGMA foreign_keys = OFF");
+    {
+        mapbox::sqlite::Transaction transaction(*db);
+        db->exec(
+            "CREATE TABLE tile_data ("
+            "  id INTEGER NOT NULL PRIMARY KEY AUTOINCREMENT,"
+            "  hash INTEGER NOT NULL,"
+            "  data BLOB NOT NULL,"
+            "  compressed INTEGER NOT NULL DEFAULT 0,"
+            "  ref_count INTEGER NOT NULL DEFAULT 0"
+            ")");
+        db->exec("CREATE INDEX tile_data_hash ON tile_data (hash)");
+        db->exec(
+            "CREATE TABLE tiles_v8 ("
+            "  id INTEGER NOT NULL PRIMARY KEY AUTOINCREMENT,"
+            "  url_template TEXT NOT NULL,"
+            "  pixel_ratio INTEGER NOT NULL,"
+            "  z INTEGER NOT NULL,"
+            "  x INTEGER NOT NULL,"
+            "  y INTEGER NOT NULL,"
+            "  expires INTEGER,"
+            "  modified INTEGER,"
+            "  etag TEXT,"
+            "  data_id INTEGER REFERENCES tile_data(id),"
+            "  accessed INTEGER NOT NULL,"
+            "  must_revalidate INTEGER NOT NULL DEFAULT 0,"
+            "  UNIQUE (url_template, pixel_ratio, z, x, y)"
+            ")");
+        db->exec(
+            "INSERT INTO tiles_v8 (id, url_template, pixel_ratio, z, x, y, expires, modified, etag, accessed, "
+            "                      must_revalidate) "
+            "SELECT id, url_template, pixel_ratio, z, x, y, expires, modified, etag, accessed, must_revalidate "
+            "FROM tiles");
+
+        {
+            // There are no triggers on `tiles_v8`, so the references are counted here.
+            mapbox::sqlite::Statement selectStatement(
+                *db, "SELECT id, data, compressed FROM tiles WHERE data IS NOT NULL");
+            mapbox::sqlite::Statement updateStatement(*db, "UPDATE tiles_v8 SET data_id = ?1 WHERE id = ?2");
+            mapbox::sqlite::Statement referenceStatement(
+                *db, "UPDATE tile_data SET ref_count = ref_count + 1 WHERE id = ?1");
+            mapbox::sqlite::Query selectQuery(selectStatement);
+            while (selectQuery.run()) {
+                const auto dataID = putTileData(selectQuery.get<std::string>(1),
+                                                static_cast<OfflineCompression>(selectQuery.get<int>(2)));
+
+                mapbox::sqlite::Query updateQuery(updateStatement);
+                updateQuery.bind(1, dataID);
+                updateQuery.bind(2, selectQuery.get<int64_t>(0));
+                updateQuery.run();
+
+                mapbox::sqlite::Query referenceQuery(referenceStatement);
+                referenceQuery.bind(1, dataID);
+                referenceQuery.run();
+            }
+        }
+
+        db->exec("DROP TABLE tiles");
+        db->exec("ALTER TABLE tiles_v8 RENAME TO tiles");
+        db->exec("CREATE INDEX tiles_accessed ON tiles (accessed)");
+        db->exec("CREATE INDEX tiles_data_id ON tiles (data_id)");
+        createTileDataTriggers();
+        db->exec("PRAGMA user_version = 8");
+        transaction.commit();
+    }
+    db->exec("PRAGMA foreign_keys = ON");
+
+    // Release the space of the duplicates.
+    statements.clear();
+    vacuum();
+}
+
+// The triggers keep `tile_data.ref_count` in sync with the tiles referencing
+// each row, and delete rows that are no longer referenced, so that none of
+// the statements deleting tiles (eviction, clearing the ambient cache) need
+// to know about deduplication. They are created one statement at a time,
+// because some SQLite wrappers split scripts at semicolons, which would cut
+// the trigger bodies apart.
+void OfflineDatabase::createTileDataTriggers() {
+    static constexpr const char* triggers[] = {
+        "CREATE TRIGGER tiles_data_insert AFTER INSERT ON tiles "
+        "WHEN NEW.data_id IS NOT NULL "
+        "BEGIN "
+        "  UPDATE tile_data SET ref_count = ref_count + 1 WHERE id = NEW.data_id; "
+        "END",
+        "CREATE TRIGGER tiles_data_update AFTER UPDATE OF data_id ON tiles "
+        "WHEN OLD.data_id IS NOT NEW.data_id "
+        "BEGIN "
+        "  UPDATE tile_data SET ref_count = ref_count + 1 WHERE id = NEW.data_id; "
+        "  UPDATE tile_data SET ref_count = ref_count - 1 WHERE id = OLD.data_id; "
+        "  DELETE FROM tile_data WHERE id = OLD.data_id AND ref_count = 0; "
+        "END",
+        "CREATE TRIGGER tiles_data_delete AFTER DELETE ON tiles "
+        "WHEN OLD.data_id IS NOT NULL "
+        "BEGIN "
+        "  UPDATE tile_data SET ref_count = ref_count - 1 WHERE id = OLD.data_id; "
+        "  DELETE FROM tile_data WHERE id = OLD.data_id AND ref_count = 0; "
+        "END",
+    };
+
+    for (const char* trigger : triggers) {
+        mapbox::sqlite::Statement statement(*db, trigger);
+        mapbox::sqlite::Query query(statement);
+        query.run();
+    }
+}
+
 void OfflineDatabase::vacuum() {
     assert(db);
     checkFlags();
@@ -304,13 +522,18 @@ std::pair<bool, uint64_t> OfflineDatabase::putInternal(const Resource& resource,
     }
 
     std::string compressedData;
-    bool compressed = false;
+    OfflineCompression codec = OfflineCompression::None;
     uint64_t size = 0;
 
     if (response.data) {
-        compressedData = util::compress(*response.data);
-        compressed = compressedData.size() < response.data->size();
-        size = compressed ? compressedData.size() : response.data->size();
+        size = response.data->size();
+        if (compression == OfflineCompression::Deflate && !isCompressedFormat(*response.data)) {
+            compressedData = util::compress(*response.data);
+            if (compressedData.size() < size) {
+                codec = OfflineCompression::Deflate;
+                size = compressedData.size();
+            }
+        }
     }
 
     std::optional<DatabaseSizeChangeStats> stats;
@@ -324,21 +547,16 @@ std::pair<bool, uint64_t> OfflineDatabase::putInternal(const Resource& resource,
 
     bool inserted;
 
+    // Bind the response data by reference, it may be large
+    static const std::string noData;
+    const std::string& uncompressedData = response.data ? *response.data : noData;
+    const std::string& data = codec != OfflineCompression::None ? std::as_const(compressedData) : uncompressedData;
+
     if (resource.kind == Resource::Kind::Tile) {
         assert(resource.tileData);
-        inserted = putTile(*resource.tileData,
-                           response,
-                           compressed      ? compressedData
-                           : response.data ? *response.data
-                                           : "",
-                           compressed);
+        inserted = putTile(*resource.tileData, response, data, codec);
     } else {
-        inserted = putResource(resource,
-                               response,
-                               compressed      ? compressedData
-                               : response.data ? *response.data
-                                               : "",
-                               compressed);
+        inserted = putResource(resource, response, data, codec);
     }
 
     if (stats) {
@@ -348,14 +566,52 @@ std::pair<bool, uint64_t> OfflineDatabase::putInternal(const Resource& resource,
     return {inserted, size};
 }
 
+void OfflineDatabase::updateAccessed(const Resource& resource) try {
+    if (readOnly) return;
+
+    if (resource.kind == Resource::Kind::Tile) {
+        assert(resource.tileData);
+        updateTileAccessed(*resource.tileData);
+    } else {
+        updateResourceAccessed(resource);
+    }
+} catch (...) {
+    handleError("update timestamp");
+}
+
+void OfflineDatabase::updateResourceAccessed(const Resource& resource) {
+    mapbox::sqlite::Query accessedQuery{getStatement("UPDATE resources SET accessed = ?1 WHERE url = ?2")};
+    accessedQuery.bind(1, util::now());
+    accessedQuery.bind(2, resource.url);
+    accessedQuery.run();
+}
+
+void OfflineDatabase::updateTileAccessed(const Resource::TileData& tile) {
+    // clang-format off
+    mapbox::sqlite::Query accessedQuery{ getStatement(
+        "UPDATE tiles "
+        "SET accessed       = ?1 "
+        "WHERE url_template = ?2 "
+        "  AND pixel_ratio  = ?3 "
+        "  AND x            = ?4 "
+        "  AND y            = ?5 "
+        "  AND z            = ?6 ") };
+    // clang-format on
+
+    accessedQuery.bind(1, util::now());
+    accessedQuery.bind(2, tile.urlTemplate);
+    accessedQuery.bind(3, tile.pixelRatio);
+    accessedQuery.bind(4, tile.x);
+    accessedQuery.bind(5, tile.y);
+    accessedQuery.bind(6, tile.z);
+    accessedQuery.run();
+}
+
 std::optional<std::pair<Response, uint64_t>> OfflineDatabase::getResource(const Resource& resource) {
     // Update accessed timestamp used for LRU eviction.
     if (!readOnly) {
         try {
-            mapbox::sqlite::Query accessedQuery{getStatement("UPDATE resources SET accessed = ?1 WHERE url = ?2")};
-            accessedQuery.bind(1, util::now());
-            accessedQuery.bind(2, resource.url);
-            accessedQuery.run();
+            updateResourceAccessed(resource);
         } catch (const mapbox::sqlite::Exception& ex) {
             if (ex.code == mapbox::sqlite::ResultCode::NotADB || ex.code == mapbox::sqlite::ResultCode::Corrupt) {
                 throw;
@@ -392,12 +648,9 @@ std::optional<std::pair<Response, uint64_t>> OfflineDatabase::getResource(const
     auto data = query.get<std::optional<std::string>>(4);
     if (!data) {
         response.noContent = true;
-    } else if (query.get<bool>(5)) {
-        response.data = std::make_shared<std::string>(util::decompress(*data));
-        size = data->length();
     } else {
-        response.data = std::make_shared<std::string>(*data);
         size = data->length();
+        response.data = std::make_shared<std::string>(decodeData(std::move(*data), query.get<int64_t>(5)));
     }
 
     return std::make_pair(response, size);
@@ -416,7 +669,7 @@ std::optional<int64_t> OfflineDatabase::hasResource(const Resource& resource) {
 bool OfflineDatabase::putResource(const Resource& resource,
                                   const Response& response,
                                   const std::string& data,
-                                  bool compressed) {
+                                  OfflineCompression codec) {
     checkFlags();
 
     if (response.notModified) {
@@ -465,7 +718,7 @@ bool OfflineDatabase::putResource(const Resource& resource,
         updateQuery.bind(8, false);
     } else {
         updateQuery.bindBlob(7, data.data(), data.size(), false);
-        updateQuery.bind(8, compressed);
+        updateQuery.bind(8, static_cast<uint8_t>(codec));
     }
 
     updateQuery.run();
@@ -492,7 +745,7 @@ bool OfflineDatabase::putResource(const Resource& resource,
         insertQuery.bind(9, false);
     } else {
         insertQuery.bindBlob(8, data.data(), data.size(), false);
-        insertQuery.bind(9, compressed);
+        insertQuery.bind(9, static_cast<uint8_t>(codec));
     }
 
     insertQuery.run();
@@ -504,24 +757,7 @@ std::optional<std::pair<Response, uint64_t>> OfflineDatabase::getTile(const Reso
     // Update accessed timestamp used for LRU eviction.
     if (!readOnly) {
         try {
-            // clang-format off
-            mapbox::sqlite::Query accessedQuery{ getStatement(
-                "UPDATE tiles "
-                "SET accessed       = ?1 "
-                "WHERE url_template = ?2 "
-                "  AND pixel_ratio  = ?3 "
-                "  AND x            = ?4 "
-                "  AND y            = ?5 "
-                "  AND z            = ?6 ") };
-            // clang-format on
-
-            accessedQuery.bind(1, util::now());
-            accessedQuery.bind(2, tile.urlTemplate);
-            accessedQuery.bind(3, tile.pixelRatio);
-            accessedQuery.bind(4, tile.x);
-            accessedQuery.bind(5, tile.y);
-            accessedQuery.bind(6, tile.z);
-            accessedQuery.run();
+            updateTileAccessed(tile);
         } catch (const mapbox::sqlite::Exception& ex) {
             if (ex.code == mapbox::sqlite::ResultCode::NotADB || ex.code == mapbox::sqlite::ResultCode::Corrupt) {
                 throw;
@@ -535,9 +771,10 @@ std::optional<std::pair<Response, uint64_t>> OfflineDatabase::getTile(const Reso
 
     // clang-format off
     mapbox::sqlite::Query query{ getStatement(
-        //        0      1           2,            3,      4,      5
-        "SELECT etag, expires, must_revalidate, modified, data, compressed "
+        //        0      1           2,            3,           4,                5
+        "SELECT etag, expires, must_revalidate, modified, tile_data.data, tile_data.compressed "
         "FROM tiles "
+        "LEFT JOIN tile_data ON tile_data.id = data_id "
         "WHERE url_template = ?1 "
         "  AND pixel_ratio  = ?2 "
         "  AND x            = ?3 "
@@ -566,12 +803,9 @@ std::optional<std::pair<Response, uint64_t>> OfflineDatabase::getTile(const Reso
     std::optional<std::string> data = query.get<std::optional<std::string>>(4);
     if (!data) {
         response.noContent = true;
-    } else if (query.get<bool>(5)) {
-        response.data = std::make_shared<std::string>(util::decompress(*data));
-        size = data->length();
     } else {
-        response.data = std::make_shared<std::string>(*data);
         size = data->length();
+        response.data = std::make_shared<std::string>(decodeData(std::move(*data), query.get<int64_t>(5)));
     }
 
     return std::make_pair(response, size);
@@ -580,8 +814,9 @@ std::optional<std::pair<Response, uint64_t>> OfflineDatabase::getTile(const Reso
 std::optional<int64_t> OfflineDatabase::hasTile(const Resource::TileData& tile) {
     // clang-format off
     mapbox::sqlite::Query size{ getStatement(
-        "SELECT length(data) "
+        "SELECT length(tile_data.data) "
         "FROM tiles "
+        "LEFT JOIN tile_data ON tile_data.id = data_id "
         "WHERE url_template = ?1 "
         "  AND pixel_ratio  = ?2 "
         "  AND x            = ?3 "
@@ -605,7 +840,7 @@ std::optional<int64_t> OfflineDatabase::hasTile(const Resource::TileData& tile)
 bool OfflineDatabase::putTile(const Resource::TileData& tile,
                               const Response& response,
                               const std::string& data,
-                              bool compressed) {
+                              OfflineCompression codec) {
     checkFlags();
 
     if (response.notModified) {
@@ -634,6 +869,11 @@ bool OfflineDatabase::putTile(const Resource::TileData& tile,
         return false;
     }
 
+    std::optional<int64_t> dataID;
+    if (!response.noContent) {
+        dataID = putTileData(data, codec);
+    }
+
     // We can't use REPLACE because it would change the id value.
 
     // clang-format off
@@ -644,13 +884,12 @@ bool OfflineDatabase::putTile(const Resource::TileData& tile,
         "    expires         = ?3, "
         "    must_revalidate = ?4, "
         "    accessed        = ?5, "
-        "    data            = ?6, "
-        "    compressed      = ?7 "
-        "WHERE url_template  = ?8 "
-        "  AND pixel_ratio   = ?9 "
-        "  AND x             = ?10 "
-        "  AND y             = ?11 "
-        "  AND z             = ?12 ") };
+        "    data_id         = ?6 "
+        "WHERE url_template  = ?7 "
+        "  AND pixel_ratio   = ?8 "
+        "  AND x             = ?9 "
+        "  AND y             = ?10 "
+        "  AND z             = ?11 ") };
     // clang-format on
 
     updateQuery.bind(1, response.modified);
@@ -658,18 +897,16 @@ bool OfflineDatabase::putTile(const Resource::TileData& tile,
     updateQuery.bind(3, response.expires);
     updateQuery.bind(4, response.mustRevalidate);
     updateQuery.bind(5, util::now());
-    updateQuery.bind(8, tile.urlTemplate);
-    updateQuery.bind(9, tile.pixelRatio);
-    updateQuery.bind(10, tile.x);
-    updateQuery.bind(11, tile.y);
-    updateQuery.bind(12, tile.z);
-
-    if (response.noContent) {
-        updateQuery.bind(6, nullptr);
-        updateQuery.bind(7, false);
+    updateQuery.bind(7, tile.urlTemplate);
+    updateQuery.bind(8, tile.pixelRatio);
+    updateQuery.bind(9, tile.x);
+    updateQuery.bind(10, tile.y);
+    updateQuery.bind(11, tile.z);
+
+    if (dataID) {
+        updateQuery.bind(6, *dataID);
     } else {
-        updateQuery.bindBlob(6, data.data(), data.size(), false);
-        updateQuery.bind(7, compressed);
+        updateQuery.bind(6, nullptr);
     }
 
     updateQuery.run();
@@ -679,8 +916,8 @@ bool OfflineDatabase::putTile(const Resource::TileData& tile,
 
     // clang-format off
     mapbox::sqlite::Query insertQuery{ getStatement(
-        "INSERT INTO tiles (url_template, pixel_ratio, x,  y,  z,  modified, must_revalidate, etag, expires, accessed,  data, compressed) "
-        "VALUES            (?1,           ?2,          ?3, ?4, ?5, ?6,       ?7,              ?8,   ?9,      ?10,       ?11,  ?12)") };
+        "INSERT INTO tiles (url_template, pixel_ratio, x,  y,  z,  modified, must_revalidate, etag, expires, accessed,  data_id) "
+        "VALUES            (?1,           ?2,          ?3, ?4, ?5, ?6,       ?7,              ?8,   ?9,      ?10,       ?11)") };
     // clang-format on
 
     insertQuery.bind(1, tile.urlTemplate);
@@ -694,12 +931,10 @@ bool OfflineDatabase::putTile(const Resource::TileData& tile,
     insertQuery.bind(9, response.expires);
     insertQuery.bind(10, util::now());
 
-    if (response.noContent) {
-        insertQuery.bind(11, nullptr);
-        insertQuery.bind(12, false);
+    if (dataID) {
+        insertQuery.bind(11, *dataID);
     } else {
-        insertQuery.bindBlob(11, data.data(), data.size(), false);
-        insertQuery.bind(12, compressed);
+        insertQuery.bind(11, nullptr);
     }
 
     insertQuery.run();
@@ -707,6 +942,43 @@ bool OfflineDatabase::putTile(const Resource::TileData& tile,
     return true;
 }
 
+int64_t OfflineDatabase::putTileData(const std::string& data, OfflineCompression codec) {
+    // The hash only narrows down the candidates, the contents are compared as well.
+    const uint32_t hash = util::crc32(data.data(), data.size());
+
+    // clang-format off
+    mapbox::sqlite::Query selectQuery{ getStatement(
+        "SELECT id "
+        "FROM tile_data "
+        "WHERE hash       = ?1 "
+        "  AND compressed = ?2 "
+        "  AND data       = ?3 ") };
+    // clang-format on
+
+    selectQuery.bind(1, hash);
+    selectQuery.bind(2, static_cast<uint8_t>(codec));
+    selectQuery.bindBlob(3, data.data(), data.size(), false);
+    if (selectQuery.run()) {
+        return selectQuery.get<int64_t>(0);
+    }
+
+    // The row isn't referenced until the tile pointing to it is written; the
+    // triggers on `tiles` count the reference.
+
+    // clang-format off
+    mapbox::sqlite::Query insertQuery{ getStatement(
+        "INSERT INTO tile_data (hash, data, compressed) "
+        "VALUES                (?1,   ?2,   ?3) ") };
+    // clang-format on
+
+    insertQuery.bind(1, hash);
+    insertQuery.bindBlob(2, data.data(), data.size(), false);
+    insertQuery.bind(3, static_cast<uint8_t>(codec));
+    insertQuery.run();
+
+    return insertQuery.lastInsertRowId();
+}
+
 std::exception_ptr OfflineDatabase::invalidateAmbientCache() try {
     checkFlags();
 
@@ -872,12 +1144,14 @@ expected<OfflineRegions, std::exception_ptr> OfflineDatabase::mergeDatabase(cons
         return unexpected<std::exception_ptr>(std::current_exception());
     }
     try {
-        // Support sideloaded databases at user_version = 6. Future schema
-        // version changes will need to implement migration paths for sideloaded
+        // Support sideloaded databases at user_version = 6 or later. Version 7
+        // only added `region_checkpoints`, which isn't merged, and mergeTiles()
+        // reads the tile contents of both layouts. Future schema version
+        // changes will need to implement migration paths for sideloaded
         // databases at version 6.
         auto sideUserVersion = static_cast<int>(getPragma<int64_t>("PRAGMA side.user_version"));
         const auto mainUserVersion = getPragma<int64_t>("PRAGMA user_version");
-        if (sideUserVersion < 6 || sideUserVersion != mainUserVersion) {
+        if (sideUserVersion < 6 || sideUserVersion > mainUserVersion) {
             throw std::runtime_error("Merge database has incorrect user_version");
         }
 
@@ -905,6 +1179,7 @@ expected<OfflineRegions, std::exception_ptr> OfflineDatabase::mergeDatabase(cons
         queryTiles.reset();
 
         mapbox::sqlite::Transaction transaction(*db);
+        mergeTiles(sideUserVersion);
         db->exec(mergeSideloadedDatabaseSQL);
         transaction.commit();
 
@@ -935,6 +1210,59 @@ expected<OfflineRegions, std::exception_ptr> OfflineDatabase::mergeDatabase(cons
     return {};
 }
 
+// Inserts the region tiles of the attached side database that don't exist yet
+// in this database, or that are newer than the ones in it. The contents go
+// through putTileData() to share the rows of identical tiles; databases
+// before version 8 store them in `tiles` itself.
+void OfflineDatabase::mergeTiles(int64_t sideUserVersion) {
+    // clang-format off
+    mapbox::sqlite::Query query{ getStatement(sideUserVersion < 8 ?
+        //             0                1             2      3      4      5            6        7
+        "SELECT st.url_template, st.pixel_ratio, st.x, st.y, st.z, st.modified, st.etag, st.expires, "
+        //             8                 9        10
+        "       st.must_revalidate, st.data, st.compressed "
+        "FROM side.tiles st "
+        "LEFT JOIN tiles t ON st.url_template = t.url_template AND "
+            "st.pixel_ratio = t.pixel_ratio AND "
+            "st.z = t.z AND "
+            "st.x = t.x AND "
+            "st.y = t.y "
+        // only consider region tiles, and not ambient tiles.
+        "WHERE st.id IN (SELECT tile_id FROM side.region_tiles) "
+        "AND (t.id IS NULL OR st.modified > t.modified)" :
+        "SELECT st.url_template, st.pixel_ratio, st.x, st.y, st.z, st.modified, st.etag, st.expires, "
+        "       st.must_revalidate, sd.data, sd.compressed "
+        "FROM side.tiles st "
+        "LEFT JOIN side.tile_data sd ON sd.id = st.data_id "
+        "LEFT JOIN tiles t ON st.url_template = t.url_template AND "
+            "st.pixel_ratio = t.pixel_ratio AND "
+            "st.z = t.z AND "
+            "st.x = t.x AND "
+            "st.y = t.y "
+        "WHERE st.id IN (SELECT tile_id FROM side.region_tiles) "
+        "AND (t.id IS NULL OR st.modified > t.modified)") };
+    // clang-format on
+
+    while (query.run()) {
+        Resource::TileData tile;
+        tile.urlTemplate = query.get<std::string>(0);
+        tile.pixelRatio = static_cast<uint8_t>(query.get<int>(1));
+        tile.x = query.get<int>(2);
+        tile.y = query.get<int>(3);
+        tile.z = static_cast<int8_t>(query.get<int>(4));
+
+        Response response;
+        response.modified = query.get<std::optional<Timestamp>>(5);
+        response.etag = query.get<std::optional<std::string>>(6);
+        response.expires = query.get<std::optional<Timestamp>>(7);
+        response.mustRevalidate = query.get<bool>(8);
+
+        const std::optional<std::string> data = query.get<std::optional<std::string>>(9);
+        response.noContent = !data;
+        putTile(tile, response, data ? *data : std::string(), static_cast<OfflineCompression>(query.get<int>(10)));
+    }
+}
+
 expected<OfflineRegionMetadata, std::exception_ptr> OfflineDatabase::updateMetadata(
     const int64_t regionID, const OfflineRegionMetadata& metadata) try {
     checkFlags();
@@ -1006,9 +1334,9 @@ uint64_t OfflineDatabase::putRegionResource(int64_t regionID, const Resource& re
     return 0;
 }
 
-void OfflineDatabase::putRegionResources(int64_t regionID,
-                                         const std::list<std::tuple<Resource, Response>>& resources,
-                                         OfflineRegionStatus& status) try {
+std::vector<uint64_t> OfflineDatabase::putRegionResources(int64_t regionID,
+                                                          const std::list<std::tuple<Resource, Response>>& resources,
+                                                          OfflineRegionStatus& status) try {
     checkFlags();
 
     if (!db) {
@@ -1024,12 +1352,16 @@ void OfflineDatabase::putRegionResources(int64_t regionID,
     uint64_t completedTileCount = 0;
     uint64_t completedTileSize = 0;
 
+    std::vector<uint64_t> sizes;
+    sizes.reserve(resources.size());
+
     for (const auto& elem : resources) {
         const auto& resource = std::get<0>(elem);
         const auto& response = std::get<1>(elem);
 
         try {
             uint64_t resourceSize = putRegionResourceInternal(regionID, resource, response);
+            sizes.push_back(resourceSize);
             completedResourceCount++;
             completedResourceSize += resourceSize;
             if (resource.kind == Resource::Kind::Tile) {
@@ -1050,8 +1382,73 @@ void OfflineDatabase::putRegionResources(int64_t regionID,
     status.completedResourceSize += completedResourceSize;
     status.completedTileCount += completedTileCount;
     status.completedTileSize += completedTileSize;
+
+    return sizes;
 } catch (...) {
     handleError("write region resources");
+    return {};
+}
+
+OfflineTileCheckpoints OfflineDatabase::getRegionCheckpoints(int64_t regionID) try {
+    // clang-format off
+    mapbox::sqlite::Query query{ getStatement(
+        "SELECT url_template, min_zoom, max_zoom, scheme, position, tile_count, tile_size "
+        "FROM region_checkpoints "
+        "WHERE region_id = ?1 ") };
+    // clang-format on
+
+    query.bind(1, regionID);
+
+    OfflineTileCheckpoints result;
+    while (query.run()) {
+        OfflineTileCheckpoint checkpoint;
+        checkpoint.zoomRange = {static_cast<uint8_t>(query.get<int64_t>(1)),
+                                static_cast<uint8_t>(query.get<int64_t>(2))};
+        checkpoint.scheme = query.get<int64_t>(3) == static_cast<int64_t>(Tileset::Scheme::TMS)
+                                ? Tileset::Scheme::TMS
+                                : Tileset::Scheme::XYZ;
+        checkpoint.position = query.get<int64_t>(4);
+        checkpoint.tileCount = query.get<int64_t>(5);
+        checkpoint.tileSize = query.get<int64_t>(6);
+        result.emplace(query.get<std::string>(0), checkpoint);
+    }
+    return result;
+} catch (...) {
+    handleError("read region checkpoints");
+    return {};
+}
+
+void OfflineDatabase::putRegionCheckpoints(int64_t regionID, const OfflineTileCheckpoints& checkpoints) try {
+    checkFlags();
+
+    if (!db) {
+        initialize();
+    }
+    mapbox::sqlite::Transaction transaction(*db);
+
+    for (const auto& [urlTemplate, checkpoint] : checkpoints) {
+        // clang-format off
+        mapbox::sqlite::Query query{ getStatement(
+            "REPLACE INTO region_checkpoints (region_id, url_template, min_zoom, max_zoom, scheme, "
+            "                                 position, tile_count, tile_size) "
+            "VALUES                          (?1,        ?2,           ?3,       ?4,       ?5, "
+            "                                 ?6,       ?7,         ?8) ") };
+        // clang-format on
+
+        query.bind(1, regionID);
+        query.bind(2, urlTemplate);
+        query.bind(3, checkpoint.zoomRange.min);
+        query.bind(4, checkpoint.zoomRange.max);
+        query.bind(5, static_cast<int64_t>(checkpoint.scheme));
+        query.bind(6, static_cast<int64_t>(checkpoint.position));
+        query.bind(7, static_cast<int64_t>(checkpoint.tileCount));
+        query.bind(8, static_cast<int64_t>(checkpoint.tileSize));
+        query.run();
+    }
+
+    transaction.commit();
+} catch (...) {
+    handleError("write region checkpoints");
 }
 
 uint64_t OfflineDatabase::putRegionResourceInternal(int64_t regionID,
@@ -1199,10 +1596,11 @@ std::pair<int64_t, int64_t> OfflineDatabase::getCompletedResourceCountAndSize(in
 std::pair<int64_t, int64_t> OfflineDatabase::getCompletedTileCountAndSize(int64_t regionID) {
     // clang-format off
     mapbox::sqlite::Query query{ getStatement(
-        "SELECT COUNT(*), SUM(LENGTH(data)) "
-        "FROM region_tiles, tiles "
-        "WHERE region_id = ?1 "
-        "AND tile_id = tiles.id ") };
+        "SELECT COUNT(*), SUM(LENGTH(tile_data.data)) "
+        "FROM region_tiles "
+        "JOIN tiles ON tile_id = tiles.id "
+        "LEFT JOIN tile_data ON tile_data.id = data_id "
+        "WHERE region_id = ?1 ") };
     // clang-format on
     query.bind(1, regionID);
     query.run();
@@ -1309,8 +1707,7 @@ std::exception_ptr OfflineDatabase::initAmbientCacheSize() {
             mapbox::sqlite::Query query{ getStatement(
             "SELECT SUM(data) "
             "FROM ( "
-            "    SELECT SUM(IFNULL(LENGTH(data), 0) "
-            "               + IFNULL(LENGTH(id), 0) "
+            "    SELECT SUM(IFNULL(LENGTH(tiles.id), 0) "
             "               + IFNULL(LENGTH(url_template), 0) "
             "               + IFNULL(LENGTH(pixel_ratio), 0) "
             "               + IFNULL(LENGTH(x), 0) "
@@ -1319,7 +1716,7 @@ std::exception_ptr OfflineDatabase::initAmbientCacheSize() {
             "               + IFNULL(LENGTH(expires), 0) "
             "               + IFNULL(LENGTH(modified), 0) "
             "               + IFNULL(LENGTH(etag), 0) "
-            "               + IFNULL(LENGTH(compressed), 0) "
+            "               + IFNULL(LENGTH(data_id), 0) "
             "               + IFNULL(LENGTH(accessed), 0) "
             "               + IFNULL(LENGTH(must_revalidate), 0) "
             "               ) as data "
@@ -1328,6 +1725,21 @@ std::exception_ptr OfflineDatabase::initAmbientCacheSize() {
             "    ON tile_id = tiles.id "
             "    WHERE tile_id IS NULL "
             "  UNION ALL "
+            // Contents shared by several tiles are stored, and counted, once
+            "    SELECT SUM(IFNULL(LENGTH(data), 0) "
+            "               + IFNULL(LENGTH(id), 0) "
+            "               + IFNULL(LENGTH(hash), 0) "
+            "               + IFNULL(LENGTH(compressed), 0) "
+            "               + IFNULL(LENGTH(ref_count), 0) "
+            "               ) as data "
+            "    FROM tile_data "
+            "    WHERE id IN ( "
+            "      SELECT data_id FROM tiles "
+            "      LEFT JOIN region_tiles "
+            "      ON tile_id = tiles.id "
+            "      WHERE tile_id IS NULL "
+            "    ) "
+            "  UNION ALL "
             "    SELECT SUM(IFNULL(LENGTH(data), 0) "
             "               + IFNULL(LENGTH(id), 0) "
             "               + IFNULL(LENGTH(url), 0) "
@@ -1441,6 +1853,11 @@ void OfflineDatabase::markUsedResources(int64_t regionID, const std::list<Resour
 std::exception_ptr OfflineDatabase::pack() try {
     if (!db) initialize();
     vacuum();
+    if (journalMode == OfflineJournalMode::WAL) {
+        // Copies the vacuumed pages back and empties the log, once the readers
+        // are done with what they're reading.
+        db->exec("PRAGMA wal_checkpoint(TRUNCATE)");
+    }
     return nullptr;
 } catch (...) {
     handleError("pack storage");
@@ -1456,6 +1873,24 @@ std::exception_ptr OfflineDatabase::resetDatabase() try {
     return std::current_exception();
 }
 
+void OfflineDatabase::setJournalMode(OfflineJournalMode journalMode_) try {
+    journalMode = journalMode_;
+    if (db && !readOnly) {
+        applyJournalMode();
+    }
+} catch (...) {
+    handleError("set journal mode");
+}
+
+void OfflineDatabase::setWALCheckpointPages(uint32_t pages) try {
+    walCheckpointPages = pages;
+    if (db && !readOnly) {
+        applyJournalMode();
+    }
+} catch (...) {
+    handleError("set journal mode");
+}
+
 void OfflineDatabase::reopenDatabaseReadOnly(bool readOnly_) {
     if (readOnly == readOnly_) return;
     try {
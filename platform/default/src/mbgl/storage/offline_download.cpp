@@ -18,6 +18,9 @@
 #include <mbgl/util/tile_cover.hpp>
 #include <mbgl/util/tileset.hpp>
 
+#include <algorithm>
+#include <limits>
+#include <map>
 #include <set>
 
 namespace {
@@ -25,6 +28,16 @@ namespace {
 const size_t kResourcesBatchSize = 64;
 const size_t kMarkBatchSize = 200;
 
+// The request window starts small and grows with every completed request
+// (doubling per round trip until the first back-off, linearly afterwards),
+// like a TCP congestion window.
+const double kInitialRequestWindow = 2;
+
+// Latencies this many times the lowest observed latency, plus some slack to
+// ignore jitter, suggest that requests are queueing up along the way.
+const int kLatencyBackoffFactor = 4;
+const mbgl::Duration kLatencySlack = std::chrono::milliseconds(100);
+
 } // namespace
 
 namespace mbgl {
@@ -48,29 +61,6 @@ Range<uint8_t> coveringZoomRange(const RegionDefinition& definition,
     return {static_cast<uint8_t>(minZ), static_cast<uint8_t>(maxZ)};
 }
 
-template <class Geometry, class Fn>
-void tileCover(const Geometry& geometry, uint8_t z, Fn&& fn) {
-    util::TileCover cover(geometry, z);
-    while (cover.hasNext()) {
-        fn(cover.next()->canonical);
-    }
-}
-
-template <class Fn>
-void tileCover(const OfflineRegionDefinition& definition,
-               style::SourceType type,
-               uint16_t tileSize,
-               const Range<uint8_t>& zoomRange,
-               Fn&& fn) {
-    const Range<uint8_t> clampedZoomRange = definition.match(
-        [&](auto& reg) { return coveringZoomRange(reg, type, tileSize, zoomRange); });
-
-    for (uint8_t z = clampedZoomRange.min; z <= clampedZoomRange.max; z++) {
-        definition.match([&](const OfflineTilePyramidRegionDefinition& reg) { tileCover(reg.bounds, z, fn); },
-                         [&](const OfflineGeometryRegionDefinition& reg) { tileCover(reg.geometry, z, fn); });
-    }
-}
-
 uint64_t tileCount(const OfflineRegionDefinition& definition,
                    style::SourceType type,
                    uint16_t tileSize,
@@ -88,6 +78,47 @@ uint64_t tileCount(const OfflineRegionDefinition& definition,
     return result;
 }
 
+// Streams the tile cover of a tiled source, so that only the tiles being
+// requested are held in memory, and keeps track of the tiles that are done for
+// the checkpoint.
+struct OfflineDownload::TileCursor {
+    TileCursor(const OfflineRegionDefinition& definition,
+               Tileset tileset_,
+               const Range<uint8_t>& zoomRange,
+               uint64_t position)
+        : tileset(std::move(tileset_)),
+          tiles(definition.match(
+              [&](const OfflineTilePyramidRegionDefinition& reg) {
+                  return std::make_unique<util::TileCoverIterator>(
+                      reg.bounds, zoomRange, util::TileCoverIterator::Cursor{position});
+              },
+              [&](const OfflineGeometryRegionDefinition& reg) {
+                  return std::make_unique<util::TileCoverIterator>(
+                      reg.geometry, zoomRange, util::TileCoverIterator::Cursor{position});
+              })) {}
+
+    bool hasNext() { return tiles->hasNext(); }
+    uint64_t nextIndex() const { return tiles->cursor().position; }
+    CanonicalTileID next() { return tiles->next()->canonical; }
+
+    const Tileset tileset;
+    const std::unique_ptr<util::TileCoverIterator> tiles;
+
+    // Only the first cursor of a URL template keeps a checkpoint.
+    bool checkpointed = false;
+    OfflineTileCheckpoint checkpoint;
+    uint64_t savedPosition = 0;
+
+    // Tiles past the checkpoint that are done, with their stored size, or
+    // nothing if they don't exist on the server.
+    std::map<uint64_t, std::optional<uint64_t>> finished;
+
+    // Set once the checkpoint reaches a tile that doesn't exist on the server.
+    // The checkpoint only passes stored tiles, so that the next download
+    // requests the missing one again, and stays there.
+    bool checkpointStopped = false;
+};
+
 // OfflineDownload
 
 OfflineDownload::OfflineDownload(int64_t id_,
@@ -97,7 +128,9 @@ OfflineDownload::OfflineDownload(int64_t id_,
     : id(id_),
       definition(std::move(definition_)),
       offlineDatabase(offlineDatabase_),
-      onlineFileSource(onlineFileSource_) {
+      onlineFileSource(onlineFileSource_),
+      requestWindow(kInitialRequestWindow),
+      requestWindowThreshold(std::numeric_limits<double>::max()) {
     setObserver(nullptr);
 }
 
@@ -235,6 +268,11 @@ void OfflineDownload::activateDownload() {
     status.downloadState = OfflineRegionDownloadState::Active;
     status.requiredResourceCount++;
 
+    requestWindow = kInitialRequestWindow;
+    requestWindowThreshold = std::numeric_limits<double>::max();
+    minimumLatency = Duration::zero();
+    checkpoints = offlineDatabase.getRegionCheckpoints(id);
+
     auto styleResource = Resource::style(definition.match([](auto& reg) { return reg.styleURL; }));
     styleResource.setPriority(Resource::Priority::Low);
     styleResource.setUsage(Resource::Usage::Offline);
@@ -373,29 +411,104 @@ void OfflineDownload::activateDownload() {
    is unreachable, all the requests to that host are going to error. In that
    case, continuing to try subsequent resources after the first few errors is
    fruitless anyway.
+
+   Below the file source's maximum number of concurrent requests, the requests
+   that aren't waiting to be retried are further limited by the request window,
+   which adapts to the observed latencies and errors. Tiles are taken from the
+   tile cursors once all other resources are requested.
 */
 void OfflineDownload::continueDownload() {
-    if (resourcesRemaining.empty()) {
+    if (!hasRemainingResources()) {
         // Flush pending buffers.
         if (!flushResourcesBuffer()) return;
         if (status.complete()) {
             markPendingUsedResources();
+            saveCheckpoints();
             setState(OfflineRegionDownloadState::Inactive);
             return;
         }
     }
 
-    if (resourcesToBeMarkedAsUsed.size() >= kMarkBatchSize) markPendingUsedResources();
+    if (resourcesToBeMarkedAsUsed.size() >= kMarkBatchSize) {
+        markPendingUsedResources();
+        saveCheckpoints();
+    }
+
+    const uint32_t maxConcurrentRequests = maximumConcurrentRequests();
+    const auto windowSize = std::max<size_t>(1, static_cast<size_t>(requestWindow));
+    const auto pipelineFull = [&] {
+        return requests.size() >= maxConcurrentRequests || requests.size() - retryingRequests >= windowSize;
+    };
 
+    while (!resourcesRemaining.empty() && !pipelineFull()) {
+        ensureResource(std::move(resourcesRemaining.front()));
+        resourcesRemaining.pop_front();
+    }
+
+    for (auto it = tileCursors.begin(); it != tileCursors.end() && !pipelineFull();) {
+        TileCursor& cursor = **it;
+        if (!cursor.hasNext()) {
+            ++it;
+            continue;
+        }
+
+        const TileSlot slot{&cursor, cursor.nextIndex()};
+        const CanonicalTileID tile = cursor.next();
+        auto tileResource = Resource::tile(cursor.tileset.tiles[0],
+                                           definition.match([](auto& def) { return def.pixelRatio; }),
+                                           tile.x,
+                                           tile.y,
+                                           tile.z,
+                                           cursor.tileset.scheme);
+
+        tileResource.setPriority(Resource::Priority::Low);
+        tileResource.setUsage(Resource::Usage::Offline);
+
+        ensureResource(std::move(tileResource), {}, slot);
+    }
+}
+
+bool OfflineDownload::hasRemainingResources() {
+    return !resourcesRemaining.empty() ||
+           std::any_of(tileCursors.begin(), tileCursors.end(), [](const auto& cursor) { return cursor->hasNext(); });
+}
+
+uint32_t OfflineDownload::maximumConcurrentRequests() {
     uint32_t maxConcurrentRequests = util::DEFAULT_MAXIMUM_CONCURRENT_REQUESTS;
     auto value = onlineFileSource.getProperty(MAX_CONCURRENT_REQUESTS_KEY);
     if (uint64_t* maxRequests = value.getUint()) {
         maxConcurrentRequests = static_cast<uint32_t>(*maxRequests);
     }
+    return maxConcurrentRequests;
+}
 
-    while (!resourcesRemaining.empty() && requests.size() < maxConcurrentRequests) {
-        ensureResource(std::move(resourcesRemaining.front()));
-        resourcesRemaining.pop_front();
+void OfflineDownload::onRequestCompleted(Duration latency) {
+    if (minimumLatency == Duration::zero() || latency < minimumLatency) {
+        minimumLatency = latency;
+    }
+
+    const auto now = Clock::now();
+    if (latency > minimumLatency * kLatencyBackoffFactor + kLatencySlack) {
+        // Back off at most once per round trip, as the requests that are
+        // already in flight were issued before the previous back-off.
+        if (now - lastWindowDecrease > latency) {
+            requestWindow = std::max(1.0, requestWindow * 0.75);
+            requestWindowThreshold = requestWindow;
+            lastWindowDecrease = now;
+        }
+        return;
+    }
+
+    requestWindow += requestWindow < requestWindowThreshold ? 1.0 : 1.0 / requestWindow;
+    requestWindow = std::min(requestWindow, static_cast<double>(maximumConcurrentRequests()));
+}
+
+void OfflineDownload::onRequestFailed() {
+    const auto now = Clock::now();
+    if (now - lastWindowDecrease > minimumLatency) {
+        requestWindow = std::max(1.0, requestWindow / 2);
+        requestWindowThreshold = requestWindow;
+        lastWindowDecrease = now;
     }
 }
 
@@ -403,15 +516,26 @@ void OfflineDownload::deactivateDownload() {
     requiredSourceURLs.clear();
     resourcesRemaining.clear();
     requests.clear();
+    retryingRequests = 0;
     buffer.clear();
+    bufferSlots.clear();
+    tileCursors.clear();
 }
 
 bool OfflineDownload::flushResourcesBuffer() {
     if (buffer.empty()) return true;
     try {
-        offlineDatabase.putRegionResources(id, buffer, status);
+        const std::vector<uint64_t> sizes = offlineDatabase.putRegionResources(id, buffer, status);
+        if (sizes.size() == bufferSlots.size()) {
+            auto size = sizes.begin();
+            for (const auto& slot : bufferSlots) {
+                finishTile(slot, *size++);
+            }
+        }
         buffer.clear();
+        bufferSlots.clear();
         observer->statusChanged(status);
+        saveCheckpoints();
         return true;
     } catch (const MapboxTileLimitExceededException&) {
         onMapboxTileCountLimitExceeded();
@@ -430,22 +554,43 @@ void OfflineDownload::queueResource(Resource&& resource) {
 }
 
 void OfflineDownload::queueTiles(SourceType type, uint16_t tileSize, const Tileset& tileset) {
-    tileCover(definition, type, tileSize, tileset.zoomRange, [&](const auto& tile) {
-        status.requiredResourceCount++;
-        status.requiredTileCount++;
-
-        auto tileResource = Resource::tile(tileset.tiles[0],
-                                           definition.match([](auto& def) { return def.pixelRatio; }),
-                                           tile.x,
-                                           tile.y,
-                                           tile.z,
-                                           tileset.scheme);
+    const uint64_t count = tileCount(definition, type, tileSize, tileset.zoomRange);
+    status.requiredResourceCount += count;
+    status.requiredTileCount += count;
 
-        tileResource.setPriority(Resource::Priority::Low);
-        tileResource.setUsage(Resource::Usage::Offline);
+    const Range<uint8_t> zoomRange = definition.match(
+        [&](auto& reg) { return coveringZoomRange(reg, type, tileSize, tileset.zoomRange); });
 
-        resourcesRemaining.push_back(std::move(tileResource));
+    const std::string& urlTemplate = tileset.tiles[0];
+    const bool checkpointed = std::none_of(tileCursors.begin(), tileCursors.end(), [&](const auto& other) {
+        return other->tileset.tiles[0] == urlTemplate;
     });
+
+    // Resume after the tiles that a previous download already stored, without
+    // looking them up in the database again. A checkpoint for another cover,
+    // after the source's zoom levels, tile size or scheme changed, is discarded,
+    // as is one that passed tiles missing on the server, which are requested again.
+    OfflineTileCheckpoint checkpoint;
+    checkpoint.zoomRange = zoomRange;
+    checkpoint.scheme = tileset.scheme;
+    auto it = checkpoints.find(urlTemplate);
+    if (checkpointed && it != checkpoints.end() && it->second.zoomRange == zoomRange &&
+        it->second.scheme == tileset.scheme && it->second.position <= count &&
+        it->second.tileCount == it->second.position) {
+        checkpoint = it->second;
+
+        status.completedResourceCount += checkpoint.tileCount;
+        status.completedResourceSize += checkpoint.tileSize;
+        status.completedTileCount += checkpoint.tileCount;
+        status.completedTileSize += checkpoint.tileSize;
+    }
+
+    auto cursor = std::make_unique<TileCursor>(definition, tileset, zoomRange, checkpoint.position);
+    cursor->checkpointed = checkpointed;
+    cursor->checkpoint = checkpoint;
+    cursor->savedPosition = checkpoint.position;
+
+    tileCursors.push_back(std::move(cursor));
 }
 
 void OfflineDownload::markPendingUsedResources() {
@@ -453,7 +598,44 @@ void OfflineDownload::markPendingUsedResources() {
     resourcesToBeMarkedAsUsed.clear();
 }
 
-void OfflineDownload::ensureResource(Resource&& resource, std::function<void(Response)> callback) {
+void OfflineDownload::finishTile(const TileSlot& slot, std::optional<uint64_t> storedSize) {
+    if (!slot.cursor) return;
+
+    TileCursor& cursor = *slot.cursor;
+    if (cursor.checkpointStopped) return;
+    cursor.finished.emplace(slot.index, storedSize);
+
+    auto it = cursor.finished.begin();
+    for (; it != cursor.finished.end() && it->first == cursor.checkpoint.position; ++it) {
+        if (!it->second) {
+            cursor.checkpointStopped = true;
+            cursor.finished.clear();
+            return;
+        }
+        cursor.checkpoint.position++;
+        cursor.checkpoint.tileCount++;
+        cursor.checkpoint.tileSize += *it->second;
+    }
+    cursor.finished.erase(cursor.finished.begin(), it);
+}
+
+void OfflineDownload::saveCheckpoints() {
+    OfflineTileCheckpoints progress;
+    for (const auto& cursor : tileCursors) {
+        if (cursor->checkpointed && cursor->checkpoint.position > cursor->savedPosition) {
+            progress.emplace(cursor->tileset.tiles[0], cursor->checkpoint);
+            cursor->savedPosition = cursor->checkpoint.position;
+        }
+    }
+    if (progress.empty()) return;
+
+    // Tiles found in the database count as done, so they must be marked as
+    // used by this region before the checkpoint passes them.
+    if (!resourcesToBeMarkedAsUsed.empty()) markPendingUsedResources();
+    offlineDatabase.putRegionCheckpoints(id, progress);
+}
+
+void OfflineDownload::ensureResource(Resource&& resource, std::function<void(Response)> callback, TileSlot slot) {
     assert(resource.priority == Resource::Priority::Low);
     assert(resource.usage == Resource::Usage::Offline);
 
@@ -486,6 +668,7 @@ void OfflineDownload::ensureResource(Resource&& resource, std::function<void(Res
                 status.completedTileCount += 1;
                 status.completedTileSize += *offlineResponse;
             }
+            finishTile(slot, static_cast<uint64_t>(*offlineResponse));
 
             observer->statusChanged(status);
             continueDownload();
@@ -497,21 +680,40 @@ void OfflineDownload::ensureResource(Resource&& resource, std::function<void(Res
             return;
         }
 
+        const auto started = Clock::now();
+        auto retrying = std::make_shared<bool>(false);
         auto fileRequestsIt = requests.insert(requests.begin(), nullptr);
         *fileRequestsIt = onlineFileSource.request(resource, [=](const Response& onlineResponse) {
+            auto finishRequest = [&] {
+                if (*retrying) {
+                    retryingRequests--;
+                } else {
+                    onRequestCompleted(Clock::now() - started);
+                }
+                requests.erase(fileRequestsIt);
+            };
+
             if (onlineResponse.error) {
                 observer->responseError(*onlineResponse.error);
                 if (onlineResponse.error->reason == Response::Error::Reason::NotFound) {
                     // On error 404, we skip this request and go further.
-                    requests.erase(fileRequestsIt);
+                    finishRequest();
                     assert(status.requiredResourceCount > 0);
                     status.requiredResourceCount--;
+                    finishTile(slot, std::nullopt);
                     continueDownload();
+                } else {
+                    // The request is retried; it no longer counts against the request window.
+                    if (!*retrying) {
+                        *retrying = true;
+                        retryingRequests++;
+                    }
+                    onRequestFailed();
                 }
                 return;
             }
 
-            requests.erase(fileRequestsIt);
+            finishRequest();
 
             if (callback) {
                 callback(onlineResponse);
@@ -519,12 +721,13 @@ void OfflineDownload::ensureResource(Resource&& resource, std::function<void(Res
 
             // Queue up for batched insertion
             buffer.emplace_back(resource, onlineResponse);
+            bufferSlots.push_back(slot);
 
             // Flush buffer periodically.
-            // Have to keep `resourcesRemaining.empty()` as the following
+            // Have to keep `hasRemainingResources()` as the following
             // condition would fail otherwise.
             // TODO: Simplify the tile count limit check code path!
-            if ((buffer.size() == kResourcesBatchSize || resourcesRemaining.empty()) && !flushResourcesBuffer()) return;
+            if ((buffer.size() == kResourcesBatchSize || !hasRemainingResources()) && !flushResourcesBuffer()) return;
 
             if (offlineDatabase.exceedsOfflineMapboxTileCountLimit(resource)) {
                 onMapboxTileCountLimitExceeded();
@@ -25,9 +25,10 @@
 
 #include <algorithm>
 #include <cassert>
-#include <list>
 #include <map>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 namespace mbgl {
 
@@ -50,6 +51,7 @@ struct OnlineFileRequest {
     void setTransformedURL(const std::string& url);
     ActorRef<OnlineFileRequest> actor();
     void onCancel(std::function<void()>);
+    void setPriority(Resource::Priority);
 
     Duration getUpdateInterval(std::optional<Timestamp> expires) const;
     OnlineFileSourceThread& impl;
@@ -92,6 +94,13 @@ public:
         tasks[req] = std::make_unique<OnlineFileRequest>(std::move(resource), std::move(callback), *this);
     }
 
+    void setPriority(AsyncRequest* req, Resource::Priority priority) {
+        auto it = tasks.find(req);
+        if (it != tasks.end()) {
+            it->second->setPriority(priority);
+        }
+    }
+
     void cancel(AsyncRequest* req) {
         auto it = tasks.find(req);
         assert(it != tasks.end());
@@ -167,6 +176,8 @@ public:
 
     bool isPending(OnlineFileRequest* req) { return pendingRequests.contains(req); }
 
+    void updatePendingRequest(OnlineFileRequest* req) { pendingRequests.update(req); }
+
     bool isActive(OnlineFileRequest* req) { return activeRequests.find(req) != activeRequests.end(); }
 
     void setResourceTransform(ResourceTransform transform) { resourceTransform = std::move(transform); }
@@ -205,60 +216,54 @@ private:
     friend struct OnlineFileRequest;
 
     void networkIsReachableAgain() {
-        // Notify regular priority requests.
-        for (auto& req : allRequests) {
-            if (req->resource.priority == Resource::Priority::Regular) {
-                req->networkIsReachableAgain();
-            }
-        }
-
-        // Notify low priority requests.
-        for (auto& req : allRequests) {
-            if (req->resource.priority == Resource::Priority::Low) {
-                req->networkIsReachableAgain();
-            }
+        // Notify requests in priority order, so that the ones that matter most
+        // are the first to get back into the queue.
+        std::vector<OnlineFileRequest*> requests(allRequests.begin(), allRequests.end());
+        std::stable_sort(requests.begin(), requests.end(), [](const auto* a, const auto* b) {
+            return a->resource.priority < b->resource.priority;
+        });
+        for (auto* req : requests) {
+            req->networkIsReachableAgain();
         }
     }
 
-    // Using Pending Requests as an priority queue which processes
-    // file requests in a FIFO manner but prefers regular requests
-    // over offline requests with a low priority such that low priority
-    // requests do not throttle regular requests.
+    // Pending requests are kept in a priority queue which processes file
+    // requests in a FIFO manner among requests of the same priority, but
+    // prefers requests with a higher priority, such that e.g. low priority
+    // offline requests do not throttle tiles that are on screen.
     //
-    // The order of a queue is therefore:
-    //
-    // hi0 -- hi1 -- hi2 -- hi3 -- lo0 -- lo1 --lo2
-    //                              ^
-    //                              firstLowPriorityRequest
-
+    // A request keeps its place in line when its priority is changed, so that
+    // requests aren't starved by repeatedly changing the priority of others.
     struct PendingRequests {
-        PendingRequests()
-            : firstLowPriorityRequest(queue.begin()) {}
+        using Key = std::pair<Resource::Priority, uint64_t>;
 
-        std::list<OnlineFileRequest*> queue;
-        std::list<OnlineFileRequest*>::iterator firstLowPriorityRequest;
+        std::map<Key, OnlineFileRequest*> queue;
+        std::unordered_map<const OnlineFileRequest*, Key> keys;
+        uint64_t sequence = 0;
 
         void remove(const OnlineFileRequest* request) {
-            auto it = std::find(queue.begin(), queue.end(), request);
-            if (it != queue.end()) {
-                if (it == firstLowPriorityRequest) {
-                    firstLowPriorityRequest++;
-                }
-                queue.erase(it);
+            auto it = keys.find(request);
+            if (it != keys.end()) {
+                queue.erase(it->second);
+                keys.erase(it);
             }
         }
 
         void insert(OnlineFileRequest* request) {
-            if (request->resource.priority == Resource::Priority::Regular) {
-                firstLowPriorityRequest = queue.insert(firstLowPriorityRequest, request);
-                firstLowPriorityRequest++;
-            } else {
-                if (firstLowPriorityRequest == queue.end()) {
-                    firstLowPriorityRequest = queue.insert(queue.end(), request);
-                } else {
-                    queue.insert(queue.end(), request);
-                }
+            const Key key{request->resource.priority, sequence++};
+            queue.emplace(key, request);
+            keys.insert_or_assign(request, key);
+        }
+
+        // Moves a pending request to the position matching its current priority.
+        void update(OnlineFileRequest* request) {
+            auto it = keys.find(request);
+            if (it == keys.end() || it->second.first == request->resource.priority) {
+                return;
             }
+            queue.erase(it->second);
+            it->second.first = request->resource.priority;
+            queue.emplace(it->second, request);
         }
 
         std::optional<OnlineFileRequest*> pop() {
@@ -266,18 +271,13 @@ private:
                 return {};
             }
 
-            if (queue.begin() == firstLowPriorityRequest) {
-                firstLowPriorityRequest++;
-            }
-
-            OnlineFileRequest* next = queue.front();
-            queue.pop_front();
+            OnlineFileRequest* next = queue.begin()->second;
+            queue.erase(queue.begin());
+            keys.erase(next);
             return {next};
         }
 
-        bool contains(OnlineFileRequest* request) const {
-            return (std::find(queue.begin(), queue.end(), request) != queue.end());
-        }
+        bool contains(OnlineFileRequest* request) const { return keys.find(request) != keys.end(); }
     };
 
     ResourceTransform resourceTransform;
@@ -324,6 +324,9 @@ public:
         auto req = std::make_unique<FileSourceRequest>(std::move(callback));
         req->onCancel(
             [actorRef = thread->actor(), req = req.get()]() { actorRef.invoke(&OnlineFileSourceThread::cancel, req); });
+        req->onPriorityChange([actorRef = thread->actor(), req = req.get()](Resource::Priority priority) {
+            actorRef.invoke(&OnlineFileSourceThread::setPriority, req, priority);
+        });
         thread->actor().invoke(&OnlineFileSourceThread::request, req.get(), std::move(res), req->actor());
         return req;
     }
@@ -611,6 +614,19 @@ void OnlineFileRequest::onCancel(std::function<void()> callback_) {
     cancelCallback = std::move(callback_);
 }
 
+void OnlineFileRequest::setPriority(Resource::Priority priority) {
+    if (resource.priority == priority) {
+        return;
+    }
+
+    resource.priority = priority;
+    if (impl.isPending(this)) {
+        impl.updatePendingRequest(this);
+    } else if (request) {
+        request->setPriority(priority);
+    }
+}
+
 OnlineFileSource::OnlineFileSource(const ResourceOptions& resourceOptions, const ClientOptions& clientOptions)
     : impl(std::make_unique<Impl>(resourceOptions, clientOptions)) {}
 
@@ -71,6 +71,9 @@ public:
     /// Called when the app receives a memory warning and before it goes to the background.
     virtual void reduceMemoryUsage() = 0;
 
+    /// Persist compiled shader programs to the given file, on backends that support it.
+    virtual void setProgramCachePath(const std::string&) {}
+
     virtual std::unique_ptr<OffscreenTexture> createOffscreenTexture(Size, TextureChannelDataType) = 0;
 
     /// Creates an empty texture with the specified dimensions.
@@ -1,7 +1,9 @@
 #include <mbgl/gfx/drawable_builder.hpp>
 
 #include <mbgl/gfx/drawable_builder_impl.hpp>
+#include <mbgl/gfx/drawable_geometry.hpp>
 #include <mbgl/gfx/drawable_impl.hpp>
+#include <mbgl/gfx/context.hpp>
 #include <mbgl/gfx/vertex_attribute.hpp>
 #include <mbgl/renderer/render_pass.hpp>
 #include <mbgl/util/logging.hpp>
@@ -268,7 +270,61 @@ void DrawableBuilder::addPolyline(const GeometryCoordinates& coordinates,
     if (!impl->checkAndSetMode(Impl::Mode::Polylines)) return;
 
     // append polyline
-    impl->addPolyline(*this, coordinates, options);
+    impl->polylines.add(coordinates, options);
+}
+
+void DrawableBuilder::setPolylineGeometry(gfx::Context& context, const PolylineGeometry& geometry) {
+    if (geometry.empty()) {
+        return;
+    }
+
+    static const StringIdentity idVertexAttribName = stringIndexer().get("a_pos_normal");
+    static const StringIdentity idDataAttribName = stringIndexer().get("a_data");
+
+    setVertexAttrNameId(idVertexAttribName);
+    setRawVertices({}, geometry.vertices->elements(), gfx::AttributeDataType::Short2);
+
+    auto attrs = context.createVertexAttributeArray();
+    if (const auto& attr = attrs->add(idVertexAttribName)) {
+        attr->setSharedRawData(geometry.vertices,
+                               offsetof(LineLayoutVertex, a1),
+                               /*vertexOffset=*/0,
+                               sizeof(LineLayoutVertex),
+                               gfx::AttributeDataType::Short2);
+    }
+    if (const auto& attr = attrs->add(idDataAttribName)) {
+        attr->setSharedRawData(geometry.vertices,
+                               offsetof(LineLayoutVertex, a2),
+                               /*vertexOffset=*/0,
+                               sizeof(LineLayoutVertex),
+                               gfx::AttributeDataType::UByte4);
+    }
+    setVertexAttributes(std::move(attrs));
+
+    setSegments(gfx::Triangles(), geometry.indexes, geometry.segments.data(), geometry.segments.size());
+}
+
+void DrawableBuilder::setFillGeometry(gfx::Context& context, const FillGeometry& geometry) {
+    if (geometry.empty()) {
+        return;
+    }
+
+    static const StringIdentity idVertexAttribName = stringIndexer().get("a_pos");
+
+    setVertexAttrNameId(idVertexAttribName);
+    setRawVertices({}, geometry.vertices->elements(), gfx::AttributeDataType::Short2);
+
+    auto attrs = context.createVertexAttributeArray();
+    if (const auto& attr = attrs->add(idVertexAttribName)) {
+        attr->setSharedRawData(geometry.vertices,
+                               offsetof(FillLayoutVertex, a1),
+                               /*vertexOffset=*/0,
+                               sizeof(FillLayoutVertex),
+                               gfx::AttributeDataType::Short2);
+    }
+    setVertexAttributes(std::move(attrs));
+
+    setSegments(gfx::Triangles(), geometry.indexes, geometry.segments.data(), geometry.segments.size());
 }
 
 } // namespace gfx
@@ -6,7 +6,7 @@
 #include <mbgl/gfx/vertex_vector.hpp>
 #include <mbgl/programs/segment.hpp>
 #include <mbgl/gfx/drawable_builder.hpp>
-#include <mbgl/gfx/polyline_generator.hpp>
+#include <mbgl/gfx/drawable_geometry.hpp>
 
 #include <cstdint>
 #include <cstddef>
@@ -25,19 +25,13 @@ public:
         Polylines,  ///< building drawables for thick polylines
         Custom      ///< building custom drawables.
     };
-    struct LineLayoutVertex {
-        std::array<int16_t, 2> a1;
-        std::array<uint8_t, 4> a2;
-    };
-
 public:
     gfx::VertexVector<VT> vertices;
 
     std::vector<uint8_t> rawVertices;
     std::size_t rawVerticesCount = 0;
 
-    gfx::VertexVector<LineLayoutVertex> polylineVertices;
-    gfx::IndexVector<gfx::Triangles> polylineIndexes;
+    gfx::PolylineGeometry polylines;
 
     std::vector<uint16_t> buildIndexes;
     std::shared_ptr<gfx::IndexVectorBase> sharedIndexes;
@@ -47,10 +41,6 @@ public:
     gfx::ColorMode colorMode = gfx::ColorMode::disabled();
     gfx::CullFaceMode cullFaceMode = gfx::CullFaceMode::disabled();
 
-    void addPolyline(gfx::DrawableBuilder& builder,
-                     const GeometryCoordinates& coordinates,
-                     const gfx::PolylineGeneratorOptions& options);
-
     void setupForPolylines(gfx::Context&, gfx::DrawableBuilder&);
 
     bool checkAndSetMode(Mode);
@@ -60,23 +50,19 @@ public:
     bool setMode(Mode value) { return mode == value; };
 
     std::size_t vertexCount() const {
-        return std::max(rawVerticesCount, std::max(vertices.elements(), polylineVertices.elements()));
+        return std::max(rawVerticesCount, std::max(vertices.elements(), polylines.vertices->elements()));
     }
 
     void clear() {
         vertices.clear();
         rawVertices.clear();
         rawVerticesCount = 0;
-        polylineVertices.clear();
-        polylineIndexes.clear();
+        polylines = {};
         buildIndexes.clear();
         segments.clear();
     }
 
 private:
-    LineLayoutVertex layoutVertex(
-        Point<int16_t> p, Point<double> e, bool round, bool up, int8_t dir, int32_t linesofar = 0);
-
     Mode mode{Mode::Custom};
 };
 
@@ -0,0 +1,25 @@
+#include <mbgl/gfx/drawable_geometry.hpp>
+#include <mbgl/gfx/fill_generator.hpp>
+
+namespace mbgl {
+namespace gfx {
+
+void PolylineGeometry::add(const GeometryCoordinates& coordinates, const PolylineGeneratorOptions& options) {
+    PolylineGenerator<LineLayoutVertex, Segment<LineAttributes>> generator(
+        *vertices,
+        LineProgram::layoutVertex,
+        segments,
+        [](std::size_t vertexOffset, std::size_t indexOffset) -> Segment<LineAttributes> {
+            return Segment<LineAttributes>(vertexOffset, indexOffset);
+        },
+        [](auto& seg) -> Segment<LineAttributes>& { return seg; },
+        *indexes);
+    generator.generate(coordinates, options);
+}
+
+void FillGeometry::add(const GeometryCollection& geometry) {
+    generateFillBuffers(geometry, *vertices, *indexes, segments);
+}
+
+} // namespace gfx
+} // namespace mbgl
@@ -15,11 +15,13 @@ bool RenderingStats::isZero() const {
                                 numIndexBuffers,
                                 numUniformBuffers,
                                 numFrameBuffers,
+                                numBufferSlabs,
                                 memTextures,
                                 memBuffers,
                                 memIndexBuffers,
                                 memVertexBuffers,
-                                memUniformBuffers};
+                                memUniformBuffers,
+                                memBufferSlabs};
     return std::all_of(expectedZeros.begin(), expectedZeros.end(), [](auto x) { return x == 0; });
 }
 
@@ -27,6 +29,9 @@ RenderingStats& RenderingStats::operator+=(const RenderingStats& r) {
     numFrames += r.numFrames;
     numDrawCalls += r.numDrawCalls;
     totalDrawCalls += r.totalDrawCalls;
+    numCulledDrawables += r.numCulledDrawables;
+    numElidedBinds += r.numElidedBinds;
+    numLinkedPrograms += r.numLinkedPrograms;
     numCreatedTextures += r.numCreatedTextures;
     numActiveTextures += r.numActiveTextures;
     numTextureBindings += r.numTextureBindings;
@@ -43,14 +48,17 @@ RenderingStats& RenderingStats::operator+=(const RenderingStats& r) {
     indexUpdateBytes += r.indexUpdateBytes;
     numVertexBuffers += r.numVertexBuffers;
     vertexUpdateBytes += r.vertexUpdateBytes;
+    numBufferSlabs += r.numBufferSlabs;
     numUniformBuffers += r.numUniformBuffers;
     numUniformUpdates += r.numUniformUpdates;
+    numUniformUploads += r.numUniformUploads;
     uniformUpdateBytes += r.uniformUpdateBytes;
     memTextures += r.memTextures;
     memBuffers += r.memBuffers;
     memIndexBuffers += r.memIndexBuffers;
     memVertexBuffers += r.memVertexBuffers;
     memUniformBuffers += r.memUniformBuffers;
+    memBufferSlabs += r.memBufferSlabs;
     stencilClears += r.stencilClears;
     stencilUpdates += r.stencilUpdates;
     return *this;
@@ -60,7 +68,9 @@ RenderingStats& RenderingStats::operator+=(const RenderingStats& r) {
 std::string RenderingStats::toString(std::string_view sep) const {
     std::stringstream ss;
     ss << "numFrames = " << numFrames << sep << "numDrawCalls = " << numDrawCalls << sep
-       << "totalDrawCalls = " << totalDrawCalls << sep << "numCreatedTextures = " << numCreatedTextures << sep
+       << "totalDrawCalls = " << totalDrawCalls << sep << "numCulledDrawables = " << numCulledDrawables << sep
+       << "numElidedBinds = " << numElidedBinds << sep << "numLinkedPrograms = " << numLinkedPrograms << sep
+       << "numCreatedTextures = " << numCreatedTextures << sep
        << "numActiveTextures = " << numActiveTextures << sep << "numTextureBindings = " << numTextureBindings << sep
        << "numTextureUpdates = " << numTextureUpdates << sep << "textureUpdateBytes = " << textureUpdateBytes << sep
        << "totalBuffers = " << totalBuffers << sep << "totalBufferObjs = " << totalBufferObjs << sep
@@ -68,11 +78,14 @@ std::string RenderingStats::toString(std::string_view sep) const {
        << "bufferUpdateBytes = " << bufferUpdateBytes << sep << "numBuffers = " << numBuffers << sep
        << "numFrameBuffers = " << numFrameBuffers << sep << "numIndexBuffers = " << numIndexBuffers << sep
        << "indexUpdateBytes = " << indexUpdateBytes << sep << "numVertexBuffers = " << numVertexBuffers << sep
-       << "vertexUpdateBytes = " << vertexUpdateBytes << sep << "numUniformBuffers = " << numUniformBuffers << sep
-       << "numUniformUpdates = " << numUniformUpdates << sep << "uniformUpdateBytes = " << uniformUpdateBytes << sep
+       << "vertexUpdateBytes = " << vertexUpdateBytes << sep << "numBufferSlabs = " << numBufferSlabs << sep
+       << "numUniformBuffers = " << numUniformBuffers << sep
+       << "numUniformUpdates = " << numUniformUpdates << sep << "numUniformUploads = " << numUniformUploads << sep
+       << "uniformUpdateBytes = " << uniformUpdateBytes << sep
        << "memTextures = " << memTextures << sep << "memBuffers = " << memBuffers << sep
        << "memIndexBuffers = " << memIndexBuffers << sep << "memVertexBuffers = " << memVertexBuffers << sep
-       << "memUniformBuffers = " << memUniformBuffers << sep << "stencilClears = " << stencilClears << sep
+       << "memUniformBuffers = " << memUniformBuffers << sep << "memBufferSlabs = " << memBufferSlabs << sep
+       << "stencilClears = " << stencilClears << sep
        << "stencilUpdates = " << stencilUpdates << sep;
     return ss.str();
 }
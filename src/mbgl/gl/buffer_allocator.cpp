@@ -0,0 +1,248 @@
+#include <mbgl/gl/buffer_allocator.hpp>
+#include <mbgl/gl/context.hpp>
+#include <mbgl/gl/defines.hpp>
+#include <mbgl/gl/enum.hpp>
+#include <mbgl/platform/gl_functions.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+
+namespace mbgl {
+namespace gl {
+
+using namespace platform;
+
+struct BufferAllocation::Slab {
+    Slab(UniqueBuffer&& buffer_, std::size_t size_, bool dedicated_)
+        : buffer(std::move(buffer_)),
+          size(size_),
+          dedicated(dedicated_) {
+        if (!dedicated) {
+            freeRanges.emplace(0, size);
+        }
+    }
+
+    UniqueBuffer buffer;
+    const std::size_t size;
+    const bool dedicated;
+    std::size_t used = 0;
+    // Unallocated ranges, offset to size
+    std::map<std::size_t, std::size_t> freeRanges;
+};
+
+BufferAllocation::BufferAllocation() = default;
+
+BufferAllocation::BufferAllocation(BufferAllocator& allocator_, Slab& slab_, std::size_t offset_, std::size_t size_)
+    : allocator(&allocator_),
+      slab(&slab_),
+      offset(offset_),
+      size(size_) {}
+
+BufferAllocation::BufferAllocation(BufferAllocator& allocator_, std::unique_ptr<Slab> slab_, std::size_t size_)
+    : allocator(&allocator_),
+      slab(slab_.get()),
+      size(size_),
+      dedicatedSlab(std::move(slab_)) {}
+
+BufferAllocation::BufferAllocation(BufferAllocation&& other) noexcept
+    : allocator(other.allocator),
+      slab(other.slab),
+      offset(other.offset),
+      size(other.size),
+      dedicatedSlab(std::move(other.dedicatedSlab)) {
+    other.allocator = nullptr;
+    other.slab = nullptr;
+}
+
+BufferAllocation& BufferAllocation::operator=(BufferAllocation&& other) noexcept {
+    if (this != &other) {
+        release();
+        allocator = other.allocator;
+        slab = other.slab;
+        offset = other.offset;
+        size = other.size;
+        dedicatedSlab = std::move(other.dedicatedSlab);
+        other.allocator = nullptr;
+        other.slab = nullptr;
+    }
+    return *this;
+}
+
+BufferAllocation::~BufferAllocation() {
+    release();
+}
+
+BufferID BufferAllocation::getBuffer() const {
+    return slab ? slab->buffer.get() : 0;
+}
+
+Context& BufferAllocation::getContext() const {
+    assert(allocator);
+    return allocator->getContext();
+}
+
+void BufferAllocation::release() {
+    if (dedicatedSlab) {
+        // Deleting the slab abandons its buffer to the context
+        dedicatedSlab.reset();
+    } else if (allocator && slab) {
+        allocator->release(*slab, offset, size);
+    }
+    allocator = nullptr;
+    slab = nullptr;
+}
+
+namespace {
+std::size_t alignedSize(std::size_t size) {
+    return std::max<std::size_t>(
+        (size + BufferAllocator::alignment - 1) / BufferAllocator::alignment * BufferAllocator::alignment,
+        BufferAllocator::alignment);
+}
+} // namespace
+
+BufferAllocator::BufferAllocator(Context& context_, Target target_)
+    : context(context_),
+      target(target_) {}
+
+BufferAllocator::~BufferAllocator() {
+    // Any remaining slabs are returned to the context to be deleted
+    for (const auto& slab : slabs) {
+        countSlabDeleted(*slab);
+    }
+}
+
+void BufferAllocator::bind(BufferID buffer) {
+    if (target == Target::Vertex) {
+        context.vertexBuffer = buffer;
+    } else {
+        // Unbind any vertex array object first so that we don't mess up its index buffer
+        context.bindVertexArray = 0;
+        context.globalVertexArrayState.indexBuffer = buffer;
+    }
+}
+
+std::unique_ptr<BufferAllocation::Slab> BufferAllocator::createSlab(std::size_t size,
+                                                                    const void* data,
+                                                                    gfx::BufferUsageType usage,
+                                                                    bool dedicated) {
+    BufferID id = 0;
+    MBGL_CHECK_ERROR(glGenBuffers(1, &id));
+    // NOLINTNEXTLINE(performance-move-const-arg)
+    UniqueBuffer buffer{std::move(id), {context}};
+    bind(buffer.get());
+    MBGL_CHECK_ERROR(glBufferData(target == Target::Vertex ? GL_ARRAY_BUFFER : GL_ELEMENT_ARRAY_BUFFER,
+                                  size,
+                                  data,
+                                  Enum<gfx::BufferUsageType>::to(usage)));
+
+    auto& stats = context.renderingStats();
+    stats.numBuffers++;
+    if (!dedicated) {
+        stats.numBufferSlabs++;
+        stats.memBufferSlabs += static_cast<int>(size);
+    }
+    return std::make_unique<Slab>(std::move(buffer), size, dedicated);
+}
+
+BufferAllocation BufferAllocator::allocate(const void* data, std::size_t size, gfx::BufferUsageType usage) {
+    if (size > maxSubAllocationSize || usage != gfx::BufferUsageType::StaticDraw) {
+        return {*this, createSlab(size, data, usage, /*dedicated=*/true), size};
+    }
+
+    const std::size_t rangeSize = alignedSize(size);
+
+    // First fit, in slab creation order, which keeps the older slabs full
+    Slab* slab = nullptr;
+    std::size_t offset = 0;
+    for (auto& candidate : slabs) {
+        const auto hit = std::find_if(candidate->freeRanges.begin(),
+                                      candidate->freeRanges.end(),
+                                      [&](const auto& range) { return range.second >= rangeSize; });
+        if (hit != candidate->freeRanges.end()) {
+            slab = candidate.get();
+            offset = hit->first;
+            if (hit->second > rangeSize) {
+                slab->freeRanges.emplace(offset + rangeSize, hit->second - rangeSize);
+            }
+            slab->freeRanges.erase(hit);
+            break;
+        }
+    }
+    if (!slab) {
+        slabs.push_back(createSlab(slabSize, nullptr, gfx::BufferUsageType::StaticDraw, /*dedicated=*/false));
+        slab = slabs.back().get();
+        offset = 0;
+        slab->freeRanges.clear();
+        slab->freeRanges.emplace(rangeSize, slabSize - rangeSize);
+    }
+    slab->used += rangeSize;
+
+    BufferAllocation allocation{*this, *slab, offset, size};
+    if (data && size > 0) {
+        update(allocation, data, size);
+    }
+    return allocation;
+}
+
+void BufferAllocator::update(const BufferAllocation& allocation, const void* data, std::size_t size) {
+    assert(allocation.allocator == this);
+    assert(size <= allocation.getSize());
+    bind(allocation.getBuffer());
+    MBGL_CHECK_ERROR(glBufferSubData(
+        target == Target::Vertex ? GL_ARRAY_BUFFER : GL_ELEMENT_ARRAY_BUFFER, allocation.getOffset(), size, data));
+}
+
+void BufferAllocator::release(Slab& slab, std::size_t offset, std::size_t size) {
+    assert(!slab.dedicated);
+    const std::size_t rangeSize = alignedSize(size);
+    assert(slab.used >= rangeSize);
+    slab.used -= rangeSize;
+
+    // Return the range to the free list, merging it with its neighbors
+    auto next = slab.freeRanges.lower_bound(offset);
+    std::size_t begin = offset;
+    std::size_t end = offset + rangeSize;
+    if (next != slab.freeRanges.begin()) {
+        auto prev = std::prev(next);
+        if (prev->first + prev->second == begin) {
+            begin = prev->first;
+            slab.freeRanges.erase(prev);
+        }
+    }
+    if (next != slab.freeRanges.end() && next->first == end) {
+        end += next->second;
+        slab.freeRanges.erase(next);
+    }
+    slab.freeRanges.emplace(begin, end - begin);
+
+    if (slab.used == 0) {
+        const auto emptySlabs = std::count_if(
+            slabs.begin(), slabs.end(), [](const auto& candidate) { return candidate->used == 0; });
+        if (static_cast<std::size_t>(emptySlabs) > maxEmptySlabs) {
+            countSlabDeleted(slab);
+            slabs.erase(std::find_if(
+                slabs.begin(), slabs.end(), [&](const auto& candidate) { return candidate.get() == &slab; }));
+        }
+    }
+}
+
+void BufferAllocator::countSlabDeleted(const Slab& slab) {
+    assert(!slab.dedicated);
+    auto& stats = context.renderingStats();
+    stats.numBufferSlabs--;
+    stats.memBufferSlabs -= static_cast<int>(slab.size);
+}
+
+void BufferAllocator::releaseEmptySlabs() {
+    for (auto& slab : slabs) {
+        if (slab->used == 0) {
+            countSlabDeleted(*slab);
+        }
+    }
+    slabs.erase(std::remove_if(slabs.begin(), slabs.end(), [](const auto& slab) { return slab->used == 0; }),
+                slabs.end());
+}
+
+} // namespace gl
+} // namespace mbgl
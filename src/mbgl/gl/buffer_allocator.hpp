@@ -0,0 +1,102 @@
+#pragma once
+
+#include <mbgl/gfx/types.hpp>
+#include <mbgl/gl/object.hpp>
+#include <mbgl/util/noncopyable.hpp>
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace mbgl {
+namespace gl {
+
+class Context;
+class BufferAllocator;
+
+/// A range of a GL buffer, released back to its allocator when destroyed
+class BufferAllocation {
+public:
+    BufferAllocation();
+    BufferAllocation(BufferAllocation&&) noexcept;
+    BufferAllocation& operator=(BufferAllocation&&) noexcept;
+    BufferAllocation(const BufferAllocation&) = delete;
+    BufferAllocation& operator=(const BufferAllocation&) = delete;
+    ~BufferAllocation();
+
+    BufferID getBuffer() const;
+    std::size_t getOffset() const { return offset; }
+    std::size_t getSize() const { return size; }
+
+    Context& getContext() const;
+
+private:
+    struct Slab;
+    friend class BufferAllocator;
+
+    BufferAllocation(BufferAllocator&, Slab&, std::size_t offset, std::size_t size);
+    BufferAllocation(BufferAllocator&, std::unique_ptr<Slab>, std::size_t size);
+    void release();
+
+    BufferAllocator* allocator = nullptr;
+    Slab* slab = nullptr;
+    std::size_t offset = 0;
+    std::size_t size = 0;
+    // Set for data with a buffer of its own
+    std::unique_ptr<Slab> dedicatedSlab;
+};
+
+/// Sub-allocates vertex or index data from large, long-lived GL buffers ("slabs").
+///
+/// Creating a GL buffer per bucket fragments driver memory and churns allocations as
+/// tiles come and go. Static data is instead placed in slabs with first-fit free lists,
+/// and the ranges freed by unloaded tiles are reused by the next ones. A slab that
+/// becomes empty is kept for reuse, up to `maxEmptySlabs`, and deleted otherwise.
+/// Large or frequently updated data still gets a buffer of its own.
+class BufferAllocator : private util::noncopyable {
+public:
+    enum class Target {
+        Vertex,
+        Index,
+    };
+
+    static constexpr std::size_t slabSize = 4 * 1024 * 1024;
+    /// Data larger than this gets a dedicated buffer
+    static constexpr std::size_t maxSubAllocationSize = slabSize / 4;
+    static constexpr std::size_t maxEmptySlabs = 1;
+    /// Alignment of the ranges within a slab, which covers any vertex attribute type
+    static constexpr std::size_t alignment = 16;
+
+    BufferAllocator(Context&, Target);
+    ~BufferAllocator();
+
+    /// Create a range holding a copy of `data`
+    BufferAllocation allocate(const void* data, std::size_t size, gfx::BufferUsageType);
+
+    /// Replace the start of an allocation's contents
+    void update(const BufferAllocation&, const void* data, std::size_t size);
+
+    /// Delete the slabs kept for reuse
+    void releaseEmptySlabs();
+
+    std::size_t getSlabCount() const { return slabs.size(); }
+    Context& getContext() const { return context; }
+
+private:
+    friend class BufferAllocation;
+    using Slab = BufferAllocation::Slab;
+
+    void bind(BufferID);
+    std::unique_ptr<Slab> createSlab(std::size_t size, const void* data, gfx::BufferUsageType, bool dedicated);
+    void release(Slab&, std::size_t offset, std::size_t size);
+    void countSlabDeleted(const Slab&);
+
+    Context& context;
+    const Target target;
+
+    std::vector<std::unique_ptr<Slab>> slabs;
+};
+
+} // namespace gl
+} // namespace mbgl
@@ -0,0 +1,95 @@
+#include <mbgl/gl/command_list.hpp>
+#include <mbgl/gl/context.hpp>
+#include <mbgl/gl/texture2d.hpp>
+#include <mbgl/gl/uniform_buffer_gl.hpp>
+#include <mbgl/shaders/gl/shader_program_gl.hpp>
+
+#include <cassert>
+
+namespace mbgl {
+namespace gl {
+
+CommandList::Draw& CommandList::addDraw() {
+    auto& draw = draws.emplace_back();
+    draw.uniformBuffersEnd = uniformBuffers.size();
+    draw.texturesEnd = textures.size();
+    draw.segmentsEnd = segments.size();
+    return draw;
+}
+
+void CommandList::addUniformBuffer(uint32_t binding, const UniformBufferGL& buffer) {
+    assert(!draws.empty());
+    uniformBuffers.push_back({binding, &buffer});
+    draws.back().uniformBuffersEnd = uniformBuffers.size();
+}
+
+void CommandList::addTexture(Texture2D& texture, int32_t location, int32_t textureUnit) {
+    assert(!draws.empty());
+    textures.push_back({&texture, location, textureUnit});
+    draws.back().texturesEnd = textures.size();
+}
+
+void CommandList::addSegment(VertexArrayID vertexArray,
+                             const gfx::DrawMode& mode,
+                             std::size_t indexOffset,
+                             std::size_t indexLength) {
+    assert(!draws.empty());
+    segments.push_back({vertexArray, &mode, indexOffset, indexLength});
+    draws.back().segmentsEnd = segments.size();
+}
+
+void CommandList::clear() {
+    draws.clear();
+    uniformBuffers.clear();
+    textures.clear();
+    segments.clear();
+}
+
+void CommandList::replay(Context& context) const {
+    auto& stats = context.renderingStats();
+
+    std::size_t uniformBufferIndex = 0;
+    std::size_t textureIndex = 0;
+    std::size_t segmentIndex = 0;
+    for (const auto& draw : draws) {
+        const auto programID = draw.shader->getGLProgramID();
+        if (context.program == programID) {
+            stats.numElidedBinds++;
+        } else {
+            context.program = programID;
+        }
+
+        context.setDepthMode(draw.depthMode);
+        if (draw.stencilMode) {
+            context.setStencilMode(*draw.stencilMode);
+        }
+        context.setColorMode(draw.colorMode);
+        context.setCullFaceMode(draw.cullFaceMode);
+
+        for (; uniformBufferIndex < draw.uniformBuffersEnd; ++uniformBufferIndex) {
+            const auto& binding = uniformBuffers[uniformBufferIndex];
+            binding.buffer->bind(static_cast<int>(binding.binding));
+        }
+
+        for (; textureIndex < draw.texturesEnd; ++textureIndex) {
+            const auto& binding = textures[textureIndex];
+            binding.texture->bind(binding.textureUnit);
+            if (!draw.shader->setSamplerUnit(binding.location, binding.textureUnit)) {
+                stats.numElidedBinds++;
+            }
+        }
+
+        for (; segmentIndex < draw.segmentsEnd; ++segmentIndex) {
+            const auto& segment = segments[segmentIndex];
+            if (context.bindVertexArray == segment.vertexArray) {
+                stats.numElidedBinds++;
+            } else {
+                context.bindVertexArray = segment.vertexArray;
+            }
+            context.draw(*segment.mode, segment.indexOffset, segment.indexLength);
+        }
+    }
+}
+
+} // namespace gl
+} // namespace mbgl
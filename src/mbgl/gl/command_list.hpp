@@ -0,0 +1,84 @@
+#pragma once
+
+#include <mbgl/gfx/color_mode.hpp>
+#include <mbgl/gfx/cull_face_mode.hpp>
+#include <mbgl/gfx/depth_mode.hpp>
+#include <mbgl/gfx/stencil_mode.hpp>
+#include <mbgl/gl/types.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace mbgl {
+namespace gfx {
+class DrawMode;
+} // namespace gfx
+
+namespace gl {
+
+class Context;
+class ShaderProgramGL;
+class Texture2D;
+class UniformBufferGL;
+
+/// Draws recorded from drawables without making any GL calls, to be replayed on the GL thread.
+///
+/// The objects referenced by a list must stay alive and unchanged until it's replayed.
+class CommandList {
+public:
+    struct Draw {
+        ShaderProgramGL* shader = nullptr;
+        gfx::DepthMode depthMode = gfx::DepthMode::disabled();
+        // Unset if the stencil mode is left to the layer group
+        std::optional<gfx::StencilMode> stencilMode;
+        gfx::ColorMode colorMode = gfx::ColorMode::disabled();
+        gfx::CullFaceMode cullFaceMode = gfx::CullFaceMode::disabled();
+
+        // Ranges of the bindings and segments recorded after this draw
+        std::size_t uniformBuffersEnd = 0;
+        std::size_t texturesEnd = 0;
+        std::size_t segmentsEnd = 0;
+    };
+
+    /// Start recording a draw, followed by its bindings and segments
+    Draw& addDraw();
+    void addUniformBuffer(uint32_t binding, const UniformBufferGL&);
+    void addTexture(Texture2D&, int32_t location, int32_t textureUnit);
+    void addSegment(VertexArrayID, const gfx::DrawMode&, std::size_t indexOffset, std::size_t indexLength);
+
+    std::size_t size() const { return draws.size(); }
+    bool empty() const { return draws.empty(); }
+
+    /// Forget the recorded draws, keeping the allocated storage
+    void clear();
+
+    /// Issue the recorded draws.  Must be called on the GL thread.
+    void replay(Context&) const;
+
+private:
+    struct UniformBufferBinding {
+        uint32_t binding;
+        const UniformBufferGL* buffer;
+    };
+    struct TextureBinding {
+        Texture2D* texture;
+        int32_t location;
+        int32_t textureUnit;
+    };
+    struct Segment {
+        VertexArrayID vertexArray;
+        const gfx::DrawMode* mode;
+        std::size_t indexOffset;
+        std::size_t indexLength;
+    };
+
+    std::vector<Draw> draws;
+    std::vector<UniformBufferBinding> uniformBuffers;
+    std::vector<TextureBinding> textures;
+    std::vector<Segment> segments;
+};
+
+} // namespace gl
+} // namespace mbgl
@@ -10,13 +10,16 @@
 #include <mbgl/gl/texture_resource.hpp>
 #include <mbgl/gl/texture.hpp>
 #include <mbgl/gl/offscreen_texture.hpp>
+#include <mbgl/gl/program_binary_cache.hpp>
 #include <mbgl/gl/debugging_extension.hpp>
 #include <mbgl/renderer/paint_parameters.hpp>
+#include <mbgl/actor/scheduler.hpp>
 #include <mbgl/util/traits.hpp>
 #include <mbgl/util/std.hpp>
 #include <mbgl/util/logging.hpp>
 
 #if MLN_DRAWABLE_RENDERER
+#include <mbgl/gl/command_list.hpp>
 #include <mbgl/gl/drawable_gl.hpp>
 #include <mbgl/gl/drawable_gl_builder.hpp>
 #include <mbgl/gl/layer_group_gl.hpp>
@@ -108,6 +111,15 @@ void Context::initializeExtensions(const std::function<gl::ProcAddress(const cha
         if (!(renderer.find("ANGLE") != std::string::npos && renderer.find("Direct3D") != std::string::npos)) {
             debugging = std::make_unique<extension::Debugging>(fn);
         }
+
+        // Let the driver compile and link programs on its own threads, see `startProgram`
+        const ExtensionFunction<void(GLuint)> maxShaderCompilerThreads = fn(
+            {{"GL_KHR_parallel_shader_compile", "glMaxShaderCompilerThreadsKHR"},
+             {"GL_ARB_parallel_shader_compile", "glMaxShaderCompilerThreadsARB"}});
+        if (maxShaderCompilerThreads) {
+            MBGL_CHECK_ERROR(maxShaderCompilerThreads(0xFFFFFFFF));
+            parallelShaderCompile = true;
+        }
     }
 }
 
@@ -131,23 +143,32 @@ void Context::enableDebugging() {
     MBGL_CHECK_ERROR(debugging->debugMessageCallback(extension::Debugging::DebugCallback, nullptr));
 }
 
-UniqueShader Context::createShader(ShaderType type, const std::initializer_list<const char*>& sources) {
+UniqueShader Context::compileShader(ShaderType type, const std::initializer_list<const char*>& sources) {
     UniqueShader result{MBGL_CHECK_ERROR(glCreateShader(static_cast<GLenum>(type))), {this}};
 
     MBGL_CHECK_ERROR(glShaderSource(result, static_cast<GLsizei>(sources.size()), sources.begin(), nullptr));
     MBGL_CHECK_ERROR(glCompileShader(result));
+    return result;
+}
 
+UniqueShader Context::createShader(ShaderType type, const std::initializer_list<const char*>& sources) {
+    UniqueShader result = compileShader(type, sources);
+    verifyShaderCompilation(result);
+    return result;
+}
+
+void Context::verifyShaderCompilation(ShaderID shader) {
     GLint status = 0;
-    MBGL_CHECK_ERROR(glGetShaderiv(result, GL_COMPILE_STATUS, &status));
+    MBGL_CHECK_ERROR(glGetShaderiv(shader, GL_COMPILE_STATUS, &status));
     if (status != 0) {
-        return result;
+        return;
     }
 
     GLint logLength;
-    MBGL_CHECK_ERROR(glGetShaderiv(result, GL_INFO_LOG_LENGTH, &logLength));
+    MBGL_CHECK_ERROR(glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &logLength));
     if (logLength > 0) {
         const auto log = std::make_unique<GLchar[]>(logLength);
-        MBGL_CHECK_ERROR(glGetShaderInfoLog(result, logLength, &logLength, log.get()));
+        MBGL_CHECK_ERROR(glGetShaderInfoLog(shader, logLength, &logLength, log.get()));
         Log::Error(Event::Shader, std::string("Shader failed to compile: ") + log.get());
     }
 
@@ -171,6 +192,119 @@ UniqueProgram Context::createProgram(ShaderID vertexShader, ShaderID fragmentSha
     return result;
 }
 
+UniqueProgram Context::createProgram(const std::initializer_list<const char*>& vertexSource,
+                                     const std::initializer_list<const char*>& fragmentSource,
+                                     const char* location0AttribName) {
+    return finishProgram(startProgram(vertexSource, fragmentSource, location0AttribName));
+}
+
+Context::ProgramBuild Context::startProgram(const std::initializer_list<const char*>& vertexSource,
+                                            const std::initializer_list<const char*>& fragmentSource,
+                                            const char* location0AttribName) {
+    std::optional<uint64_t> cacheKey;
+    if (const auto cache = programBinaryCache) {
+        cacheKey = ProgramBinaryCache::makeKey(vertexSource, fragmentSource, location0AttribName);
+        if (const auto binary = cache->get(*cacheKey)) {
+            UniqueProgram result{MBGL_CHECK_ERROR(glCreateProgram()), {this}};
+            MBGL_CHECK_ERROR(glProgramBinary(
+                result, binary->format, binary->data.data(), static_cast<GLsizei>(binary->data.size())));
+
+            GLint status = GL_FALSE;
+            MBGL_CHECK_ERROR(glGetProgramiv(result, GL_LINK_STATUS, &status));
+            if (status == GL_TRUE) {
+                return {std::move(result), {}, std::nullopt};
+            }
+
+            // Rejected by the driver, e.g., after an update that kept its version string
+            cache->remove(*cacheKey);
+        }
+    }
+
+    // Don't query the compile status here, that would wait for the compiler
+    std::vector<UniqueShader> shaders;
+    shaders.push_back(compileShader(ShaderType::Vertex, vertexSource));
+    shaders.push_back(compileShader(ShaderType::Fragment, fragmentSource));
+
+    UniqueProgram result{MBGL_CHECK_ERROR(glCreateProgram()), {this}};
+    for (const auto& shader : shaders) {
+        MBGL_CHECK_ERROR(glAttachShader(result, shader));
+    }
+
+    // See `createProgram` above
+    MBGL_CHECK_ERROR(glBindAttribLocation(result, 0, location0AttribName));
+    if (cacheKey) {
+        MBGL_CHECK_ERROR(glProgramParameteri(result, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE));
+    }
+    MBGL_CHECK_ERROR(glLinkProgram(result));
+    stats.numLinkedPrograms++;
+
+    return {std::move(result), std::move(shaders), cacheKey};
+}
+
+bool Context::isProgramReady(const ProgramBuild& build) const {
+    if (build.shaders.empty()) {
+        return true;
+    }
+    if (!parallelShaderCompile) {
+        // There's no way to tell, and no telling how long waiting for a later frame would take
+        return true;
+    }
+    GLint completed = GL_FALSE;
+    MBGL_CHECK_ERROR(glGetProgramiv(build.program, GL_COMPLETION_STATUS_KHR, &completed));
+    return completed == GL_TRUE;
+}
+
+UniqueProgram Context::finishProgram(ProgramBuild&& build) {
+    if (build.shaders.empty()) {
+        return std::move(build.program);
+    }
+
+    GLint status = GL_FALSE;
+    MBGL_CHECK_ERROR(glGetProgramiv(build.program, GL_LINK_STATUS, &status));
+    if (status != GL_TRUE) {
+        // A compile error is the more useful message
+        for (const auto& shader : build.shaders) {
+            verifyShaderCompilation(shader);
+        }
+        verifyProgramLinkage(build.program);
+    }
+
+    const auto cache = programBinaryCache;
+    if (cache && build.cacheKey) {
+        GLint length = 0;
+        MBGL_CHECK_ERROR(glGetProgramiv(build.program, GL_PROGRAM_BINARY_LENGTH, &length));
+        if (length > 0) {
+            ProgramBinaryCache::Binary binary;
+            binary.data.resize(length);
+            GLenum format = 0;
+            MBGL_CHECK_ERROR(glGetProgramBinary(build.program, length, &length, &format, binary.data.data()));
+            binary.data.resize(length);
+            binary.format = format;
+            // Written once per frame by `performCleanup`, along with the other programs linked meanwhile
+            cache->put(*build.cacheKey, std::move(binary));
+        }
+    }
+
+    return std::move(build.program);
+}
+
+void Context::setProgramCachePath(const std::string& path) {
+    GLint formats = 0;
+    MBGL_CHECK_ERROR(glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats));
+    if (formats <= 0) {
+        // Program binaries are not supported by the driver
+        programBinaryCache.reset();
+        return;
+    }
+
+    // Binaries are only valid for the exact driver that produced them
+    std::string driver;
+    for (const GLenum name : {GL_VENDOR, GL_RENDERER, GL_VERSION}) {
+        driver.append(reinterpret_cast<const char*>(MBGL_CHECK_ERROR(glGetString(name)))).append("\n");
+    }
+    programBinaryCache = std::make_shared<ProgramBinaryCache>(path, std::move(driver));
+}
+
 void Context::linkProgram(ProgramID program_) {
     MBGL_CHECK_ERROR(glLinkProgram(program_));
     verifyProgramLinkage(program_);
@@ -426,7 +560,18 @@ std::unique_ptr<gfx::DrawScopeResource> Context::createDrawScopeResource() {
 void Context::reset() {
     std::copy(pooledTextures.begin(), pooledTextures.end(), std::back_inserter(abandonedTextures));
     pooledTextures.resize(0);
+    for (auto* allocator : {vertexBufferAllocator.get(), indexBufferAllocator.get()}) {
+        if (allocator) {
+            allocator->releaseEmptySlabs();
+        }
+    }
     performCleanup();
+#if MLN_DRAWABLE_RENDERER
+    if (uniformBufferAllocator) {
+        uniformBufferAllocator->releaseBuffers();
+    }
+    uniformBufferBindings.clear();
+#endif
 }
 
 #if MLN_DRAWABLE_RENDERER
@@ -451,6 +596,28 @@ bool Context::emplaceOrUpdateUniformBuffer(gfx::UniformBufferPtr& buffer,
         return true;
     }
 }
+
+CommandList& Context::getCommandList() {
+    if (!commandList) {
+        commandList = std::make_unique<CommandList>();
+    }
+    return *commandList;
+}
+
+void Context::bindUniformBufferRange(uint32_t binding, BufferID buffer, std::size_t offset, std::size_t size) {
+    if (binding >= uniformBufferBindings.size()) {
+        uniformBufferBindings.resize(binding + 1);
+    }
+
+    auto& current = uniformBufferBindings[binding];
+    if (current.buffer == buffer && current.offset == offset && current.size == size) {
+        stats.numElidedBinds++;
+        return;
+    }
+
+    MBGL_CHECK_ERROR(glBindBufferRange(GL_UNIFORM_BUFFER, binding, buffer, offset, size));
+    current = {buffer, offset, size};
+}
 #endif
 
 void Context::setDirtyState() {
@@ -486,6 +653,9 @@ void Context::setDirtyState() {
     vertexBuffer.setDirty();
     bindVertexArray.setDirty();
     globalVertexArrayState.setDirty();
+#if MLN_DRAWABLE_RENDERER
+    uniformBufferBindings.clear();
+#endif
 }
 
 #if MLN_DRAWABLE_RENDERER
@@ -494,7 +664,10 @@ gfx::UniqueDrawableBuilder Context::createDrawableBuilder(std::string name) {
 }
 
 gfx::UniformBufferPtr Context::createUniformBuffer(const void* data, std::size_t size, bool /*persistent*/) {
-    return std::make_shared<gl::UniformBufferGL>(data, size);
+    if (!uniformBufferAllocator) {
+        uniformBufferAllocator = std::make_shared<UniformBufferAllocator>(*this);
+    }
+    return std::make_shared<gl::UniformBufferGL>(data, size, uniformBufferAllocator);
 }
 
 gfx::ShaderProgramBasePtr Context::getGenericShader(gfx::ShaderRegistry& shaders, const std::string& name) {
@@ -563,6 +736,8 @@ void Context::clear(std::optional<mbgl::Color> color, std::optional<float> depth
     MBGL_CHECK_ERROR(glClear(mask));
 
     stats.numDrawCalls = 0;
+    stats.numCulledDrawables = 0;
+    stats.numElidedBinds = 0;
 }
 
 void Context::setCullFaceMode(const gfx::CullFaceMode& mode) {
@@ -634,6 +809,14 @@ void Context::finish() {
     MBGL_CHECK_ERROR(glFinish());
 }
 
+BufferAllocator& Context::getBufferAllocator(BufferAllocator::Target target) {
+    auto& allocator = target == BufferAllocator::Target::Vertex ? vertexBufferAllocator : indexBufferAllocator;
+    if (!allocator) {
+        allocator = std::make_unique<BufferAllocator>(*this, target);
+    }
+    return *allocator;
+}
+
 void Context::draw(const gfx::DrawMode& drawMode, std::size_t indexOffset, std::size_t indexLength) {
     switch (drawMode.type) {
         case gfx::DrawModeType::Points:
@@ -656,6 +839,18 @@ void Context::draw(const gfx::DrawMode& drawMode, std::size_t indexOffset, std::
 }
 
 void Context::performCleanup() {
+    if (const auto cache = programBinaryCache; cache && cache->needsFlush()) {
+        // Flushes queued behind each other find nothing left to write
+        Scheduler::GetBackground()->schedule([cache] { cache->flush(); });
+    }
+
+#if MLN_DRAWABLE_RENDERER
+    // Uniforms of the next frame go to the next buffer of the ring
+    if (uniformBufferAllocator) {
+        uniformBufferAllocator->endFrame();
+    }
+#endif
+
     // TODO: Find a better way to unbind VAOs after we're done with them without
     // introducing unnecessary bind(0)/bind(N) sequences.
     {
@@ -687,6 +882,13 @@ void Context::performCleanup() {
             } else if (globalVertexArrayState.indexBuffer == id) {
                 globalVertexArrayState.indexBuffer.setDirty();
             }
+#if MLN_DRAWABLE_RENDERER
+            for (auto& binding : uniformBufferBindings) {
+                if (binding.buffer == id) {
+                    binding = {};
+                }
+            }
+#endif
         }
         MBGL_CHECK_ERROR(glDeleteBuffers(int(abandonedBuffers.size()), abandonedBuffers.data()));
         stats.numBuffers -= int(abandonedBuffers.size());
@@ -736,6 +938,11 @@ void Context::performCleanup() {
 }
 
 void Context::reduceMemoryUsage() {
+    for (auto* allocator : {vertexBufferAllocator.get(), indexBufferAllocator.get()}) {
+        if (allocator) {
+            allocator->releaseEmptySlabs();
+        }
+    }
     performCleanup();
 
     // Ensure that all pending actions are executed to ensure that they happen
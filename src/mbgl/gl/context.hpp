@@ -6,6 +6,7 @@
 #include <mbgl/gfx/stencil_mode.hpp>
 #include <mbgl/gfx/color_mode.hpp>
 #include <mbgl/gfx/context.hpp>
+#include <mbgl/gl/buffer_allocator.hpp>
 #include <mbgl/gl/object.hpp>
 #include <mbgl/gl/state.hpp>
 #include <mbgl/gl/value.hpp>
@@ -21,14 +22,19 @@
 
 #include <array>
 #include <functional>
+#include <optional>
 #include <vector>
 
 namespace mbgl {
+
 namespace gl {
 
 constexpr size_t TextureMax = 64;
 using ProcAddress = void (*)();
+class CommandList;
+class ProgramBinaryCache;
 class RendererBackend;
+class UniformBufferAllocator;
 
 namespace extension {
 class VertexArray;
@@ -50,6 +56,31 @@ public:
 
     UniqueShader createShader(ShaderType type, const std::initializer_list<const char*>& sources);
     UniqueProgram createProgram(ShaderID vertexShader, ShaderID fragmentShader, const char* location0AttribName);
+    /// Create a program from shader sources, loading it from the program binary cache if possible
+    UniqueProgram createProgram(const std::initializer_list<const char*>& vertexSource,
+                                const std::initializer_list<const char*>& fragmentSource,
+                                const char* location0AttribName);
+
+    /// A program which may still be compiling and linking, see `startProgram`
+    struct ProgramBuild {
+        UniqueProgram program;
+        // Empty if the program was loaded from the program binary cache
+        std::vector<UniqueShader> shaders;
+        std::optional<uint64_t> cacheKey;
+    };
+
+    /// Start creating a program from shader sources, without waiting for the driver to compile and link it.
+    /// With `GL_KHR_parallel_shader_compile`, that happens in the background until the program is finished.
+    ProgramBuild startProgram(const std::initializer_list<const char*>& vertexSource,
+                              const std::initializer_list<const char*>& fragmentSource,
+                              const char* location0AttribName);
+    /// Whether `finishProgram` can complete without waiting for the driver.  Always true without
+    /// `GL_KHR_parallel_shader_compile`, which is needed to ask.
+    bool isProgramReady(const ProgramBuild&) const;
+    /// Wait for a program to be linked, throws if it failed to compile or link
+    UniqueProgram finishProgram(ProgramBuild&&);
+
+    void verifyShaderCompilation(ShaderID);
     void verifyProgramLinkage(ProgramID);
     void linkProgram(ProgramID);
     UniqueTexture createUniqueTexture();
@@ -79,6 +110,9 @@ public:
 
     void draw(const gfx::DrawMode&, std::size_t indexOffset, std::size_t indexLength);
 
+    /// Get the allocator for vertex or index buffer data
+    BufferAllocator& getBufferAllocator(BufferAllocator::Target);
+
     void finish();
 
     // Actually remove the objects we marked as abandoned with the above methods.
@@ -125,16 +159,42 @@ public:
                                       const void* data,
                                       std::size_t size,
                                       bool persistent) override;
+
+    /// Bind a range of a buffer to an indexed uniform buffer binding point, unless it's already bound there
+    void bindUniformBufferRange(uint32_t binding, BufferID, std::size_t offset, std::size_t size);
+
+    /// Command list for drawing on the GL thread, re-used by each draw
+    CommandList& getCommandList();
 #endif
 
     void setDirtyState() override;
 
+    void setProgramCachePath(const std::string&) override;
+
 private:
     RendererBackend& backend;
     bool cleanupOnDestruction = true;
 
     std::unique_ptr<extension::Debugging> debugging;
 
+    std::shared_ptr<ProgramBinaryCache> programBinaryCache;
+    // `GL_KHR_parallel_shader_compile` is available
+    bool parallelShaderCompile = false;
+
+#if MLN_DRAWABLE_RENDERER
+    std::shared_ptr<UniformBufferAllocator> uniformBufferAllocator;
+
+    // Ranges bound to the indexed uniform buffer binding points
+    struct UniformBufferBinding {
+        BufferID buffer = 0;
+        std::size_t offset = 0;
+        std::size_t size = 0;
+    };
+    std::vector<UniformBufferBinding> uniformBufferBindings;
+
+    std::unique_ptr<CommandList> commandList;
+#endif
+
 public:
     State<value::ActiveTextureUnit> activeTextureUnit;
     State<value::BindFramebuffer> bindFramebuffer;
@@ -188,6 +248,8 @@ private:
     UniqueFramebuffer createFramebuffer();
     std::unique_ptr<uint8_t[]> readFramebuffer(Size, gfx::TexturePixelType, bool flip);
 
+    UniqueShader compileShader(ShaderType type, const std::initializer_list<const char*>& sources);
+
 public:
     VertexArray createVertexArray();
 
@@ -210,6 +272,10 @@ private:
     std::vector<FramebufferID> abandonedFramebuffers;
     std::vector<RenderbufferID> abandonedRenderbuffers;
 
+    // Declared after the abandoned objects, which slabs are returned to on destruction
+    std::unique_ptr<BufferAllocator> vertexBufferAllocator;
+    std::unique_ptr<BufferAllocator> indexBufferAllocator;
+
 public:
 #if !defined(NDEBUG)
 public:
@@ -711,6 +711,7 @@
 #define GL_PROGRAM_BINARY_LENGTH 0x8741
 #define GL_NUM_PROGRAM_BINARY_FORMATS 0x87FE
 #define GL_PROGRAM_BINARY_FORMATS 0x87FF
+#define GL_COMPLETION_STATUS_KHR 0x91B1
 #define GL_COMPRESSED_R11_EAC 0x9270
 #define GL_COMPRESSED_SIGNED_R11_EAC 0x9271
 #define GL_COMPRESSED_RG11_EAC 0x9272
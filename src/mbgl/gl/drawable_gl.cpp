@@ -1,5 +1,7 @@
 #include <mbgl/gl/drawable_gl.hpp>
+#include <mbgl/gl/command_list.hpp>
 #include <mbgl/gl/drawable_gl_impl.hpp>
+#include <mbgl/gl/index_buffer_resource.hpp>
 #include <mbgl/gl/texture2d.hpp>
 #include <mbgl/gl/upload_pass.hpp>
 #include <mbgl/gl/vertex_array.hpp>
@@ -13,6 +15,14 @@
 namespace mbgl {
 namespace gl {
 
+struct IndexBufferGL : public gfx::IndexBufferBase {
+    IndexBufferGL(std::unique_ptr<gfx::IndexBuffer>&& buffer_)
+        : buffer(std::move(buffer_)) {}
+    ~IndexBufferGL() override = default;
+
+    std::unique_ptr<mbgl::gfx::IndexBuffer> buffer;
+};
+
 DrawableGL::DrawableGL(std::string name_)
     : Drawable(std::move(name_)),
       impl(std::make_unique<Impl>()) {}
@@ -28,53 +38,65 @@ void DrawableGL::draw(PaintParameters& parameters) const {
     }
 
     auto& context = static_cast<gl::Context&>(parameters.context);
+    auto& commands = context.getCommandList();
+    commands.clear();
+    record(parameters, commands);
+    commands.replay(context);
 
-    if (shader) {
-        const auto& shaderGL = static_cast<const ShaderProgramGL&>(*shader);
-        if (shaderGL.getGLProgramID() != context.program.getCurrentValue()) {
-            context.program = shaderGL.getGLProgramID();
-        }
+    // Bindings are left in place for the next drawable, the layer group restores the default vertex array
+}
+
+void DrawableGL::record(const PaintParameters& parameters, CommandList& commands) const {
+    if (isCustom) {
+        return;
     }
-    if (!shader || context.program.getCurrentValue() == 0) {
+
+    auto* shaderGL = static_cast<ShaderProgramGL*>(shader.get());
+    if (!shaderGL || shaderGL->getGLProgramID() == 0) {
         mbgl::Log::Warning(Event::General, "Missing shader for drawable " + util::toString(getID()) + "/" + getName());
         assert(false);
         return;
     }
 
+    auto& command = commands.addDraw();
+    command.shader = shaderGL;
+
     if (enableDepth) {
-        context.setDepthMode(getIs3D() ? parameters.depthModeFor3D()
-                                       : parameters.depthModeForSublayer(getSubLayerIndex(), getDepthType()));
+        command.depthMode = getIs3D() ? parameters.depthModeFor3D()
+                                      : parameters.depthModeForSublayer(getSubLayerIndex(), getDepthType());
     } else {
-        context.setDepthMode(gfx::DepthMode::disabled());
+        command.depthMode = gfx::DepthMode::disabled();
     }
 
     // force disable depth test for debugging
-    // context.setDepthMode({gfx::DepthFunctionType::Always, gfx::DepthMaskType::ReadOnly, {0,1}});
+    // command.depthMode = {gfx::DepthFunctionType::Always, gfx::DepthMaskType::ReadOnly, {0,1}};
 
     // For 3D mode, stenciling is handled by the layer group
     if (!is3D) {
-        context.setStencilMode(makeStencilMode(parameters));
+        command.stencilMode = makeStencilMode(parameters);
     }
 
-    context.setColorMode(getColorMode());
-    context.setCullFaceMode(getCullFaceMode());
+    command.colorMode = getColorMode();
+    command.cullFaceMode = getCullFaceMode();
 
-    bindUniformBuffers();
-    bindTextures();
+    recordUniformBuffers(commands);
+    recordTextures(commands);
+
+    // The index data may be sub-allocated from a larger buffer
+    std::size_t indexBase = 0;
+    if (const auto* indexBuffer = static_cast<const IndexBufferGL*>(impl->indexes ? impl->indexes->getBuffer()
+                                                                                  : nullptr)) {
+        indexBase = indexBuffer->buffer->getResource<gl::IndexBufferResource>().getByteOffset() / sizeof(uint16_t);
+    }
 
     for (const auto& seg : impl->segments) {
         const auto& glSeg = static_cast<DrawSegmentGL&>(*seg);
         const auto& mlSeg = glSeg.getSegment();
         if (mlSeg.indexLength > 0 && glSeg.getVertexArray().isValid()) {
-            context.bindVertexArray = glSeg.getVertexArray().getID();
-            context.draw(glSeg.getMode(), mlSeg.indexOffset, mlSeg.indexLength);
+            commands.addSegment(
+                glSeg.getVertexArray().getID(), glSeg.getMode(), indexBase + mlSeg.indexOffset, mlSeg.indexLength);
         }
     }
-
-    context.bindVertexArray = value::BindVertexArray::Default;
-
-    unbindTextures();
-    unbindUniformBuffers();
 }
 
 void DrawableGL::setIndexData(gfx::IndexVectorBasePtr indexes, std::vector<UniqueDrawSegment> segments) {
@@ -100,43 +122,26 @@ void DrawableGL::setVertexAttrNameId(const StringIdentity id) {
     impl->idVertexAttrName = id;
 }
 
-void DrawableGL::bindUniformBuffers() const {
-    if (shader) {
-        const auto& shaderGL = static_cast<const ShaderProgramGL&>(*shader);
-        for (const auto& element : shaderGL.getUniformBlocks().getMap()) {
-            const auto& uniformBuffer = getUniformBuffers().get(element.first);
-            if (!uniformBuffer) {
-                using namespace std::string_literals;
-                const auto tileIDStr = getTileID() ? util::toString(*getTileID()) : "<no tile>";
-                Log::Error(Event::General,
-                           "bindUniformBuffers: UBO "s + std::string(stringIndexer().get(element.first)) +
-                               " not found for " + util::toString(getID()) + " / " + getName() + " / " + tileIDStr +
-                               ". skipping.");
-                assert(false);
-                continue;
-            }
-            element.second->bindBuffer(*uniformBuffer);
-        }
-    }
-}
-
-void DrawableGL::unbindUniformBuffers() const {
-    if (shader) {
-        const auto& shaderGL = static_cast<const ShaderProgramGL&>(*shader);
-        for (const auto& element : shaderGL.getUniformBlocks().getMap()) {
-            element.second->unbindBuffer();
+void DrawableGL::recordUniformBuffers(CommandList& commands) const {
+    const auto& shaderGL = static_cast<const ShaderProgramGL&>(*shader);
+    for (const auto& element : shaderGL.getUniformBlocks().getMap()) {
+        const auto& uniformBuffer = getUniformBuffers().get(element.first);
+        if (!uniformBuffer) {
+            using namespace std::string_literals;
+            const auto tileIDStr = getTileID() ? util::toString(*getTileID()) : "<no tile>";
+            Log::Error(Event::General,
+                       "bindUniformBuffers: UBO "s + std::string(stringIndexer().get(element.first)) +
+                           " not found for " + util::toString(getID()) + " / " + getName() + " / " + tileIDStr +
+                           ". skipping.");
+            assert(false);
+            continue;
         }
+        assert(element.second->getSize() == uniformBuffer->getSize());
+        commands.addUniformBuffer(static_cast<uint32_t>(element.second->getIndex()),
+                                  static_cast<const UniformBufferGL&>(*uniformBuffer));
     }
 }
 
-struct IndexBufferGL : public gfx::IndexBufferBase {
-    IndexBufferGL(std::unique_ptr<gfx::IndexBuffer>&& buffer_)
-        : buffer(std::move(buffer_)) {}
-    ~IndexBufferGL() override = default;
-
-    std::unique_ptr<mbgl::gfx::IndexBuffer> buffer;
-};
-
 void DrawableGL::upload(gfx::UploadPass& uploadPass) {
     if (!shader) {
         return;
@@ -218,11 +223,11 @@ void DrawableGL::upload(gfx::UploadPass& uploadPass) {
     }
 }
 
-gfx::ColorMode DrawableGL::makeColorMode(PaintParameters& parameters) const {
+gfx::ColorMode DrawableGL::makeColorMode(const PaintParameters& parameters) const {
     return enableColor ? parameters.colorModeForRenderPass() : gfx::ColorMode::disabled();
 }
 
-gfx::StencilMode DrawableGL::makeStencilMode(PaintParameters& parameters) const {
+gfx::StencilMode DrawableGL::makeStencilMode(const PaintParameters& parameters) const {
     if (enableStencil) {
         if (!is3D && tileID) {
             return parameters.stencilModeForClipping(tileID->toUnwrapped());
@@ -240,20 +245,12 @@ void DrawableGL::uploadTextures() const {
     }
 }
 
-void DrawableGL::bindTextures() const {
+void DrawableGL::recordTextures(CommandList& commands) const {
     int32_t unit = 0;
     for (const auto& pair : textures) {
         if (const auto& tex = pair.second) {
             const auto& location = pair.first;
-            std::static_pointer_cast<gl::Texture2D>(tex)->bind(location, unit++);
-        }
-    }
-}
-
-void DrawableGL::unbindTextures() const {
-    for (const auto& pair : textures) {
-        if (const auto& tex = pair.second) {
-            std::static_pointer_cast<gl::Texture2D>(tex)->unbind();
+            commands.addTexture(static_cast<gl::Texture2D&>(*tex), location, unit++);
         }
     }
 }
@@ -5,7 +5,7 @@ namespace mbgl {
 namespace gl {
 
 IndexBufferResource::~IndexBufferResource() noexcept {
-    auto& stats = buffer.get_deleter().context.renderingStats();
+    auto& stats = allocation.getContext().renderingStats();
     stats.memIndexBuffers -= byteSize;
     assert(stats.memIndexBuffers >= 0);
 }
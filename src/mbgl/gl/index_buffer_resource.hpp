@@ -1,19 +1,24 @@
 #pragma once
 
 #include <mbgl/gfx/index_buffer.hpp>
-#include <mbgl/gl/object.hpp>
+#include <mbgl/gl/buffer_allocator.hpp>
 
 namespace mbgl {
 namespace gl {
 
 class IndexBufferResource : public gfx::IndexBufferResource {
 public:
-    IndexBufferResource(UniqueBuffer&& buffer_, int byteSize_)
-        : buffer(std::move(buffer_)),
+    IndexBufferResource(BufferAllocation&& allocation_, int byteSize_)
+        : allocation(std::move(allocation_)),
           byteSize(byteSize_) {}
     ~IndexBufferResource() noexcept override;
 
-    UniqueBuffer buffer;
+    /// The buffer holding the data, which may be shared with other resources
+    BufferID getBuffer() const { return allocation.getBuffer(); }
+    /// Offset of the data within the buffer
+    std::size_t getByteOffset() const { return allocation.getOffset(); }
+
+    BufferAllocation allocation;
     int byteSize;
 };
 
@@ -10,6 +10,9 @@
 #include <mbgl/shaders/gl/shader_program_gl.hpp>
 #include <mbgl/util/convert.hpp>
 
+#include <algorithm>
+#include <functional>
+
 namespace mbgl {
 namespace gl {
 
@@ -90,10 +93,35 @@ void TileLayerGroupGL::render(RenderOrchestrator&, PaintParameters& parameters)
     const auto debugGroupRender = parameters.encoder->createDebugGroup(label_render.c_str());
 #endif
 
+    drawOrder.clear();
     visitDrawables([&](gfx::Drawable& drawable) {
         if (!drawable.getEnabled() || !drawable.hasRenderPass(parameters.pass)) {
             return;
         }
+        if (isCulled(drawable, parameters)) {
+            context.renderingStats().numCulledDrawables++;
+            return;
+        }
+        drawOrder.push_back(&drawable);
+    });
+
+    // Reordering relies on each tile being clipped to its own stencil value
+    if (!features3d && stencilTiles && !stencilTiles->empty()) {
+        sortByState(drawOrder);
+    }
+
+    renderInOrder(parameters, features3d, stencilMode3d);
+
+    // Drawables leave their vertex array bound for the next one to skip re-binding it
+    context.bindVertexArray = value::BindVertexArray::Default;
+}
+
+void TileLayerGroupGL::renderInOrder(PaintParameters& parameters,
+                                     bool features3d,
+                                     const gfx::StencilMode& stencilMode3d) {
+    auto& context = static_cast<gl::Context&>(parameters.context);
+    for (auto* drawablePtr : drawOrder) {
+        auto& drawable = *drawablePtr;
 
 #if !defined(NDEBUG)
         std::string label_tile;
@@ -117,7 +145,45 @@ void TileLayerGroupGL::render(RenderOrchestrator&, PaintParameters& parameters)
         }
 
         drawable.draw(parameters);
-    });
+    }
+}
+
+namespace {
+// Drawables clipped to their tile by the stencil buffer can't overlap the drawables of other tiles
+bool isTileClipped(const gfx::Drawable& drawable) {
+    return drawable.getTileID() && !drawable.getIs3D() && drawable.getEnableStencil();
+}
+} // namespace
+
+void TileLayerGroupGL::sortByState(std::vector<gfx::Drawable*>& drawables) {
+    // Within each run of tile-clipped drawables, order them by their position among the drawables of
+    // the same tile, and then by shader.  This keeps each tile's own drawables in order, e.g., fills
+    // before outlines, while draws sharing a program and its textures end up next to each other.
+    auto begin = drawables.begin();
+    while (begin != drawables.end()) {
+        if (!isTileClipped(**begin)) {
+            ++begin;
+            continue;
+        }
+        const auto end = std::find_if_not(
+            begin, drawables.end(), [](const gfx::Drawable* drawable) { return isTileClipped(*drawable); });
+
+        tileOrdinals.clear();
+        stateKeys.clear();
+        for (auto it = begin; it != end; ++it) {
+            auto& drawable = **it;
+            stateKeys.push_back({tileOrdinals[*drawable.getTileID()]++, drawable.getShader().get(), &drawable});
+        }
+        std::stable_sort(stateKeys.begin(), stateKeys.end(), [](const StateKey& a, const StateKey& b) {
+            if (a.tileOrdinal != b.tileOrdinal) {
+                return a.tileOrdinal < b.tileOrdinal;
+            }
+            return std::less<const void*>()(a.shader, b.shader);
+        });
+        std::transform(stateKeys.begin(), stateKeys.end(), begin, [](const StateKey& key) { return key.drawable; });
+
+        begin = end;
+    }
 }
 
 LayerGroupGL::LayerGroupGL(int32_t layerIndex_, std::size_t initialCapacity, std::string name_)
@@ -163,6 +229,9 @@ void LayerGroupGL::render(RenderOrchestrator&, PaintParameters& parameters) {
 
         drawable.draw(parameters);
     });
+
+    // Drawables leave their vertex array bound for the next one to skip re-binding it
+    static_cast<gl::Context&>(parameters.context).bindVertexArray = value::BindVertexArray::Default;
 }
 
 } // namespace gl
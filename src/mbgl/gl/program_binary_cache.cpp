@@ -0,0 +1,214 @@
+#include <mbgl/gl/program_binary_cache.hpp>
+#include <mbgl/util/cache_file.hpp>
+#include <mbgl/util/io.hpp>
+#include <mbgl/util/logging.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace mbgl {
+namespace gl {
+
+namespace {
+
+using namespace util::cache_file;
+
+constexpr const char magic[4] = {'M', 'L', 'N', 'P'};
+
+// 64-bit FNV-1a, which, unlike `std::hash`, is stable across builds
+constexpr uint64_t fnvOffsetBasis = 14695981039346656037ull;
+constexpr uint64_t fnvPrime = 1099511628211ull;
+
+void hashAppend(uint64_t& hash, const char* str) {
+    for (; *str; ++str) {
+        hash = (hash ^ static_cast<uint8_t>(*str)) * fnvPrime;
+    }
+    // Separate the parts so that moving text between them changes the hash
+    hash = (hash ^ 0xff) * fnvPrime;
+}
+
+} // namespace
+
+ProgramBinaryCache::ProgramBinaryCache(std::string path_, std::string driver_, std::size_t maxSize_)
+    : path(std::move(path_)),
+      driver(std::move(driver_)),
+      maxSize(maxSize_) {}
+
+uint64_t ProgramBinaryCache::makeKey(const std::initializer_list<const char*>& vertexSource,
+                                     const std::initializer_list<const char*>& fragmentSource,
+                                     const char* location0AttribName) {
+    uint64_t hash = fnvOffsetBasis;
+    for (const char* part : vertexSource) {
+        hashAppend(hash, part);
+    }
+    for (const char* part : fragmentSource) {
+        hashAppend(hash, part);
+    }
+    hashAppend(hash, location0AttribName);
+    return hash;
+}
+
+std::optional<ProgramBinaryCache::Binary> ProgramBinaryCache::get(uint64_t key) {
+    std::lock_guard<std::mutex> lock(mutex);
+    load();
+
+    auto it = binaries.find(key);
+    if (it == binaries.end()) {
+        return std::nullopt;
+    }
+    it->second.lastUse = ++useCount;
+    return it->second.binary;
+}
+
+void ProgramBinaryCache::put(uint64_t key, Binary binary) {
+    std::lock_guard<std::mutex> lock(mutex);
+    load();
+
+    if (binary.data.size() > maxSize) {
+        return;
+    }
+
+    auto& entry = binaries[key];
+    currentSize -= entry.binary.data.size();
+    currentSize += binary.data.size();
+    entry.binary = std::move(binary);
+    entry.lastUse = ++useCount;
+    evict();
+    dirty = true;
+}
+
+void ProgramBinaryCache::remove(uint64_t key) {
+    std::lock_guard<std::mutex> lock(mutex);
+    load();
+
+    if (auto it = binaries.find(key); it != binaries.end()) {
+        currentSize -= it->second.binary.data.size();
+        binaries.erase(it);
+        dirty = true;
+    }
+}
+
+bool ProgramBinaryCache::needsFlush() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return dirty;
+}
+
+std::size_t ProgramBinaryCache::size() {
+    std::lock_guard<std::mutex> lock(mutex);
+    load();
+    return binaries.size();
+}
+
+void ProgramBinaryCache::load() {
+    if (loaded) {
+        return;
+    }
+    loaded = true;
+
+    const std::optional<std::string> data = util::readFile(path);
+    if (!data) {
+        return;
+    }
+
+    if (auto decoded = decode(driver, *data)) {
+        binaries = std::move(*decoded);
+        for (const auto& [key, entry] : binaries) {
+            currentSize += entry.binary.data.size();
+            useCount = std::max(useCount, entry.lastUse);
+        }
+        evict();
+    } else {
+        Log::Info(Event::Shader, "Discarding outdated program binary cache");
+    }
+}
+
+void ProgramBinaryCache::evict() {
+    while (currentSize > maxSize && !binaries.empty()) {
+        const auto oldest = std::min_element(binaries.begin(), binaries.end(), [](const auto& a, const auto& b) {
+            return a.second.lastUse < b.second.lastUse;
+        });
+        currentSize -= oldest->second.binary.data.size();
+        binaries.erase(oldest);
+        dirty = true;
+    }
+}
+
+void ProgramBinaryCache::flush() {
+    // Serializes concurrent flushes, so that an older snapshot can't replace
+    // a newer one.
+    std::lock_guard<std::mutex> flushLock(flushMutex);
+
+    BinaryTable snapshot;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!dirty) {
+            return;
+        }
+        snapshot = binaries;
+        dirty = false;
+    }
+
+    // Other renderers and processes using the same cache path replace the same file
+    const Lock fileLock(path);
+    if (!replace(path, encode(driver, snapshot))) {
+        Log::Warning(Event::Shader, "Can't replace program binary cache");
+    }
+}
+
+// File layout: magic, version and driver, followed by the binary records,
+// least recently used first. Program binaries are opaque, driver-specific data
+// and don't compress well, so they are stored as they are.
+std::string ProgramBinaryCache::encode(const std::string& driver, const BinaryTable& table) {
+    std::vector<BinaryTable::const_iterator> order;
+    order.reserve(table.size());
+    for (auto it = table.begin(); it != table.end(); ++it) {
+        order.push_back(it);
+    }
+    std::sort(order.begin(), order.end(), [](const auto& a, const auto& b) {
+        return a->second.lastUse < b->second.lastUse;
+    });
+
+    std::string out(magic, sizeof(magic));
+    write<uint32_t>(out, version);
+    writeString(out, driver);
+    write<uint32_t>(out, static_cast<uint32_t>(table.size()));
+    for (const auto& it : order) {
+        write<uint64_t>(out, it->first);
+        write<uint32_t>(out, it->second.binary.format);
+        writeString(out, it->second.binary.data);
+    }
+    return out;
+}
+
+std::optional<ProgramBinaryCache::BinaryTable> ProgramBinaryCache::decode(const std::string& driver,
+                                                                          const std::string& data) {
+    if (data.size() < sizeof(magic) || std::memcmp(data.data(), magic, sizeof(magic)) != 0) {
+        return std::nullopt;
+    }
+
+    const std::string body = data.substr(sizeof(magic));
+    Reader reader(body);
+    uint32_t fileVersion = 0;
+    std::string fileDriver;
+    uint32_t count = 0;
+    if (!reader.read(fileVersion) || fileVersion != version || !reader.readString(fileDriver) ||
+        fileDriver != driver || !reader.read(count)) {
+        return std::nullopt;
+    }
+
+    BinaryTable table;
+    for (uint32_t i = 0; i < count; ++i) {
+        uint64_t key = 0;
+        Entry entry;
+        if (!reader.read(key) || !reader.read(entry.binary.format) || !reader.readString(entry.binary.data)) {
+            return std::nullopt;
+        }
+        entry.lastUse = i + 1;
+        table.insert_or_assign(key, std::move(entry));
+    }
+    return table;
+}
+
+} // namespace gl
+} // namespace mbgl
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdint>
+#include <initializer_list>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+
+namespace mbgl {
+namespace gl {
+
+/// Persists linked program binaries (`glGetProgramBinary`) across sessions,
+/// so that shaders don't need to be compiled by the driver on every start.
+///
+/// Programs are keyed by a hash of their complete shader sources, including
+/// the preprocessor defines. The file header records the format version and
+/// the driver the binaries were produced by; a file from a different driver
+/// is ignored and replaced on the next flush. The file is loaded lazily on
+/// first lookup. Lookups and insertions may happen on any thread.
+///
+/// The total size of the binaries is bounded, the least recently used ones are
+/// evicted beyond that. Binaries are written in the order they were last used,
+/// so that the order survives across sessions.
+class ProgramBinaryCache {
+public:
+    static constexpr uint32_t version = 1;
+    static constexpr std::size_t defaultMaxSize = 32 * 1024 * 1024;
+
+    struct Binary {
+        uint32_t format = 0;
+        std::string data;
+    };
+
+    ProgramBinaryCache(std::string path, std::string driver, std::size_t maxSize = defaultMaxSize);
+
+    static uint64_t makeKey(const std::initializer_list<const char*>& vertexSource,
+                            const std::initializer_list<const char*>& fragmentSource,
+                            const char* location0AttribName);
+
+    std::optional<Binary> get(uint64_t key);
+    void put(uint64_t key, Binary);
+
+    /// Forget a binary, e.g., one rejected by the driver
+    void remove(uint64_t key);
+
+    /// Whether binaries were added or removed since the file was last written.
+    /// Lookups alone don't make the file worth rewriting.
+    bool needsFlush();
+
+    /// Writes the cache file if it changed since it was last written
+    void flush();
+
+    std::size_t size();
+
+private:
+    struct Entry {
+        Binary binary;
+        // Higher is more recent
+        uint64_t lastUse = 0;
+    };
+    using BinaryTable = std::map<uint64_t, Entry>;
+
+    void load();
+    /// Drop the least recently used binaries until they fit in `maxSize`, with `mutex` held
+    void evict();
+
+    static std::string encode(const std::string& driver, const BinaryTable&);
+    static std::optional<BinaryTable> decode(const std::string& driver, const std::string& data);
+
+    const std::string path;
+    const std::string driver;
+    const std::size_t maxSize;
+
+    std::mutex mutex;
+    std::mutex flushMutex;
+    BinaryTable binaries;
+    std::size_t currentSize = 0;
+    uint64_t useCount = 0;
+    bool loaded = false;
+    bool dirty = false;
+};
+
+} // namespace gl
+} // namespace mbgl
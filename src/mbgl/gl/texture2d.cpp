@@ -141,43 +141,35 @@ void Texture2D::updateSamplerConfiguration() noexcept {
     glResource.wrapY = samplerState.wrapV;
 }
 
-void Texture2D::bind(int32_t location, int32_t textureUnit) noexcept {
-    using namespace platform;
-
+void Texture2D::bind(int32_t textureUnit) noexcept {
     assert(gfx::MaxActiveTextureUnits > textureUnit);
     if (gfx::MaxActiveTextureUnits <= textureUnit) return;
 
+    auto& binding = context.texture[static_cast<size_t>(textureUnit)];
+    boundTextureUnit = textureUnit;
+    if (binding == getTextureID() && !samplerStateDirty) {
+        // Already bound, don't switch the active unit either
+        context.renderingStats().numElidedBinds++;
+        return;
+    }
+
     // Bind to the texture unit
     context.activeTextureUnit = static_cast<uint8_t>(textureUnit);
-    context.texture[static_cast<size_t>(textureUnit)] = getTextureID();
-    boundTextureUnit = textureUnit;
+    binding = getTextureID();
 
     // Update the sampler state if it was changed after resource creation
     if (samplerStateDirty) {
         updateSamplerConfiguration();
     }
-
-    // Link the bound texture unit with the requested sampler in the active shader
-    glUniform1i(location, textureUnit);
-    boundLocation = location;
 }
 
 void Texture2D::unbind() noexcept {
-    using namespace platform;
-
     // Unlink the texture from the last used texture unit
     if (boundTextureUnit != -1) {
         context.activeTextureUnit = boundTextureUnit;
         context.texture[static_cast<size_t>(boundTextureUnit)] = 0;
         boundTextureUnit = -1;
     }
-
-    // And clear the uniform value linking a sampler to the texture unit
-    // Default back to GL_TEXTURE0
-    if (boundLocation != -1) {
-        glUniform1i(boundLocation, 0);
-        boundLocation = -1;
-    }
 }
 
 void Texture2D::upload(const void* pixelData, const Size& size_) noexcept {
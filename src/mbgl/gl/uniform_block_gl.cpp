@@ -1,26 +1,21 @@
 
 #include <mbgl/gl/uniform_block_gl.hpp>
 #include <mbgl/gl/uniform_buffer_gl.hpp>
-#include <mbgl/gl/defines.hpp>
-#include <mbgl/platform/gl_functions.hpp>
 
 #include <cassert>
 
 namespace mbgl {
 namespace gl {
 
-using namespace platform;
-
 void UniformBlockGL::bindBuffer(const gfx::UniformBuffer& uniformBuffer) {
     assert(size == uniformBuffer.getSize());
-    GLint binding = index;
     const auto& uniformBufferGL = static_cast<const UniformBufferGL&>(uniformBuffer);
-    MBGL_CHECK_ERROR(glBindBufferBase(GL_UNIFORM_BUFFER, binding, uniformBufferGL.getID()));
+    uniformBufferGL.bind(index);
 }
 
 void UniformBlockGL::unbindBuffer() {
-    GLint binding = index;
-    MBGL_CHECK_ERROR(glBindBufferBase(GL_UNIFORM_BUFFER, binding, 0));
+    // Bindings are tracked by the context, see `Context::bindUniformBufferRange`, and left in place
+    // to be replaced by the next draw, so that a following draw using the same range can skip binding it.
 }
 
 } // namespace gl
@@ -1,40 +1,209 @@
 #include <mbgl/gl/uniform_buffer_gl.hpp>
+#include <mbgl/gl/context.hpp>
 #include <mbgl/gl/defines.hpp>
 #include <mbgl/platform/gl_functions.hpp>
-#include <mbgl/util/compression.hpp>
 #include <mbgl/util/logging.hpp>
 
+#include <algorithm>
 #include <cassert>
+#include <cstring>
 
 namespace mbgl {
 namespace gl {
 
 using namespace platform;
 
-UniformBufferGL::UniformBufferGL(const void* data_, std::size_t size_)
+namespace {
+std::size_t getUniformBufferOffsetAlignment() {
+    GLint value = 0;
+    MBGL_CHECK_ERROR(glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &value));
+    return std::max<std::size_t>(value, 16);
+}
+
+// Initial arena size, grown by doubling
+constexpr std::size_t initialArenaSize = 64 * 1024;
+} // namespace
+
+UniformBufferAllocator::UniformBufferAllocator(Context& context_)
+    : context(context_),
+      alignment(getUniformBufferOffsetAlignment()) {}
+
+// GL buffers are deleted by `Context::reset`, the GL context may be gone here
+UniformBufferAllocator::~UniformBufferAllocator() = default;
+
+std::size_t UniformBufferAllocator::allocate(std::size_t size) {
+    const std::size_t alignedSize = std::max<std::size_t>((size + alignment - 1) / alignment * alignment, alignment);
+
+    if (auto it = freeBlocks.find(alignedSize); it != freeBlocks.end() && !it->second.empty()) {
+        const std::size_t offset = it->second.back();
+        it->second.pop_back();
+        return offset;
+    }
+
+    const std::size_t offset = used;
+    used += alignedSize;
+    if (used > shadow.size()) {
+        std::size_t capacity = std::max(shadow.size(), initialArenaSize);
+        while (capacity < used) {
+            capacity *= 2;
+        }
+        shadow.resize(capacity);
+    }
+    return offset;
+}
+
+void UniformBufferAllocator::release(std::size_t offset, std::size_t size) {
+    const std::size_t alignedSize = std::max<std::size_t>((size + alignment - 1) / alignment * alignment, alignment);
+    freeBlocks[alignedSize].push_back(offset);
+}
+
+bool UniformBufferAllocator::write(std::size_t offset, const void* data, std::size_t size) {
+    assert(offset + size <= used);
+    uint8_t* target = shadow.data() + offset;
+    if (data) {
+        if (std::memcmp(target, data, size) == 0) {
+            return false;
+        }
+        std::memcpy(target, data, size);
+    } else {
+        std::memset(target, 0, size);
+    }
+
+    addPending({offset, offset + size});
+    return true;
+}
+
+void UniformBufferAllocator::addPending(Range written) {
+    // Every buffer of the ring needs this range on its next upload
+    for (auto& ranges : pending) {
+        auto it = std::lower_bound(
+            ranges.begin(), ranges.end(), written.begin, [](const Range& range, std::size_t begin) {
+                return range.begin < begin;
+            });
+        it = ranges.insert(it, written);
+
+        // Join the neighbours close enough to upload along with it
+        if (it != ranges.begin() && std::prev(it)->end + maxRangeGap >= it->begin) {
+            std::prev(it)->end = std::max(std::prev(it)->end, it->end);
+            it = std::prev(ranges.erase(it));
+        }
+        while (std::next(it) != ranges.end() && it->end + maxRangeGap >= std::next(it)->begin) {
+            it->end = std::max(it->end, std::next(it)->end);
+            ranges.erase(std::next(it));
+        }
+
+        if (ranges.size() > maxPendingRanges) {
+            // Too many separate uploads, join the two closest ranges instead
+            auto closest = ranges.begin();
+            for (auto range = ranges.begin(); std::next(range) != ranges.end(); ++range) {
+                if (std::next(range)->begin - range->end < std::next(closest)->begin - closest->end) {
+                    closest = range;
+                }
+            }
+            closest->end = std::next(closest)->end;
+            ranges.erase(std::next(closest));
+        }
+    }
+}
+
+BufferID UniformBufferAllocator::flush() {
+    BufferID& buffer = buffers[current];
+    std::vector<Range>& ranges = pending[current];
+
+    if (bufferSizes[current] < shadow.size()) {
+        // The arena grew, re-create the buffer with the full contents
+        if (!buffer) {
+            MBGL_CHECK_ERROR(glGenBuffers(1, &buffer));
+        }
+        MBGL_CHECK_ERROR(glBindBuffer(GL_UNIFORM_BUFFER, buffer));
+        MBGL_CHECK_ERROR(glBufferData(GL_UNIFORM_BUFFER, shadow.size(), shadow.data(), GL_DYNAMIC_DRAW));
+        bufferSizes[current] = shadow.size();
+        ranges.clear();
+
+        auto& stats = context.renderingStats();
+        stats.numUniformUploads++;
+        stats.uniformUpdateBytes += shadow.size();
+    } else if (!ranges.empty()) {
+        MBGL_CHECK_ERROR(glBindBuffer(GL_UNIFORM_BUFFER, buffer));
+        auto& stats = context.renderingStats();
+        for (const auto& range : ranges) {
+            MBGL_CHECK_ERROR(glBufferSubData(
+                GL_UNIFORM_BUFFER, range.begin, range.end - range.begin, shadow.data() + range.begin));
+            stats.numUniformUploads++;
+            stats.uniformUpdateBytes += range.end - range.begin;
+        }
+        ranges.clear();
+    }
+
+    return buffer;
+}
+
+void UniformBufferAllocator::endFrame() {
+    current = (current + 1) % ringSize;
+}
+
+void UniformBufferAllocator::releaseBuffers() {
+    for (std::size_t i = 0; i < ringSize; ++i) {
+        if (buffers[i]) {
+            MBGL_CHECK_ERROR(glDeleteBuffers(1, &buffers[i]));
+            buffers[i] = 0;
+        }
+        bufferSizes[i] = 0;
+        pending[i].clear();
+    }
+}
+
+UniformBufferGL::UniformBufferGL(const void* data_,
+                                 std::size_t size_,
+                                 const std::shared_ptr<UniformBufferAllocator>& allocator_)
     : UniformBuffer(size_),
-      hash(util::crc32(data_, size_)) {
-    MBGL_CHECK_ERROR(glGenBuffers(1, &id));
-    MBGL_CHECK_ERROR(glBindBuffer(GL_UNIFORM_BUFFER, id));
-    MBGL_CHECK_ERROR(glBufferData(GL_UNIFORM_BUFFER, size, data_, GL_DYNAMIC_DRAW));
-    MBGL_CHECK_ERROR(glBindBuffer(GL_UNIFORM_BUFFER, 0));
+      allocator(allocator_),
+      offset(allocator_->allocate(size_)) {
+    allocator_->write(offset, data_, size);
+
+    auto& stats = allocator_->getContext().renderingStats();
+    stats.numUniformBuffers++;
+    stats.memUniformBuffers += static_cast<int>(size);
 }
 
 UniformBufferGL::UniformBufferGL(const UniformBufferGL& other)
     : UniformBuffer(other),
-      hash(other.hash) {
-    MBGL_CHECK_ERROR(glGenBuffers(1, &id));
-    MBGL_CHECK_ERROR(glCopyBufferSubData(other.id, id, 0, 0, size));
-    MBGL_CHECK_ERROR(glBindBuffer(GL_COPY_READ_BUFFER, other.id));
-    MBGL_CHECK_ERROR(glBindBuffer(GL_COPY_WRITE_BUFFER, id));
-    MBGL_CHECK_ERROR(glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, size));
+      allocator(other.allocator),
+      offset(0) {
+    const auto arena = allocator.lock();
+    assert(arena);
+    offset = arena->allocate(size);
+    arena->write(offset, arena->read(other.offset), size);
+
+    auto& stats = arena->getContext().renderingStats();
+    stats.numUniformBuffers++;
+    stats.memUniformBuffers += static_cast<int>(size);
 }
 
+UniformBufferGL::UniformBufferGL(UniformBufferGL&& other)
+    : UniformBuffer(std::move(other)),
+      allocator(std::move(other.allocator)),
+      offset(other.offset) {}
+
 UniformBufferGL::~UniformBufferGL() {
-    if (id) {
-        MBGL_CHECK_ERROR(glDeleteBuffers(1, &id));
-        id = 0;
+    // Nothing to release if the context, and the arena with it, is already gone
+    if (const auto arena = allocator.lock()) {
+        arena->release(offset, size);
+
+        auto& stats = arena->getContext().renderingStats();
+        stats.numUniformBuffers--;
+        stats.memUniformBuffers -= static_cast<int>(size);
+    }
+}
+
+void UniformBufferGL::bind(int binding) const {
+    const auto arena = allocator.lock();
+    assert(arena);
+    if (!arena) {
+        return;
     }
+    const BufferID id = arena->flush();
+    arena->getContext().bindUniformBufferRange(static_cast<uint32_t>(binding), id, offset, size);
 }
 
 void UniformBufferGL::update(const void* data_, std::size_t size_) {
@@ -46,12 +215,11 @@ void UniformBufferGL::update(const void* data_, std::size_t size_) {
         return;
     }
 
-    const uint32_t newHash = util::crc32(data_, size_);
-    if (newHash != hash) {
-        hash = newHash;
-        MBGL_CHECK_ERROR(glBindBuffer(GL_UNIFORM_BUFFER, id));
-        MBGL_CHECK_ERROR(glBufferSubData(GL_UNIFORM_BUFFER, 0, size_, data_));
-        MBGL_CHECK_ERROR(glBindBuffer(GL_UNIFORM_BUFFER, 0));
+    const auto arena = allocator.lock();
+    assert(arena);
+    if (arena && arena->write(offset, data_, size_)) {
+        // Uploaded to the GPU on the next binding, see `UniformBufferAllocator::flush`
+        arena->getContext().renderingStats().numUniformUpdates++;
     }
 }
 
@@ -2,6 +2,7 @@
 
 #include <mbgl/gfx/vertex_buffer.hpp>
 #include <mbgl/gfx/vertex_vector.hpp>
+#include <mbgl/gl/buffer_allocator.hpp>
 #include <mbgl/gl/context.hpp>
 #include <mbgl/gl/enum.hpp>
 #include <mbgl/gl/defines.hpp>
@@ -31,44 +32,30 @@ std::unique_ptr<gfx::VertexBufferResource> UploadPass::createVertexBufferResourc
                                                                                   const std::size_t size,
                                                                                   const gfx::BufferUsageType usage,
                                                                                   bool /*persistent*/) {
-    BufferID id = 0;
-    MBGL_CHECK_ERROR(glGenBuffers(1, &id));
-    commandEncoder.context.renderingStats().numBuffers++;
-    commandEncoder.context.renderingStats().memVertexBuffers += static_cast<int>(size);
-    // NOLINTNEXTLINE(performance-move-const-arg)
-    UniqueBuffer result{std::move(id), {commandEncoder.context}};
-    commandEncoder.context.vertexBuffer = result;
-    MBGL_CHECK_ERROR(glBufferData(GL_ARRAY_BUFFER, size, data, Enum<gfx::BufferUsageType>::to(usage)));
-    return std::make_unique<gl::VertexBufferResource>(std::move(result), static_cast<int>(size));
+    auto& context = commandEncoder.context;
+    context.renderingStats().memVertexBuffers += static_cast<int>(size);
+    auto allocation = context.getBufferAllocator(BufferAllocator::Target::Vertex).allocate(data, size, usage);
+    return std::make_unique<gl::VertexBufferResource>(std::move(allocation), static_cast<int>(size));
 }
 
 void UploadPass::updateVertexBufferResource(gfx::VertexBufferResource& resource, const void* data, std::size_t size) {
-    commandEncoder.context.vertexBuffer = static_cast<gl::VertexBufferResource&>(resource).buffer;
-    MBGL_CHECK_ERROR(glBufferSubData(GL_ARRAY_BUFFER, 0, size, data));
+    commandEncoder.context.getBufferAllocator(BufferAllocator::Target::Vertex)
+        .update(static_cast<gl::VertexBufferResource&>(resource).allocation, data, size);
 }
 
 std::unique_ptr<gfx::IndexBufferResource> UploadPass::createIndexBufferResource(const void* data,
                                                                                 std::size_t size,
                                                                                 const gfx::BufferUsageType usage,
                                                                                 bool /*persistent*/) {
-    BufferID id = 0;
-    MBGL_CHECK_ERROR(glGenBuffers(1, &id));
-    commandEncoder.context.renderingStats().numBuffers++;
-    commandEncoder.context.renderingStats().memIndexBuffers += static_cast<int>(size);
-    // NOLINTNEXTLINE(performance-move-const-arg)
-    UniqueBuffer result{std::move(id), {commandEncoder.context}};
-    commandEncoder.context.bindVertexArray = 0;
-    commandEncoder.context.globalVertexArrayState.indexBuffer = result;
-    MBGL_CHECK_ERROR(glBufferData(GL_ELEMENT_ARRAY_BUFFER, size, data, Enum<gfx::BufferUsageType>::to(usage)));
-    return std::make_unique<gl::IndexBufferResource>(std::move(result), static_cast<int>(size));
+    auto& context = commandEncoder.context;
+    context.renderingStats().memIndexBuffers += static_cast<int>(size);
+    auto allocation = context.getBufferAllocator(BufferAllocator::Target::Index).allocate(data, size, usage);
+    return std::make_unique<gl::IndexBufferResource>(std::move(allocation), static_cast<int>(size));
 }
 
 void UploadPass::updateIndexBufferResource(gfx::IndexBufferResource& resource, const void* data, std::size_t size) {
-    // Be sure to unbind any existing vertex array object before binding the
-    // index buffer so that we don't mess up another VAO
-    commandEncoder.context.bindVertexArray = 0;
-    commandEncoder.context.globalVertexArrayState.indexBuffer = static_cast<gl::IndexBufferResource&>(resource).buffer;
-    MBGL_CHECK_ERROR(glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, size, data));
+    commandEncoder.context.getBufferAllocator(BufferAllocator::Target::Index)
+        .update(static_cast<gl::IndexBufferResource&>(resource).allocation, data, size);
 }
 
 std::unique_ptr<gfx::TextureResource> UploadPass::createTextureResource(const Size size,
@@ -484,7 +484,8 @@ GLint components(const gfx::AttributeDataType type) {
 
 void VertexAttribute::Set(const Type& binding, Context& context, AttributeLocation location) {
     if (binding && binding->vertexBufferResource) {
-        context.vertexBuffer = reinterpret_cast<const gl::VertexBufferResource&>(*binding->vertexBufferResource).buffer;
+        const auto& resource = reinterpret_cast<const gl::VertexBufferResource&>(*binding->vertexBufferResource);
+        context.vertexBuffer = resource.getBuffer();
         MBGL_CHECK_ERROR(glEnableVertexAttribArray(location));
         MBGL_CHECK_ERROR(glVertexAttribPointer(
             location,
@@ -492,7 +493,8 @@ void VertexAttribute::Set(const Type& binding, Context& context, AttributeLocati
             vertexType(binding->attribute.dataType),
             static_cast<GLboolean>(false),
             static_cast<GLsizei>(binding->vertexStride),
-            reinterpret_cast<GLvoid*>(binding->attribute.offset + (binding->vertexStride * binding->vertexOffset))));
+            reinterpret_cast<GLvoid*>(resource.getByteOffset() + binding->attribute.offset +
+                                      (binding->vertexStride * binding->vertexOffset))));
     } else {
         MBGL_CHECK_ERROR(glDisableVertexAttribArray(location));
     }
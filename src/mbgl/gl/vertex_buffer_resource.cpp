@@ -5,7 +5,7 @@ namespace mbgl {
 namespace gl {
 
 VertexBufferResource::~VertexBufferResource() noexcept {
-    auto& stats = buffer.get_deleter().context.renderingStats();
+    auto& stats = allocation.getContext().renderingStats();
     stats.memVertexBuffers -= byteSize;
     assert(stats.memVertexBuffers >= 0);
 }
@@ -1,19 +1,24 @@
 #pragma once
 
 #include <mbgl/gfx/vertex_buffer.hpp>
-#include <mbgl/gl/object.hpp>
+#include <mbgl/gl/buffer_allocator.hpp>
 
 namespace mbgl {
 namespace gl {
 
 class VertexBufferResource : public gfx::VertexBufferResource {
 public:
-    VertexBufferResource(UniqueBuffer&& buffer_, int byteSize_)
-        : buffer(std::move(buffer_)),
+    VertexBufferResource(BufferAllocation&& allocation_, int byteSize_)
+        : allocation(std::move(allocation_)),
           byteSize(byteSize_) {}
     ~VertexBufferResource() noexcept override;
 
-    UniqueBuffer buffer;
+    /// The buffer holding the data, which may be shared with other resources
+    BufferID getBuffer() const { return allocation.getBuffer(); }
+    /// Offset of the data within the buffer
+    std::size_t getByteOffset() const { return allocation.getOffset(); }
+
+    BufferAllocation allocation;
     int byteSize;
 };
 
@@ -33,21 +33,23 @@ SymbolInstanceSharedData::SymbolInstanceSharedData(GeometryCoordinates line_,
     : line(std::move(line_)) {
     // Create the quads used for rendering the icon and glyphs.
     if (shapedIcon) {
-        iconQuads = getIconQuads(*shapedIcon, iconRotation, iconType, hasIconTextFit);
+        iconQuads = packSymbolQuads(getIconQuads(*shapedIcon, iconRotation, iconType, hasIconTextFit));
         if (verticallyShapedIcon) {
-            verticalIconQuads = getIconQuads(*verticallyShapedIcon, iconRotation, iconType, hasIconTextFit);
+            verticalIconQuads = packSymbolQuads(
+                getIconQuads(*verticallyShapedIcon, iconRotation, iconType, hasIconTextFit));
         }
     }
 
     bool singleLineInitialized = false;
-    const auto initHorizontalGlyphQuads = [&](SymbolQuads& quads, const Shaping& shaping) {
+    const auto initHorizontalGlyphQuads = [&](PackedSymbolQuads& quads, const Shaping& shaping) {
         if (!shapedTextOrientations.singleLine) {
-            quads = getGlyphQuads(shaping, textOffset, layout, textPlacement, imageMap, allowVerticalPlacement);
+            quads = packSymbolQuads(
+                getGlyphQuads(shaping, textOffset, layout, textPlacement, imageMap, allowVerticalPlacement));
             return;
         }
         if (!singleLineInitialized) {
-            rightJustifiedGlyphQuads = getGlyphQuads(
-                shaping, textOffset, layout, textPlacement, imageMap, allowVerticalPlacement);
+            rightJustifiedGlyphQuads = packSymbolQuads(
+                getGlyphQuads(shaping, textOffset, layout, textPlacement, imageMap, allowVerticalPlacement));
             singleLineInitialized = true;
         }
     };
@@ -65,8 +67,8 @@ SymbolInstanceSharedData::SymbolInstanceSharedData(GeometryCoordinates line_,
     }
 
     if (shapedTextOrientations.vertical) {
-        verticalGlyphQuads = getGlyphQuads(
-            shapedTextOrientations.vertical, textOffset, layout, textPlacement, imageMap, allowVerticalPlacement);
+        verticalGlyphQuads = packSymbolQuads(getGlyphQuads(
+            shapedTextOrientations.vertical, textOffset, layout, textPlacement, imageMap, allowVerticalPlacement));
     }
 }
 
@@ -167,27 +169,27 @@ const GeometryCoordinates& SymbolInstance::line() const {
     return sharedData->line;
 }
 
-const SymbolQuads& SymbolInstance::rightJustifiedGlyphQuads() const {
+const PackedSymbolQuads& SymbolInstance::rightJustifiedGlyphQuads() const {
     assert(sharedData);
     return sharedData->rightJustifiedGlyphQuads;
 }
 
-const SymbolQuads& SymbolInstance::leftJustifiedGlyphQuads() const {
+const PackedSymbolQuads& SymbolInstance::leftJustifiedGlyphQuads() const {
     assert(sharedData);
     return sharedData->leftJustifiedGlyphQuads;
 }
 
-const SymbolQuads& SymbolInstance::centerJustifiedGlyphQuads() const {
+const PackedSymbolQuads& SymbolInstance::centerJustifiedGlyphQuads() const {
     assert(sharedData);
     return sharedData->centerJustifiedGlyphQuads;
 }
 
-const SymbolQuads& SymbolInstance::verticalGlyphQuads() const {
+const PackedSymbolQuads& SymbolInstance::verticalGlyphQuads() const {
     assert(sharedData);
     return sharedData->verticalGlyphQuads;
 }
 
-const std::optional<SymbolQuads>& SymbolInstance::iconQuads() const {
+const std::optional<PackedSymbolQuads>& SymbolInstance::iconQuads() const {
     assert(sharedData);
     return sharedData->iconQuads;
 }
@@ -204,7 +206,7 @@ bool SymbolInstance::hasSdfIcon() const {
     return static_cast<bool>(symbolContent & SymbolContent::IconSDF);
 }
 
-const std::optional<SymbolQuads>& SymbolInstance::verticalIconQuads() const {
+const std::optional<PackedSymbolQuads>& SymbolInstance::verticalIconQuads() const {
     assert(sharedData);
     return sharedData->verticalIconQuads;
 }
@@ -44,12 +44,12 @@ struct SymbolInstanceSharedData {
     bool empty() const;
     GeometryCoordinates line;
     // Note: When singleLine == true, only `rightJustifiedGlyphQuads` is populated.
-    SymbolQuads rightJustifiedGlyphQuads;
-    SymbolQuads centerJustifiedGlyphQuads;
-    SymbolQuads leftJustifiedGlyphQuads;
-    SymbolQuads verticalGlyphQuads;
-    std::optional<SymbolQuads> iconQuads;
-    std::optional<SymbolQuads> verticalIconQuads;
+    PackedSymbolQuads rightJustifiedGlyphQuads;
+    PackedSymbolQuads centerJustifiedGlyphQuads;
+    PackedSymbolQuads leftJustifiedGlyphQuads;
+    PackedSymbolQuads verticalGlyphQuads;
+    std::optional<PackedSymbolQuads> iconQuads;
+    std::optional<PackedSymbolQuads> verticalIconQuads;
 };
 
 class SymbolInstance {
@@ -79,15 +79,15 @@ public:
 
     std::optional<size_t> getDefaultHorizontalPlacedTextIndex() const;
     const GeometryCoordinates& line() const;
-    const SymbolQuads& rightJustifiedGlyphQuads() const;
-    const SymbolQuads& leftJustifiedGlyphQuads() const;
-    const SymbolQuads& centerJustifiedGlyphQuads() const;
-    const SymbolQuads& verticalGlyphQuads() const;
+    const PackedSymbolQuads& rightJustifiedGlyphQuads() const;
+    const PackedSymbolQuads& leftJustifiedGlyphQuads() const;
+    const PackedSymbolQuads& centerJustifiedGlyphQuads() const;
+    const PackedSymbolQuads& verticalGlyphQuads() const;
     bool hasText() const;
     bool hasIcon() const;
     bool hasSdfIcon() const;
-    const std::optional<SymbolQuads>& iconQuads() const;
-    const std::optional<SymbolQuads>& verticalIconQuads() const;
+    const std::optional<PackedSymbolQuads>& iconQuads() const;
+    const std::optional<PackedSymbolQuads>& verticalIconQuads() const;
     void releaseSharedData();
 
 private:
@@ -818,7 +818,9 @@ void SymbolLayout::createBucket(const ImagePositions&,
         if (hasIcon) {
             const Range<float> sizeData = bucket->iconSizeBinder->getVertexSizeData(feature);
             auto& iconBuffer = symbolInstance.hasSdfIcon() ? bucket->sdfIcon : bucket->icon;
-            const auto placeIcon = [&](const SymbolQuads& iconQuads, auto& index, const WritingModeType writingMode) {
+            const auto placeIcon = [&](const PackedSymbolQuads& iconQuads,
+                                       auto& index,
+                                       const WritingModeType writingMode) {
                 iconBuffer.placedSymbols.emplace_back(symbolInstance.anchor.point,
                                                       symbolInstance.anchor.segment.value_or(0u),
                                                       sizeData.min,
@@ -942,7 +944,7 @@ std::size_t SymbolLayout::addSymbolGlyphQuads(SymbolBucket& bucket,
                                               const SymbolFeature& feature,
                                               WritingModeType writingMode,
                                               std::optional<size_t>& placedIndex,
-                                              const SymbolQuads& glyphQuads,
+                                              const PackedSymbolQuads& glyphQuads,
                                               const CanonicalTileID& canonical,
                                               std::optional<std::size_t> lastAddedSection) {
     const Range<float> sizeData = bucket.textSizeBinder->getVertexSizeData(feature);
@@ -985,7 +987,7 @@ std::size_t SymbolLayout::addSymbolGlyphQuads(SymbolBucket& bucket,
 
 size_t SymbolLayout::addSymbol(SymbolBucket::Buffer& buffer,
                                const Range<float> sizeData,
-                               const SymbolQuad& symbol,
+                               const PackedSymbolQuad& symbol,
                                const Anchor& labelAnchor,
                                PlacedSymbol& placedSymbol,
                                float sortKey) {
@@ -1012,11 +1014,11 @@ size_t SymbolLayout::addSymbol(SymbolBucket::Buffer& buffer,
     assert(segment.vertexLength <= std::numeric_limits<uint16_t>::max());
     auto index = static_cast<uint16_t>(segment.vertexLength);
 
-    // coordinates (2 triangles)
+    // coordinates (2 triangles), the quad is already in the fixed-point
+    // layout vertex encoding
     auto& vertices = buffer.vertices();
     vertices.emplace_back(SymbolSDFIconProgram::layoutVertex(labelAnchor.point,
                                                              tl,
-                                                             symbol.glyphOffset.y,
                                                              tex.x,
                                                              tex.y,
                                                              sizeData,
@@ -1025,7 +1027,6 @@ size_t SymbolLayout::addSymbol(SymbolBucket::Buffer& buffer,
                                                              minFontScale));
     vertices.emplace_back(SymbolSDFIconProgram::layoutVertex(labelAnchor.point,
                                                              tr,
-                                                             symbol.glyphOffset.y,
                                                              tex.x + tex.w,
                                                              tex.y,
                                                              sizeData,
@@ -1034,7 +1035,6 @@ size_t SymbolLayout::addSymbol(SymbolBucket::Buffer& buffer,
                                                              minFontScale));
     vertices.emplace_back(SymbolSDFIconProgram::layoutVertex(labelAnchor.point,
                                                              bl,
-                                                             symbol.glyphOffset.y,
                                                              tex.x,
                                                              tex.y + tex.h,
                                                              sizeData,
@@ -1043,7 +1043,6 @@ size_t SymbolLayout::addSymbol(SymbolBucket::Buffer& buffer,
                                                              minFontScale));
     vertices.emplace_back(SymbolSDFIconProgram::layoutVertex(labelAnchor.point,
                                                              br,
-                                                             symbol.glyphOffset.y,
                                                              tex.x + tex.w,
                                                              tex.y + tex.h,
                                                              sizeData,
@@ -1073,14 +1072,14 @@ size_t SymbolLayout::addSymbol(SymbolBucket::Buffer& buffer,
     segment.vertexLength += vertexLength;
     segment.indexLength += 6;
 
-    placedSymbol.glyphOffsets.push_back(symbol.glyphOffset.x);
+    placedSymbol.glyphOffsets.push_back(symbol.glyphOffsetX);
 
     return index;
 }
 
 size_t SymbolLayout::addSymbols(SymbolBucket::Buffer& buffer,
                                 const Range<float> sizeData,
-                                const SymbolQuads& symbols,
+                                const PackedSymbolQuads& symbols,
                                 const Anchor& labelAnchor,
                                 PlacedSymbol& placedSymbol,
                                 float sortKey) {
@@ -85,13 +85,13 @@ private:
     // Adds placed items to the buffer.
     size_t addSymbol(SymbolBucket::Buffer&,
                      Range<float> sizeData,
-                     const SymbolQuad&,
+                     const PackedSymbolQuad&,
                      const Anchor& labelAnchor,
                      PlacedSymbol& placedSymbol,
                      float sortKey);
     size_t addSymbols(SymbolBucket::Buffer&,
                       Range<float> sizeData,
-                      const SymbolQuads&,
+                      const PackedSymbolQuads&,
                       const Anchor& labelAnchor,
                       PlacedSymbol& placedSymbol,
                       float sortKey);
@@ -103,7 +103,7 @@ private:
                                     const SymbolFeature&,
                                     WritingModeType,
                                     std::optional<size_t>& placedIndex,
-                                    const SymbolQuads&,
+                                    const PackedSymbolQuads&,
                                     const CanonicalTileID& canonical,
                                     std::optional<std::size_t> lastAddedSection = std::nullopt);
 
@@ -114,6 +114,53 @@ PointAndCameraDistance project(const Point<float>& point, const mat4& matrix) {
     return {{static_cast<float>(pos[0] / pos[3]), static_cast<float>(pos[1] / pos[3])}, static_cast<float>(pos[3])};
 }
 
+void projectPoints(const GeometryCoordinates& points,
+                   const std::size_t begin,
+                   const std::size_t end,
+                   const mat4& m,
+                   PointAndCameraDistance* out) {
+    constexpr std::size_t batchSize = ProjectedLineCache::BatchSize;
+    std::array<double, batchSize> xs;
+    std::array<double, batchSize> ys;
+    std::array<double, batchSize> ws;
+
+    for (std::size_t batchBegin = begin; batchBegin < end; batchBegin += batchSize) {
+        const std::size_t count = std::min(batchSize, end - batchBegin);
+        // z = 0 and w = 1 for all points, so only the x, y and translation
+        // columns of the matrix contribute.
+        for (std::size_t i = 0; i < count; ++i) {
+            const double x = points[batchBegin + i].x;
+            const double y = points[batchBegin + i].y;
+            xs[i] = m[0] * x + m[4] * y + m[12];
+            ys[i] = m[1] * x + m[5] * y + m[13];
+            ws[i] = m[3] * x + m[7] * y + m[15];
+        }
+        for (std::size_t i = 0; i < count; ++i) {
+            out[batchBegin - begin + i] = {{static_cast<float>(xs[i] / ws[i]), static_cast<float>(ys[i] / ws[i])},
+                                           static_cast<float>(ws[i])};
+        }
+    }
+}
+
+void ProjectedLineCache::reset(const GeometryCoordinates& line_, const mat4& matrix_) {
+    line = &line_;
+    matrix = matrix_;
+    projected.resize(line_.size());
+    projectedBatches.assign((line_.size() + BatchSize - 1) / BatchSize, false);
+}
+
+const PointAndCameraDistance& ProjectedLineCache::get(std::size_t index) {
+    assert(line && index < line->size());
+    const std::size_t batch = index / BatchSize;
+    if (!projectedBatches[batch]) {
+        const std::size_t begin = batch * BatchSize;
+        const std::size_t end = std::min(begin + BatchSize, line->size());
+        projectPoints(*line, begin, end, matrix, &projected[begin]);
+        projectedBatches[batch] = true;
+    }
+    return projected[index];
+}
+
 float evaluateSizeForFeature(const ZoomEvaluatedSize& zoomEvaluatedSize, const PlacedSymbol& placedSymbol) {
     if (zoomEvaluatedSize.isFeatureConstant) {
         return zoomEvaluatedSize.size;
@@ -182,10 +229,11 @@ std::optional<PlacedGlyph> placeGlyphAlongLine(const float offsetX,
                                                const Point<float>& projectedAnchorPoint,
                                                const Point<float>& tileAnchorPoint,
                                                const uint16_t anchorSegment,
-                                               const GeometryCoordinates& line,
+                                               ProjectedLineCache& projectedLine,
                                                const std::vector<float>& tileDistances,
-                                               const mat4& labelPlaneMatrix,
                                                const bool returnTileDistance) {
+    const GeometryCoordinates& line = projectedLine.getLine();
+    const mat4& labelPlaneMatrix = projectedLine.getMatrix();
     const float combinedOffsetX = flip ? offsetX - lineOffsetX : offsetX + lineOffsetX;
 
     int16_t dir = combinedOffsetX > 0 ? 1 : -1;
@@ -218,7 +266,7 @@ std::optional<PlacedGlyph> placeGlyphAlongLine(const float offsetX,
         }
 
         prev = current;
-        PointAndCameraDistance projection = project(convertPoint<float>(line.at(currentIndex)), labelPlaneMatrix);
+        const PointAndCameraDistance& projection = projectedLine.get(currentIndex);
         if (projection.second > 0) {
             current = projection.first;
         } else {
@@ -263,6 +311,28 @@ std::optional<std::pair<PlacedGlyph, PlacedGlyph>> placeFirstAndLastGlyph(const
                                                                           const PlacedSymbol& symbol,
                                                                           const mat4& labelPlaneMatrix,
                                                                           const bool returnTileDistance) {
+    ProjectedLineCache projectedLine;
+    projectedLine.reset(symbol.line, labelPlaneMatrix);
+    return placeFirstAndLastGlyph(fontScale,
+                                  lineOffsetX,
+                                  lineOffsetY,
+                                  flip,
+                                  anchorPoint,
+                                  tileAnchorPoint,
+                                  symbol,
+                                  projectedLine,
+                                  returnTileDistance);
+}
+
+std::optional<std::pair<PlacedGlyph, PlacedGlyph>> placeFirstAndLastGlyph(const float fontScale,
+                                                                          const float lineOffsetX,
+                                                                          const float lineOffsetY,
+                                                                          const bool flip,
+                                                                          const Point<float>& anchorPoint,
+                                                                          const Point<float>& tileAnchorPoint,
+                                                                          const PlacedSymbol& symbol,
+                                                                          ProjectedLineCache& projectedLine,
+                                                                          const bool returnTileDistance) {
     if (symbol.glyphOffsets.empty()) {
         assert(false);
         return {};
@@ -279,9 +349,8 @@ std::optional<std::pair<PlacedGlyph, PlacedGlyph>> placeFirstAndLastGlyph(const
                                                                       anchorPoint,
                                                                       tileAnchorPoint,
                                                                       static_cast<uint16_t>(symbol.segment),
-                                                                      symbol.line,
+                                                                      projectedLine,
                                                                       symbol.tileDistances,
-                                                                      labelPlaneMatrix,
                                                                       returnTileDistance);
     if (!firstPlacedGlyph) return {};
 
@@ -292,9 +361,8 @@ std::optional<std::pair<PlacedGlyph, PlacedGlyph>> placeFirstAndLastGlyph(const
                                                                      anchorPoint,
                                                                      tileAnchorPoint,
                                                                      static_cast<uint16_t>(symbol.segment),
-                                                                     symbol.line,
+                                                                     projectedLine,
                                                                      symbol.tileDistances,
-                                                                     labelPlaneMatrix,
                                                                      returnTileDistance);
     if (!lastPlacedGlyph) return {};
 
@@ -330,7 +398,7 @@ PlacementResult placeGlyphsAlongLine(const PlacedSymbol& symbol,
                                      const bool flip,
                                      const bool keepUpright,
                                      const mat4& posMatrix,
-                                     const mat4& labelPlaneMatrix,
+                                     ProjectedLineCache& projectedLine,
                                      const mat4& glCoordMatrix,
                                      gfx::VertexVector<gfx::Vertex<SymbolDynamicLayoutAttributes>>& dynamicVertexArray,
                                      const Point<float>& projectedAnchorPoint,
@@ -349,7 +417,7 @@ PlacementResult placeGlyphsAlongLine(const PlacedSymbol& symbol,
             projectedAnchorPoint,
             symbol.anchorPoint,
             symbol,
-            labelPlaneMatrix,
+            projectedLine,
             false);
         if (!firstAndLastGlyph) {
             return PlacementResult::NotEnoughRoom;
@@ -377,9 +445,8 @@ PlacementResult placeGlyphsAlongLine(const PlacedSymbol& symbol,
                                                    projectedAnchorPoint,
                                                    symbol.anchorPoint,
                                                    static_cast<uint16_t>(symbol.segment),
-                                                   symbol.line,
+                                                   projectedLine,
                                                    symbol.tileDistances,
-                                                   labelPlaneMatrix,
                                                    false);
             if (placedGlyph) {
                 placedGlyphs.push_back(*placedGlyph);
@@ -417,9 +484,8 @@ PlacementResult placeGlyphsAlongLine(const PlacedSymbol& symbol,
                                                                      projectedAnchorPoint,
                                                                      symbol.anchorPoint,
                                                                      static_cast<uint16_t>(symbol.segment),
-                                                                     symbol.line,
+                                                                     projectedLine,
                                                                      symbol.tileDistances,
-                                                                     labelPlaneMatrix,
                                                                      false);
         if (!singleGlyph) return PlacementResult::NotEnoughRoom;
 
@@ -458,6 +524,10 @@ void reprojectLineLabels(gfx::VertexVector<gfx::Vertex<SymbolDynamicLayoutAttrib
 
     dynamicVertexArray.clear();
 
+    // Shared by all symbols to reuse its buffers; the flipped and unflipped
+    // placement attempts of a symbol share its projected line vertices.
+    ProjectedLineCache projectedLine;
+
     bool useVertical = false;
 
     for (auto& placedSymbol : placedSymbols) {
@@ -489,13 +559,14 @@ void reprojectLineLabels(gfx::VertexVector<gfx::Vertex<SymbolDynamicLayoutAttrib
         const float pitchScaledFontSize = pitchWithMap ? fontSize * perspectiveRatio : fontSize / perspectiveRatio;
 
         const Point<float> anchorPoint = project(placedSymbol.anchorPoint, labelPlaneMatrix).first;
+        projectedLine.reset(placedSymbol.line, labelPlaneMatrix);
 
         PlacementResult placeUnflipped = placeGlyphsAlongLine(placedSymbol,
                                                               pitchScaledFontSize,
                                                               false /*unflipped*/,
                                                               keepUpright,
                                                               posMatrix,
-                                                              labelPlaneMatrix,
+                                                              projectedLine,
                                                               glCoordMatrix,
                                                               dynamicVertexArray,
                                                               anchorPoint,
@@ -510,7 +581,7 @@ void reprojectLineLabels(gfx::VertexVector<gfx::Vertex<SymbolDynamicLayoutAttrib
                                   true /*flipped*/,
                                   keepUpright,
                                   posMatrix,
-                                  labelPlaneMatrix,
+                                  projectedLine,
                                   glCoordMatrix,
                                   dynamicVertexArray,
                                   anchorPoint,
@@ -3,6 +3,10 @@
 #include <mbgl/util/mat4.hpp>
 #include <mbgl/gfx/vertex_buffer.hpp>
 #include <mbgl/programs/symbol_program.hpp>
+#include <mbgl/tile/geometry_tile_data.hpp>
+
+#include <cassert>
+#include <vector>
 
 namespace mbgl {
 
@@ -48,6 +52,38 @@ mat4 getGlCoordMatrix(
 using PointAndCameraDistance = std::pair<Point<float>, float>;
 PointAndCameraDistance project(const Point<float>& point, const mat4& matrix);
 
+// Projects points [begin, end) of `points` into `out`, equivalent to calling
+// project() for each of them. The transform is written as a flat loop over
+// the batch so that it can be vectorized by the compiler.
+void projectPoints(const GeometryCoordinates& points,
+                   std::size_t begin,
+                   std::size_t end,
+                   const mat4& matrix,
+                   PointAndCameraDistance* out);
+
+// Lazily projects the vertices of a symbol's line, so that all glyphs placed
+// along the line in one frame share the projection work. Vertices are
+// projected in fixed-size batches the first time one of them is requested.
+class ProjectedLineCache {
+public:
+    void reset(const GeometryCoordinates& line, const mat4& matrix);
+
+    const GeometryCoordinates& getLine() const {
+        assert(line);
+        return *line;
+    }
+    const mat4& getMatrix() const { return matrix; }
+    const PointAndCameraDistance& get(std::size_t index);
+
+    static constexpr std::size_t BatchSize = 8;
+
+private:
+    const GeometryCoordinates* line = nullptr;
+    mat4 matrix;
+    std::vector<PointAndCameraDistance> projected;
+    std::vector<bool> projectedBatches;
+};
+
 void reprojectLineLabels(gfx::VertexVector<gfx::Vertex<SymbolDynamicLayoutAttributes>>&,
                          const std::vector<PlacedSymbol>&,
                          const mat4& posMatrix,
@@ -68,6 +104,18 @@ std::optional<std::pair<PlacedGlyph, PlacedGlyph>> placeFirstAndLastGlyph(float
                                                                           const mat4& labelPlaneMatrix,
                                                                           bool returnTileDistance);
 
+// Same as above, reusing line vertices already projected with the label plane
+// matrix. `projectedLine` must have been reset with the symbol's line.
+std::optional<std::pair<PlacedGlyph, PlacedGlyph>> placeFirstAndLastGlyph(float fontScale,
+                                                                          float lineOffsetX,
+                                                                          float lineOffsetY,
+                                                                          bool flip,
+                                                                          const Point<float>& anchorPoint,
+                                                                          const Point<float>& tileAnchorPoint,
+                                                                          const PlacedSymbol& symbol,
+                                                                          ProjectedLineCache& projectedLine,
+                                                                          bool returnTileDistance);
+
 void hideGlyphs(std::size_t numGlyphs,
                 gfx::VertexVector<gfx::Vertex<SymbolDynamicLayoutAttributes>>& dynamicVertexArray);
 void addDynamicAttributes(const Point<float>& anchorPoint,
@@ -384,6 +384,7 @@ MapOptions Map::getMapOptions() const {
                          .withConstrainMode(impl->transform.getConstrainMode())
                          .withViewportMode(impl->transform.getViewportMode())
                          .withCrossSourceCollisions(impl->crossSourceCollisions)
+                         .withParallelPlacement(impl->parallelPlacement)
                          .withNorthOrientation(impl->transform.getNorthOrientation())
                          .withSize(impl->transform.getState().getSize())
                          .withPixelRatio(impl->pixelRatio));
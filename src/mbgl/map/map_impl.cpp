@@ -17,6 +17,7 @@ Map::Impl::Impl(RendererFrontend& frontend_,
       mode(mapOptions.mapMode()),
       pixelRatio(mapOptions.pixelRatio()),
       crossSourceCollisions(mapOptions.crossSourceCollisions()),
+      parallelPlacement(mapOptions.parallelPlacement()),
       fileSource(std::move(fileSource_)),
       style(std::make_unique<style::Style>(fileSource, pixelRatio)),
       annotationManager(*style) {
@@ -65,7 +66,8 @@ void Map::Impl::onUpdate() {
                                fileSource,
                                prefetchZoomDelta,
                                bool(stillImageRequest),
-                               crossSourceCollisions};
+                               crossSourceCollisions,
+                               parallelPlacement};
 
     rendererFrontend.update(std::make_shared<UpdateParameters>(std::move(params)));
 }
@@ -63,6 +63,7 @@ public:
     const MapMode mode;
     const float pixelRatio;
     const bool crossSourceCollisions;
+    const bool parallelPlacement;
 
     MapDebugOptions debugOptions{MapDebugOptions::NoDebug};
 
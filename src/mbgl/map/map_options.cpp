@@ -9,6 +9,7 @@ public:
     ViewportMode viewportMode = ViewportMode::Default;
     NorthOrientation orientation = NorthOrientation::Upwards;
     bool crossSourceCollisions = true;
+    bool parallelPlacement = false;
     Size size = {64, 64};
     float pixelRatio = 1.0;
 };
@@ -55,6 +56,15 @@ bool MapOptions::crossSourceCollisions() const {
     return impl_->crossSourceCollisions;
 }
 
+MapOptions& MapOptions::withParallelPlacement(bool enableParallelPlacement) {
+    impl_->parallelPlacement = enableParallelPlacement;
+    return *this;
+}
+
+bool MapOptions::parallelPlacement() const {
+    return impl_->parallelPlacement;
+}
+
 MapOptions& MapOptions::withNorthOrientation(NorthOrientation orientation) {
     impl_->orientation = orientation;
     return *this;
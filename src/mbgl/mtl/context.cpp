@@ -160,6 +160,7 @@ MTLSamplerStatePtr Context::createMetalSamplerState(MTLSamplerDescriptorPtr samp
 
 void Context::performCleanup() {
     stats.numDrawCalls = 0;
+    stats.numCulledDrawables = 0;
     stats.numFrames++;
     clipMaskUniformsBufferUsed = false;
 }
@@ -91,6 +91,10 @@ void TileLayerGroup::render(RenderOrchestrator&, PaintParameters& parameters) {
         if (!drawable.getEnabled() || !drawable.hasRenderPass(parameters.pass)) {
             return;
         }
+        if (isCulled(drawable, parameters)) {
+            context.renderingStats().numCulledDrawables++;
+            return;
+        }
 
         for (const auto& tweaker : drawable.getTweakers()) {
             tweaker->execute(drawable, parameters);
@@ -33,8 +33,14 @@ void UniformBuffer::update(const void* data, std::size_t size_) {
         return;
     }
 
-    buffer.getContext().renderingStats().numUniformUpdates++;
-    buffer.getContext().renderingStats().uniformUpdateBytes += size_;
+    auto& stats = buffer.getContext().renderingStats();
+    stats.numUniformUpdates++;
+    stats.uniformUpdateBytes += size_;
+    // Small buffers are kept in memory and bound inline with `set*Bytes`, only
+    // those backed by an `MTLBuffer` are uploaded.
+    if (buffer.getMetalBuffer()) {
+        stats.numUniformUploads++;
+    }
     buffer.update(data, size, /*offset=*/0);
 }
 
@@ -192,15 +192,16 @@ public:
 
 class SymbolProgramBase : public gfx::Shader {
 public:
+    // `o` is in 1/32 pixels, `pixelOffset` in 1/16 pixels and `minFontScale` in
+    // 1/256 units, see PackedSymbolQuad.
     static gfx::Vertex<SymbolLayoutAttributes> layoutVertex(Point<float> labelAnchor,
-                                                            Point<float> o,
-                                                            float glyphOffsetY,
+                                                            Point<int16_t> o,
                                                             uint16_t tx,
                                                             uint16_t ty,
                                                             const Range<float>& sizeData,
                                                             bool isSDF,
-                                                            Point<float> pixelOffset,
-                                                            Point<float> minFontScale) {
+                                                            Point<int16_t> pixelOffset,
+                                                            Point<int16_t> minFontScale) {
         const uint16_t aSizeMin = (std::min(MAX_PACKED_SIZE, static_cast<uint16_t>(sizeData.min * SIZE_PACK_FACTOR))
                                    << 1) +
                                   uint16_t(isSDF);
@@ -208,15 +209,9 @@ public:
         return {
             // combining pos and offset to reduce number of vertex attributes
             // passed to shader (8 max for some devices)
-            {{static_cast<int16_t>(labelAnchor.x),
-              static_cast<int16_t>(labelAnchor.y),
-              static_cast<int16_t>(std::round(o.x * 32)), // use 1/32 pixels for placement
-              static_cast<int16_t>(std::round((o.y + glyphOffsetY) * 32))}},
+            {{static_cast<int16_t>(labelAnchor.x), static_cast<int16_t>(labelAnchor.y), o.x, o.y}},
             {{tx, ty, aSizeMin, aSizeMax}},
-            {{static_cast<int16_t>(pixelOffset.x * 16),
-              static_cast<int16_t>(pixelOffset.y * 16),
-              static_cast<int16_t>(minFontScale.x * 256),
-              static_cast<int16_t>(minFontScale.y * 256)}},
+            {{pixelOffset.x, pixelOffset.y, minFontScale.x, minFontScale.y}},
         };
     }
 
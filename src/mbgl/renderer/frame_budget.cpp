@@ -0,0 +1,31 @@
+#include <mbgl/renderer/frame_budget.hpp>
+#include <mbgl/util/monotonic_timer.hpp>
+
+#include <utility>
+
+namespace mbgl {
+
+FrameBudget::FrameBudget(Clock clock_)
+    : clock(clock_ ? std::move(clock_) : Clock(&util::MonotonicTimer::now)) {}
+
+void FrameBudget::start(Duration budget_) {
+    startTime = clock();
+    budget = std::chrono::duration_cast<std::chrono::duration<double>>(budget_);
+    admitted = 0;
+    deferred = 0;
+}
+
+bool FrameBudget::admit() {
+    if (!isLimited() || admitted == 0 || !isExceeded()) {
+        admitted++;
+        return true;
+    }
+    deferred++;
+    return false;
+}
+
+double FrameBudget::elapsed() const {
+    return (clock() - startTime).count();
+}
+
+} // namespace mbgl
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <mbgl/util/chrono.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+
+namespace mbgl {
+
+/// Time budget for the work of a frame which can be left to later frames, such as building
+/// the drawables of newly loaded tiles.
+///
+/// The work is admitted in the order it's requested until the budget is spent.  The first
+/// unit of each frame is always admitted, so that deferred work keeps making progress even
+/// when the rest of the frame alone exceeds the budget.
+class FrameBudget {
+public:
+    /// Returns the current time, in seconds since an arbitrary point
+    using Clock = std::function<std::chrono::duration<double>()>;
+
+    /// Time frames with the given clock, the monotonic timer by default
+    explicit FrameBudget(Clock clock = {});
+
+    /// Start timing a frame.  A zero budget admits all the work.
+    void start(Duration budget);
+
+    /// Whether to do a unit of deferrable work in this frame
+    bool admit();
+
+    /// Leave a unit of work to a later frame, whatever the budget
+    void defer() { deferred++; }
+
+    /// Time since `start`, in seconds
+    double elapsed() const;
+
+    /// The budget for this frame in seconds, zero if unlimited
+    double getBudget() const { return budget.count(); }
+
+    bool isLimited() const { return budget.count() > 0; }
+    bool isExceeded() const { return isLimited() && elapsed() > budget.count(); }
+
+    /// Units of work admitted and deferred since `start`
+    std::size_t getAdmittedCount() const { return admitted; }
+    std::size_t getDeferredCount() const { return deferred; }
+
+private:
+    Clock clock;
+    std::chrono::duration<double> startTime{0};
+    std::chrono::duration<double> budget{0};
+    std::size_t admitted = 0;
+    std::size_t deferred = 0;
+};
+
+} // namespace mbgl
@@ -11,6 +11,7 @@
 #include <mbgl/renderer/upload_parameters.hpp>
 #include <mbgl/style/layers/background_layer_impl.hpp>
 #include <mbgl/style/layer_properties.hpp>
+#include <mbgl/util/constants.hpp>
 #include <mbgl/util/tile_cover.hpp>
 #include <mbgl/util/convert.hpp>
 #include <mbgl/util/logging.hpp>
@@ -24,6 +25,11 @@
 #include <mbgl/shaders/shader_program_base.hpp>
 #endif
 
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <limits>
+#include <map>
 #include <unordered_set>
 
 namespace mbgl {
@@ -210,6 +216,13 @@ void RenderBackgroundLayer::prepare(const LayerPrepareParameters& params) {
 static constexpr std::string_view BackgroundPlainShaderName = "BackgroundShader";
 static constexpr std::string_view BackgroundPatternShaderName = "BackgroundPatternShader";
 
+// Plain backgrounds are drawn in batches of up to `BackgroundBatchSpan` x `BackgroundBatchSpan` tiles.
+// Vertex positions within a batch must fit in 16 bits.
+// This is the only layer batched across tiles. Layers drawn from tile buckets keep one drawable per tile,
+// as merging them would need a tile index attribute in their shaders and per-tile stencil clipping.
+static constexpr uint32_t BackgroundBatchSpan = 3;
+static_assert(BackgroundBatchSpan * util::EXTENT <= std::numeric_limits<int16_t>::max());
+
 void RenderBackgroundLayer::update(gfx::ShaderRegistry& shaders,
                                    gfx::Context& context,
                                    const TransformState& state,
@@ -273,31 +286,57 @@ void RenderBackgroundLayer::update(gfx::ShaderRegistry& shaders,
         return;
     }
 
-    const auto tileVertices = RenderStaticData::tileVertices();
-    const auto vertexCount = tileVertices.elements();
-    constexpr auto vertSize = sizeof(decltype(tileVertices)::Vertex::a1);
-    std::vector<std::uint8_t> rawVertices(vertexCount * vertSize);
-    for (auto i = 0ULL; i < vertexCount; ++i) {
-        std::memcpy(&rawVertices[i * vertSize], &tileVertices.vector()[i].a1, vertSize);
+    // The background of the tile cover is split into batches of adjacent tiles which share a single drawable.
+    // The only per-tile state of a plain background is the tile matrix, so a batch can be drawn with the matrix
+    // of its top-left tile and vertex positions offset by whole tile extents. Patterns are positioned with
+    // per-tile uniforms and still get one drawable per tile. Layers drawn from buckets are not batched: they are
+    // clipped with per-tile stencil masks and bind per-tile data-driven attributes.
+    const uint32_t batchSpan = hasPattern ? 1 : BackgroundBatchSpan;
+    std::map<OverscaledTileID, std::vector<OverscaledTileID>> batches;
+    for (const auto& tileID : tileCover) {
+        const auto& canonical = tileID.canonical;
+        const OverscaledTileID origin{canonical.z,
+                                      tileID.wrap,
+                                      canonical.z,
+                                      canonical.x - canonical.x % batchSpan,
+                                      canonical.y - canonical.y % batchSpan};
+        batches[origin].push_back(tileID);
+    }
+    for (auto& [origin, batch] : batches) {
+        std::sort(batch.begin(), batch.end());
     }
 
-    const auto indexes = RenderStaticData::quadTriangleIndices();
-    const auto segs = RenderStaticData::tileTriangleSegments();
-
-    std::unique_ptr<gfx::DrawableBuilder> builder;
+    // Switching between the plain and pattern shaders changes how tiles are batched
+    if (hasPattern != batchedPattern) {
+        removeAllDrawables();
+        batchedTiles.clear();
+        batchedPattern = hasPattern;
+    }
 
-    // Remove drawables for tiles that are no longer in the cover set.
+    // Remove drawables for batches that are no longer in the cover set, or whose tiles changed.
     // (Note that `RenderTiles` is empty, and this layer does not use it)
-    tileLayerGroup->removeDrawablesIf([&](gfx::Drawable& drawable) -> bool {
-        return drawable.getTileID() &&
-               (std::find(tileCover.begin(), tileCover.end(), *drawable.getTileID()) == tileCover.end());
+    stats.drawablesRemoved += tileLayerGroup->removeDrawablesIf([&](gfx::Drawable& drawable) -> bool {
+        if (!drawable.getTileID()) {
+            return false;
+        }
+        const auto hit = batches.find(*drawable.getTileID());
+        const auto prev = batchedTiles.find(*drawable.getTileID());
+        return hit == batches.end() || prev == batchedTiles.end() || hit->second != prev->second;
     });
 
-    // For each tile in the cover set, add a tile drawable if one doesn't already exist.
-    for (const auto& tileID : tileCover) {
-        // If we already have drawables for this tile, skip.
+    const auto tileVertices = RenderStaticData::tileVertices();
+    const auto indexes = RenderStaticData::quadTriangleIndices();
+    const auto tileVertexCount = tileVertices.elements();
+    const auto tileIndexCount = indexes.elements();
+    constexpr auto vertSize = sizeof(decltype(tileVertices)::Vertex::a1);
+
+    std::unique_ptr<gfx::DrawableBuilder> builder;
+
+    // For each batch, add a drawable if one doesn't already exist.
+    for (const auto& [origin, batch] : batches) {
+        // If we already have drawables for this batch, skip.
         // If a drawable needs to be updated, that's handled in the layer tweaker.
-        if (tileLayerGroup->getDrawableCount(drawPasses, tileID) > 0) {
+        if (tileLayerGroup->getDrawableCount(drawPasses, origin) > 0) {
             continue;
         }
 
@@ -311,18 +350,41 @@ void RenderBackgroundLayer::update(gfx::ShaderRegistry& shaders,
                                                                         : gfx::ColorMode::unblended());
         }
 
-        auto verticesCopy = rawVertices;
-        builder->setRawVertices(std::move(verticesCopy), vertexCount, gfx::AttributeDataType::Short2);
-        builder->setSegments(gfx::Triangles(), indexes.vector(), segs.data(), segs.size());
+        // Concatenate the tile quads, relative to the origin tile
+        std::vector<std::uint8_t> rawVertices(batch.size() * tileVertexCount * vertSize);
+        std::vector<uint16_t> batchIndexes;
+        batchIndexes.reserve(batch.size() * tileIndexCount);
+        for (std::size_t i = 0; i < batch.size(); ++i) {
+            const auto dx = static_cast<int16_t>((batch[i].canonical.x - origin.canonical.x) * util::EXTENT);
+            const auto dy = static_cast<int16_t>((batch[i].canonical.y - origin.canonical.y) * util::EXTENT);
+            for (std::size_t v = 0; v < tileVertexCount; ++v) {
+                const auto& a1 = tileVertices.vector()[v].a1;
+                const std::array<int16_t, 2> position{{static_cast<int16_t>(a1[0] + dx),
+                                                       static_cast<int16_t>(a1[1] + dy)}};
+                std::memcpy(&rawVertices[(i * tileVertexCount + v) * vertSize], position.data(), vertSize);
+            }
+            const auto base = static_cast<uint16_t>(i * tileVertexCount);
+            for (const auto index : indexes.vector()) {
+                batchIndexes.push_back(static_cast<uint16_t>(base + index));
+            }
+        }
+
+        SegmentVector<BackgroundAttributes> batchSegments;
+        batchSegments.emplace_back(0, 0, batch.size() * tileVertexCount, batchIndexes.size());
+
+        builder->setRawVertices(std::move(rawVertices), batch.size() * tileVertexCount, gfx::AttributeDataType::Short2);
+        builder->setSegments(gfx::Triangles(), std::move(batchIndexes), batchSegments.data(), batchSegments.size());
         builder->flush(context);
 
         for (auto& drawable : builder->clearDrawables()) {
-            drawable->setTileID(tileID);
+            drawable->setTileID(origin);
             drawable->setLayerTweaker(layerTweaker);
-            tileLayerGroup->addDrawable(drawPasses, tileID, std::move(drawable));
+            tileLayerGroup->addDrawable(drawPasses, origin, std::move(drawable));
             ++stats.drawablesAdded;
         }
     }
+
+    batchedTiles = std::move(batches);
 }
 #endif
 
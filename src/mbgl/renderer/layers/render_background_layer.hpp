@@ -5,6 +5,7 @@
 #include <mbgl/style/layers/background_layer_impl.hpp>
 #include <mbgl/style/layers/background_layer_properties.hpp>
 
+#include <map>
 #include <optional>
 #include <memory>
 #include <vector>
@@ -59,6 +60,10 @@ private:
     // Drawable shaders
     gfx::ShaderProgramBasePtr plainShader;
     gfx::ShaderProgramBasePtr patternShader;
+
+    // Tiles drawn by each batch drawable, keyed by the batch's origin tile
+    std::map<OverscaledTileID, std::vector<OverscaledTileID>> batchedTiles;
+    bool batchedPattern = false;
 #endif
 };
 
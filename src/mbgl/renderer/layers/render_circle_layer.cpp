@@ -278,6 +278,29 @@ const StringIdentity idVertexAttribName = stringIndexer().get("a_pos");
 
 using namespace shaders;
 
+bool RenderCircleLayer::prewarmShaderVariants(gfx::ShaderRegistry& shaders, gfx::Context& context) {
+    if (!evaluatedProperties) {
+        return true;
+    }
+    const auto& evaluated = getEvaluated<CircleLayerProperties>(evaluatedProperties);
+
+    if (!circleShaderGroup) {
+        circleShaderGroup = shaders.getShaderGroup(CircleShaderGroupName);
+    }
+    if (circleShaderGroup) {
+        mbgl::unordered_set<StringIdentity> propertiesAsUniforms;
+        gfx::VertexAttributeArray::readPropertiesAsUniforms<CircleColor,
+                                                            CircleRadius,
+                                                            CircleBlur,
+                                                            CircleOpacity,
+                                                            CircleStrokeColor,
+                                                            CircleStrokeWidth,
+                                                            CircleStrokeOpacity>(evaluated, propertiesAsUniforms);
+        return circleShaderGroup->prewarmShader(context, propertiesAsUniforms);
+    }
+    return true;
+}
+
 void RenderCircleLayer::update(gfx::ShaderRegistry& shaders,
                                gfx::Context& context,
                                const TransformState& state,
@@ -341,9 +364,15 @@ void RenderCircleLayer::update(gfx::ShaderRegistry& shaders,
         const auto vertexCount = bucket.vertices.elements();
         const auto& paintPropertyBinders = bucket.paintPropertyBinders.at(getID());
 
+        // A tile previously set up from a different bucket drops and re-creates its drawables, but keeps
+        // showing the old ones until the frame budget admits the rebuild.
+        bool buildAdmitted = false;
         const auto prevBucketID = getRenderTileBucketID(tileID);
         if (prevBucketID != util::SimpleIdentity::Empty && prevBucketID != bucket.getID()) {
-            // This tile was previously set up from a different bucket, drop and re-create any drawables for it.
+            if (!admitTileBuild()) {
+                continue;
+            }
+            buildAdmitted = true;
             removeTile(renderPass, tileID);
         }
         setRenderTileBucketID(tileID, bucket.getID());
@@ -376,6 +405,9 @@ void RenderCircleLayer::update(gfx::ShaderRegistry& shaders,
         if (updateTile(renderPass, tileID, std::move(updateExisting))) {
             continue;
         }
+        if (!buildAdmitted && !admitTileBuild()) {
+            continue;
+        }
 
         const auto interpBuffer = context.createUniformBuffer(&interpolateUBO, sizeof(interpolateUBO));
 
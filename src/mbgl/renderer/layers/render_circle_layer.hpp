@@ -36,6 +36,10 @@ private:
     bool hasTransition() const override;
     bool hasCrossfade() const override;
 
+#if MLN_DRAWABLE_RENDERER
+    bool prewarmShaderVariants(gfx::ShaderRegistry&, gfx::Context&) override;
+#endif
+
     bool queryIntersectsFeature(const GeometryCoordinates&,
                                 const GeometryTileFeature&,
                                 float,
@@ -362,9 +362,15 @@ void RenderFillExtrusionLayer::update(gfx::ShaderRegistry& shaders,
         const auto& renderData = *optRenderData;
         const auto& bucket = static_cast<const FillExtrusionBucket&>(*renderData.bucket);
 
+        // A tile previously set up from a different bucket drops and re-creates its drawables, but keeps
+        // showing the old ones until the frame budget admits the rebuild.
+        bool buildAdmitted = false;
         const auto prevBucketID = getRenderTileBucketID(tileID);
         if (prevBucketID != util::SimpleIdentity::Empty && prevBucketID != bucket.getID()) {
-            // This tile was previously set up from a different bucket, drop and re-create any drawables for it.
+            if (!admitTileBuild()) {
+                continue;
+            }
+            buildAdmitted = true;
             removeTile(passes, tileID);
         }
         setRenderTileBucketID(tileID, bucket.getID());
@@ -418,6 +424,9 @@ void RenderFillExtrusionLayer::update(gfx::ShaderRegistry& shaders,
         if (updateTile(drawPass, tileID, std::move(updateExisting))) {
             continue;
         }
+        if (!buildAdmitted && !admitTileBuild()) {
+            continue;
+        }
 
         propertiesAsUniforms.clear();
 
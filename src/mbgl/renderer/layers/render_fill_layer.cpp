@@ -402,6 +402,44 @@ private:
 };
 #endif // MLN_TRIANGULATE_FILL_OUTLINES
 
+bool RenderFillLayer::prewarmShaderVariants(gfx::ShaderRegistry& shaders, gfx::Context& context) {
+    if (!evaluatedProperties) {
+        return true;
+    }
+    const auto& evaluated = getEvaluated<FillLayerProperties>(evaluatedProperties);
+
+    mbgl::unordered_set<StringIdentity> propertiesAsUniforms;
+    gfx::VertexAttributeArray::readPropertiesAsUniforms<FillColor, FillOpacity, FillOutlineColor, FillPattern>(
+        evaluated, propertiesAsUniforms);
+
+    const bool hasPattern = !unevaluated.get<FillPattern>().isUndefined();
+    auto& mainShaderGroup = hasPattern ? patternShaderGroup : fillShaderGroup;
+    if (!mainShaderGroup) {
+        mainShaderGroup = shaders.getShaderGroup(std::string(hasPattern ? FillPatternShaderName : FillShaderName));
+    }
+    bool ready = true;
+    if (mainShaderGroup) {
+        ready = mainShaderGroup->prewarmShader(context, propertiesAsUniforms);
+    }
+
+#if !MLN_TRIANGULATE_FILL_OUTLINES
+    const auto doOutline = evaluated.get<FillAntialias>() &&
+                           (!hasPattern || unevaluated.get<FillOutlineColor>().isUndefined());
+    if (doOutline) {
+        auto& outlineGroup = hasPattern ? outlinePatternShaderGroup : outlineShaderGroup;
+        if (!outlineGroup) {
+            outlineGroup = shaders.getShaderGroup(
+                std::string(hasPattern ? FillOutlinePatternShaderName : FillOutlineShaderName));
+        }
+        if (outlineGroup) {
+            // Start both before checking either
+            ready = outlineGroup->prewarmShader(context, propertiesAsUniforms) && ready;
+        }
+    }
+#endif // !MLN_TRIANGULATE_FILL_OUTLINES
+    return ready;
+}
+
 void RenderFillLayer::update(gfx::ShaderRegistry& shaders,
                              gfx::Context& context,
                              const TransformState& state,
@@ -504,9 +542,15 @@ void RenderFillLayer::update(gfx::ShaderRegistry& shaders,
         auto& bucket = static_cast<FillBucket&>(*renderData->bucket);
         const auto& binders = bucket.paintPropertyBinders.at(getID());
 
+        // A tile previously set up from a different bucket drops and re-creates its drawables, but keeps
+        // showing the old ones until the frame budget admits the rebuild.
+        bool buildAdmitted = false;
         const auto prevBucketID = getRenderTileBucketID(tileID);
         if (prevBucketID != util::SimpleIdentity::Empty && prevBucketID != bucket.getID()) {
-            // This tile was previously set up from a different bucket, drop and re-create any drawables for it.
+            if (!admitTileBuild()) {
+                continue;
+            }
+            buildAdmitted = true;
             removeTile(renderPass, tileID);
         }
         setRenderTileBucketID(tileID, bucket.getID());
@@ -679,6 +723,9 @@ void RenderFillLayer::update(gfx::ShaderRegistry& shaders,
         if (updateTile(renderPass, tileID, std::move(updateExisting))) {
             continue;
         }
+        if (!buildAdmitted && !admitTileBuild()) {
+            continue;
+        }
 
         // Outline always occurs in translucent pass, defaults to fill color
         // Outline does not default to fill in the pattern case
@@ -52,6 +52,10 @@ protected:
     void layerRemoved(UniqueChangeRequestVec&) override;
     std::size_t removeAllDrawables() override;
     std::size_t removeTile(RenderPass, const OverscaledTileID&) override;
+#endif // MLN_TRIANGULATE_FILL_OUTLINES
+
+#if MLN_DRAWABLE_RENDERER
+    bool prewarmShaderVariants(gfx::ShaderRegistry&, gfx::Context&) override;
 #endif // MLN_DRAWABLE_RENDERER
 
 private:
@@ -303,6 +303,17 @@ static const StringIdentity idPosAttribName = stringIndexer().get("a_pos");
 static const StringIdentity idTexturePosAttribName = stringIndexer().get("a_texture_pos");
 static const StringIdentity idTexImageName = stringIndexer().get("u_image");
 
+bool RenderHillshadeLayer::prewarmShaderVariants(gfx::ShaderRegistry& shaders, gfx::Context& context) {
+    // A single variant of each, without data-driven properties
+    bool ready = true;
+    for (const auto& name : {HillshadePrepareShaderGroupName, HillshadeShaderGroupName}) {
+        if (const auto shaderGroup = shaders.getShaderGroup(name)) {
+            ready = shaderGroup->prewarmShader(context, {}) && ready;
+        }
+    }
+    return ready;
+}
+
 void RenderHillshadeLayer::update(gfx::ShaderRegistry& shaders,
                                   gfx::Context& context,
                                   [[maybe_unused]] const TransformState& state,
@@ -333,6 +344,10 @@ void RenderHillshadeLayer::update(gfx::ShaderRegistry& shaders,
     }
     layerTweaker->enableOverdrawInspector(!!(updateParameters->debugOptions & MapDebugOptions::Overdraw));
 
+    if ((!hillshadePrepareShader || !hillshadeShader) && tileBuildsDeferred) {
+        // No drawables yet, they're built once the shaders are ready
+        return;
+    }
     if (!hillshadePrepareShader) {
         hillshadePrepareShader = context.getGenericShader(shaders, HillshadePrepareShaderGroupName);
     }
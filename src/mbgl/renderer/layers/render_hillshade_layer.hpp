@@ -45,6 +45,7 @@ private:
 
 #if MLN_DRAWABLE_RENDERER
     void updateLayerTweaker();
+    bool prewarmShaderVariants(gfx::ShaderRegistry&, gfx::Context&) override;
 #endif // MLN_DRAWABLE_RENDERER
 
     void prepare(const LayerPrepareParameters&) override;
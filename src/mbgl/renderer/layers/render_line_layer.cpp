@@ -363,6 +363,51 @@ static const StringIdentity idLinePatternTilePropertiesUBOName = stringIndexer()
 
 static const StringIdentity idLineImageUniformName = stringIndexer().get("u_image");
 
+bool RenderLineLayer::prewarmShaderVariants(gfx::ShaderRegistry& shaders, gfx::Context& context) {
+    if (!evaluatedProperties) {
+        return true;
+    }
+    const auto& evaluated = getEvaluated<LineLayerProperties>(evaluatedProperties);
+
+    // Pick the same variant as `update` does for each tile
+    mbgl::unordered_set<StringIdentity> propertiesAsUniforms;
+    gfx::ShaderGroupPtr* shaderGroup = nullptr;
+    const char* shaderGroupName = nullptr;
+    if (!evaluated.get<LineDasharray>().from.empty()) {
+        gfx::VertexAttributeArray::readPropertiesAsUniforms<LineColor,
+                                                            LineBlur,
+                                                            LineOpacity,
+                                                            LineGapWidth,
+                                                            LineOffset,
+                                                            LineWidth,
+                                                            LineFloorWidth>(evaluated, propertiesAsUniforms);
+        shaderGroup = &lineSDFShaderGroup;
+        shaderGroupName = "LineSDFShader";
+    } else if (!unevaluated.get<LinePattern>().isUndefined()) {
+        gfx::VertexAttributeArray::
+            readPropertiesAsUniforms<LineBlur, LineOpacity, LineOffset, LineGapWidth, LineWidth, LinePattern>(
+                evaluated, propertiesAsUniforms);
+        shaderGroup = &linePatternShaderGroup;
+        shaderGroupName = "LinePatternShader";
+    } else if (!unevaluated.get<LineGradient>().getValue().isUndefined()) {
+        gfx::VertexAttributeArray::readPropertiesAsUniforms<LineBlur, LineOpacity, LineGapWidth, LineOffset, LineWidth>(
+            evaluated, propertiesAsUniforms);
+        shaderGroup = &lineGradientShaderGroup;
+        shaderGroupName = "LineGradientShader";
+    } else {
+        gfx::VertexAttributeArray::
+            readPropertiesAsUniforms<LineColor, LineBlur, LineOpacity, LineGapWidth, LineOffset, LineWidth>(
+                evaluated, propertiesAsUniforms);
+        shaderGroup = &lineShaderGroup;
+        shaderGroupName = "LineShader";
+    }
+
+    if (!*shaderGroup) {
+        *shaderGroup = shaders.getShaderGroup(shaderGroupName);
+    }
+    return !*shaderGroup || (*shaderGroup)->prewarmShader(context, propertiesAsUniforms);
+}
+
 void RenderLineLayer::update(gfx::ShaderRegistry& shaders,
                              gfx::Context& context,
                              const TransformState& state,
@@ -483,9 +528,15 @@ void RenderLineLayer::update(gfx::ShaderRegistry& shaders,
         const auto& evaluated = getEvaluated<LineLayerProperties>(renderData->layerProperties);
         const auto& crossfade = getCrossfade<LineLayerProperties>(renderData->layerProperties);
 
+        // A tile previously set up from a different bucket drops and re-creates its drawables, but keeps
+        // showing the old ones until the frame budget admits the rebuild.
+        bool buildAdmitted = false;
         const auto prevBucketID = getRenderTileBucketID(tileID);
         if (prevBucketID != util::SimpleIdentity::Empty && prevBucketID != bucket.getID()) {
-            // This tile was previously set up from a different bucket, drop and re-create any drawables for it.
+            if (!admitTileBuild()) {
+                continue;
+            }
+            buildAdmitted = true;
             removeTile(renderPass, tileID);
         }
         setRenderTileBucketID(tileID, bucket.getID());
@@ -576,6 +627,9 @@ void RenderLineLayer::update(gfx::ShaderRegistry& shaders,
         if (updateTile(renderPass, tileID, std::move(updateExisting))) {
             continue;
         }
+        if (!buildAdmitted && !admitTileBuild()) {
+            continue;
+        }
 
         if (!evaluated.get<LineDasharray>().from.empty()) {
             if (!lineSDFShaderGroup) {
@@ -54,6 +54,10 @@ private:
     bool hasCrossfade() const override;
     void prepare(const LayerPrepareParameters&) override;
 
+#if MLN_DRAWABLE_RENDERER
+    bool prewarmShaderVariants(gfx::ShaderRegistry&, gfx::Context&) override;
+#endif
+
 #if MLN_LEGACY_RENDERER
     void upload(gfx::UploadPass&) override;
     void render(PaintParameters&) override;
@@ -21,6 +21,8 @@
 #include <mbgl/renderer/layer_group.hpp>
 #include <mbgl/renderer/update_parameters.hpp>
 #include <mbgl/shaders/shader_program_base.hpp>
+#include <mbgl/gfx/shader_group.hpp>
+#include <mbgl/gfx/shader_registry.hpp>
 #endif
 
 namespace mbgl {
@@ -251,6 +253,16 @@ static const StringIdentity idTexturePosAttribName = stringIndexer().get("a_text
 static const StringIdentity idTexImage0Name = stringIndexer().get("u_image0");
 static const StringIdentity idTexImage1Name = stringIndexer().get("u_image1");
 
+static const std::string RasterShaderGroupName = "RasterShader";
+
+bool RenderRasterLayer::prewarmShaderVariants(gfx::ShaderRegistry& shaders, gfx::Context& context) {
+    // A single variant, without data-driven properties
+    if (const auto shaderGroup = shaders.getShaderGroup(RasterShaderGroupName)) {
+        return shaderGroup->prewarmShader(context, {});
+    }
+    return true;
+}
+
 void RenderRasterLayer::update(gfx::ShaderRegistry& shaders,
                                gfx::Context& context,
                                const TransformState& /*state*/,
@@ -272,7 +284,11 @@ void RenderRasterLayer::update(gfx::ShaderRegistry& shaders,
     constexpr auto renderPass = RenderPass::Translucent;
 
     if (!rasterShader) {
-        rasterShader = context.getGenericShader(shaders, "RasterShader");
+        if (tileBuildsDeferred) {
+            // No drawables yet, they're built once the shader is ready
+            return;
+        }
+        rasterShader = context.getGenericShader(shaders, RasterShaderGroupName);
         if (!rasterShader) {
             return;
         }
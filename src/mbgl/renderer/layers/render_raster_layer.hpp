@@ -51,6 +51,10 @@ private:
     bool hasCrossfade() const override;
     void prepare(const LayerPrepareParameters&) override;
 
+#if MLN_DRAWABLE_RENDERER
+    bool prewarmShaderVariants(gfx::ShaderRegistry&, gfx::Context&) override;
+#endif
+
 #if MLN_LEGACY_RENDERER
     void render(PaintParameters&) override;
 #endif
@@ -1075,9 +1075,15 @@ void RenderSymbolLayer::update(gfx::ShaderRegistry& shaders,
         const auto& renderData = *optRenderData;
         const auto& bucket = static_cast<const SymbolBucket&>(*renderData.bucket);
 
+        // A tile previously set up from a different bucket drops and re-creates its drawables, but keeps
+        // showing the old ones until the frame budget admits the rebuild.
+        bool buildAdmitted = false;
         const auto prevBucketID = getRenderTileBucketID(tileID);
         if (prevBucketID != util::SimpleIdentity::Empty && prevBucketID != bucket.getID()) {
-            // This tile was previously set up from a different bucket, drop and re-create any drawables for it.
+            if (!admitTileBuild()) {
+                continue;
+            }
+            buildAdmitted = true;
             removeTile(passes, tileID);
         }
         setRenderTileBucketID(tileID, bucket.getID());
@@ -1188,6 +1194,9 @@ void RenderSymbolLayer::update(gfx::ShaderRegistry& shaders,
 
             continue;
         }
+        if (!buildAdmitted && !admitTileBuild()) {
+            continue;
+        }
 
         float serialKey = 1.0f;
         auto addRenderables = [&, it = renderableSegments.begin()](const SymbolBucket::Buffer& buffer,
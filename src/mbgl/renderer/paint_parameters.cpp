@@ -8,8 +8,14 @@
 #include <mbgl/renderer/render_source.hpp>
 #include <mbgl/renderer/render_tile.hpp>
 #include <mbgl/renderer/update_parameters.hpp>
+#include <mbgl/util/constants.hpp>
 #include <mbgl/util/convert.hpp>
 #include <mbgl/util/logging.hpp>
+#include <mbgl/util/projection.hpp>
+
+#include <algorithm>
+#include <array>
+#include <limits>
 
 #if MLN_RENDER_BACKEND_METAL
 #include <mbgl/mtl/context.hpp>
@@ -19,7 +25,11 @@
 namespace mbgl {
 
 TransformParameters::TransformParameters(const TransformState& state_)
-    : state(state_) {
+    : state(state_),
+      frustum(util::Frustum::fromInvProjMatrix(state.getInvProjectionMatrix(),
+                                               Projection::worldSize(state.getScale()),
+                                               /*zoom=*/0.0,
+                                               state.getViewportMode() == ViewportMode::FlippedY)) {
     // Update the default matrices to the current viewport dimensions.
     state.getProjMatrix(projMatrix);
 
@@ -82,6 +92,38 @@ mat4 PaintParameters::matrixForTile(const UnwrappedTileID& tileID, bool aligned)
     return matrix;
 }
 
+bool PaintParameters::isTileCulled(const UnwrappedTileID& tileID) const {
+    const double tileSize = 1.0 / (1 << tileID.canonical.z);
+    const double x = tileID.wrap + tileID.canonical.x * tileSize;
+    const double y = tileID.canonical.y * tileSize;
+    if (transformParams.frustum.intersects(util::AABB({{x, y, 0.0}}, {{x + tileSize, y + tileSize, 0.0}})) ==
+        util::IntersectionResult::Separate) {
+        return true;
+    }
+
+    // Measure the projected bounds of the tile
+    const mat4 matrix = matrixForTile(tileID);
+    double minX = std::numeric_limits<double>::max(), minY = minX;
+    double maxX = std::numeric_limits<double>::lowest(), maxY = maxX;
+    constexpr double extent = util::EXTENT;
+    const std::array<vec4, 4> corners{
+        {{{0, 0, 0, 1}}, {{extent, 0, 0, 1}}, {{0, extent, 0, 1}}, {{extent, extent, 0, 1}}}};
+    for (const auto& corner : corners) {
+        vec4 pos;
+        matrix::transformMat4(pos, corner, matrix);
+        if (pos[3] <= 0) {
+            // Behind the camera, the projection is not meaningful
+            return false;
+        }
+        minX = std::min(minX, pos[0] / pos[3]);
+        maxX = std::max(maxX, pos[0] / pos[3]);
+        minY = std::min(minY, pos[1] / pos[3]);
+        maxY = std::max(maxY, pos[1] / pos[3]);
+    }
+    const auto size = state.getSize();
+    return (maxX - minX) * size.width / 2 < 1.0 && (maxY - minY) * size.height / 2 < 1.0;
+}
+
 gfx::DepthMode PaintParameters::depthModeForSublayer(uint8_t n, gfx::DepthMaskType mask) const {
     if (currentLayer < opaquePassCutoff) {
         return gfx::DepthMode::disabled();
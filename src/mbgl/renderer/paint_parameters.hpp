@@ -8,6 +8,7 @@
 #include <mbgl/gfx/depth_mode.hpp>
 #include <mbgl/gfx/stencil_mode.hpp>
 #include <mbgl/gfx/color_mode.hpp>
+#include <mbgl/util/bounding_volumes.hpp>
 #include <mbgl/util/mat4.hpp>
 
 #include <array>
@@ -43,6 +44,8 @@ public:
     mat4 alignedProjMatrix;
     mat4 nearClippedProjMatrix;
     const TransformState state;
+    /// View frustum in world units, with one unit per world copy
+    const util::Frustum frustum;
 };
 
 class PaintParameters {
@@ -93,6 +96,9 @@ public:
 
     mat4 matrixForTile(const UnwrappedTileID&, bool aligned = false) const;
 
+    /// Whether a tile is entirely outside the view frustum, or covers less than a pixel on screen
+    bool isTileCulled(const UnwrappedTileID&) const;
+
     // Stencil handling
 public:
     void renderTileClippingMasks(const RenderTiles&);
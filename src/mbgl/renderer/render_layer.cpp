@@ -25,6 +25,9 @@ RenderLayer::RenderLayer(Immutable<style::LayerProperties> properties)
 
 void RenderLayer::transition(const TransitionParameters& parameters, Immutable<style::Layer::Impl> newImpl) {
     baseImpl = std::move(newImpl);
+#if MLN_DRAWABLE_RENDERER
+    shaderPrewarmNeeded = true;
+#endif
     transition(parameters);
 }
 
@@ -107,6 +110,14 @@ void RenderLayer::layerChanged(const TransitionParameters&,
     layerTweaker.reset();
 }
 
+bool RenderLayer::prewarmShaders(gfx::ShaderRegistry& shaders, gfx::Context& context) {
+    if (shaderPrewarmNeeded) {
+        // Keep checking until the driver is done with them
+        shaderPrewarmNeeded = !prewarmShaderVariants(shaders, context);
+    }
+    return !shaderPrewarmNeeded;
+}
+
 void RenderLayer::layerRemoved(UniqueChangeRequestVec& changes) {
     removeAllDrawables();
     activateLayerGroup(layerGroup, false, changes);
@@ -10,6 +10,7 @@
 #include <mbgl/gfx/drawable.hpp>
 #include <mbgl/renderer/layer_group.hpp>
 #include <mbgl/renderer/change_request.hpp>
+#include <mbgl/renderer/frame_budget.hpp>
 #include <mbgl/util/tiny_unordered_map.hpp>
 #endif // MLN_DRAWABLE_RENDERER
 
@@ -192,6 +193,18 @@ public:
 
     /// Returns the current renderability mode of the layer
     bool isLayerRenderable() const noexcept { return isRenderable; }
+
+    /// Start creating the shader variants needed by the current properties, so that they're ready, or at least
+    /// compiling, when the first drawables are built. Does nothing unless the style layer changed.
+    /// @return Whether the layer can build its drawables without waiting for a shader
+    bool prewarmShaders(gfx::ShaderRegistry&, gfx::Context&);
+
+    /// Set the budget limiting the drawables built by the next `update`, or null for no limit
+    void setFrameBudget(FrameBudget* budget) { frameBudget = budget; }
+
+    /// Leave building the drawables of new tiles to a later frame during the next `update`, e.g., while their
+    /// shaders compile. Existing drawables are still updated, and those of removed tiles dropped.
+    void setTileBuildsDeferred(bool deferred) { tileBuildsDeferred = deferred; }
 #endif
 
 protected:
@@ -241,6 +254,17 @@ protected:
         return anyUpdated;
     }
 
+    /// Whether to build the drawables for a tile without any in this frame, or leave it for a later one
+    bool admitTileBuild() {
+        if (tileBuildsDeferred) {
+            if (frameBudget) {
+                frameBudget->defer();
+            }
+            return false;
+        }
+        return !frameBudget || frameBudget->admit();
+    }
+
     /// Remove all drawables for the tile from the layer group
     /// @return The number of drawables actually removed.
     virtual std::size_t removeTile(RenderPass, const OverscaledTileID&);
@@ -271,6 +295,12 @@ protected:
                                LayerTweakerPtr newTweaker,
                                const std::vector<LayerGroupBasePtr>&);
 
+    /// Request the shader variants for the evaluated properties, see `gfx::ShaderGroup::prewarmShader`.
+    /// Implemented by the fill, line, circle, raster and hillshade layers. Symbol layers choose their
+    /// shaders per bucket, and still create them when their drawables are first built.
+    /// @return Whether all of them are ready
+    virtual bool prewarmShaderVariants(gfx::ShaderRegistry&, gfx::Context&) { return true; }
+
 #endif // MLN_DRAWABLE_RENDERER
 
     static bool applyColorRamp(const style::ColorRampPropertyValue&, PremultipliedImage&);
@@ -292,6 +322,15 @@ protected:
     // An optional tweaker that will update drawables
     LayerTweakerPtr layerTweaker;
 
+    // Set when the style layer changes, which may change the data-driven properties, until the
+    // shaders for them are ready
+    bool shaderPrewarmNeeded = true;
+
+    // Budget for building new drawables during `update`, not owned
+    FrameBudget* frameBudget = nullptr;
+    // Set while the shaders are compiling, new drawables wait for them
+    bool tileBuildsDeferred = false;
+
     // A sorted set of tile IDs in `renderTiles`, along with
     // the identity of the bucket from which they were built.
     // We swap between two instances to minimize reallocations.
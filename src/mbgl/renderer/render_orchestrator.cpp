@@ -23,8 +23,11 @@
 #include <mbgl/renderer/image_manager.hpp>
 #include <mbgl/geometry/line_atlas.hpp>
 #include <mbgl/style/source_impl.hpp>
+#include <mbgl/storage/file_source.hpp>
+#include <mbgl/storage/resource_options.hpp>
 #include <mbgl/style/transition_options.hpp>
 #include <mbgl/text/glyph_manager.hpp>
+#include <mbgl/text/local_glyph_cache.hpp>
 #include <mbgl/tile/tile.hpp>
 #include <mbgl/util/math.hpp>
 #include <mbgl/util/string.hpp>
@@ -113,6 +116,7 @@ public:
 
 RenderOrchestrator::RenderOrchestrator(bool backgroundLayerAsColor_, const std::optional<std::string>& localFontFamily_)
     : observer(&nullObserver()),
+      localFontFamily(localFontFamily_),
       glyphManager(std::make_unique<GlyphManager>(std::make_unique<LocalGlyphRasterizer>(localFontFamily_))),
       imageManager(std::make_unique<ImageManager>()),
       lineAtlas(std::make_unique<LineAtlas>()),
@@ -186,6 +190,15 @@ std::unique_ptr<RenderTree> RenderOrchestrator::createRenderTree(
 
     glyphManager->setURL(updateParameters->glyphURL);
 
+    if (!localGlyphCacheConfigured && updateParameters->fileSource) {
+        // Keep locally generated glyphs next to the ambient cache database.
+        localGlyphCacheConfigured = true;
+        const std::string cachePath = updateParameters->fileSource->getResourceOptions().cachePath();
+        if (localFontFamily && !cachePath.empty() && cachePath != ":memory:") {
+            glyphManager->setLocalGlyphCache(std::make_shared<LocalGlyphCache>(cachePath + "-glyphs", localFontFamily));
+        }
+    }
+
     // Update light.
     const bool lightChanged = renderLight.impl != updateParameters->light;
 
@@ -882,7 +895,8 @@ void RenderOrchestrator::updateLayers(gfx::ShaderRegistry& shaders,
                                       gfx::Context& context,
                                       const TransformState& state,
                                       const std::shared_ptr<UpdateParameters>& updateParameters,
-                                      const RenderTree& renderTree) {
+                                      const RenderTree& renderTree,
+                                      FrameBudget& frameBudget) {
     const bool isMapModeContinuous = updateParameters->mode == MapMode::Continuous;
     const auto transitionOptions = isMapModeContinuous ? updateParameters->transitionOptions
                                                        : style::TransitionOptions();
@@ -893,10 +907,24 @@ void RenderOrchestrator::updateLayers(gfx::ShaderRegistry& shaders,
         transitionOptions.duration.value_or(defDuration),
     };
 
+    // Start all the new shaders before any layer waits for one.  Layers whose shaders are still
+    // compiling leave their new drawables to a later frame, unless this frame has to be complete,
+    // but still update their existing ones.
+    std::unordered_set<const RenderLayer*> waitingLayers;
+    for (const auto& item : renderTree.getLayerRenderItemMap()) {
+        if (!item.layer.get().prewarmShaders(shaders, context) && isMapModeContinuous) {
+            waitingLayers.insert(&item.layer.get());
+        }
+    }
+
     std::vector<std::unique_ptr<ChangeRequest>> changes;
     for (const auto& item : renderTree.getLayerRenderItemMap()) {
         auto& renderLayer = item.layer.get();
+        renderLayer.setFrameBudget(&frameBudget);
+        renderLayer.setTileBuildsDeferred(waitingLayers.count(&renderLayer) > 0);
         renderLayer.update(shaders, context, state, updateParameters, renderTree, changes);
+        renderLayer.setTileBuildsDeferred(false);
+        renderLayer.setFrameBudget(nullptr);
     }
     addChanges(changes);
 }
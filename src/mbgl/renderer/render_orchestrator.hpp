@@ -37,6 +37,7 @@ class ImageManager;
 class LineAtlas;
 class PatternAtlas;
 class CrossTileSymbolIndex;
+class FrameBudget;
 class RenderTree;
 
 namespace gfx {
@@ -113,11 +114,13 @@ public:
         }
     }
 
+    /// Update the layers, building the drawables of new tiles as `FrameBudget` allows
     void updateLayers(gfx::ShaderRegistry&,
                       gfx::Context&,
                       const TransformState&,
                       const std::shared_ptr<UpdateParameters>&,
-                      const RenderTree&);
+                      const RenderTree&,
+                      FrameBudget&);
 
     void processChanges();
 
@@ -184,6 +187,9 @@ private:
     ZoomHistory zoomHistory;
     TransformState transformState;
 
+    const std::optional<std::string> localFontFamily;
+    bool localGlyphCacheConfigured = false;
+
     std::unique_ptr<GlyphManager> glyphManager;
     std::unique_ptr<ImageManager> imageManager;
     std::unique_ptr<LineAtlas> lineAtlas;
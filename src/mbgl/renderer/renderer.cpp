@@ -30,12 +30,18 @@ void Renderer::setObserver(RendererObserver* observer) {
 
 void Renderer::render(const std::shared_ptr<UpdateParameters>& updateParameters) {
     assert(updateParameters);
+    // The budget covers building the render tree, which includes symbol placement
+    impl->frameBudget.start(updateParameters->mode == MapMode::Continuous ? impl->frameTimeBudget : Duration::zero());
     if (auto renderTree = impl->orchestrator.createRenderTree(updateParameters)) {
         renderTree->prepare();
         impl->render(*renderTree, updateParameters);
     }
 }
 
+void Renderer::setFrameTimeBudget(Duration budget) {
+    impl->frameTimeBudget = budget;
+}
+
 std::vector<Feature> Renderer::queryRenderedFeatures(const ScreenLineString& geometry,
                                                      const RenderedQueryOptions& options) const {
     return impl->orchestrator.queryRenderedFeatures(geometry, options);
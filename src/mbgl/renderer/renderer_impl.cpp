@@ -13,6 +13,9 @@
 #include <mbgl/renderer/renderer_observer.hpp>
 #include <mbgl/renderer/render_static_data.hpp>
 #include <mbgl/renderer/render_tree.hpp>
+#include <mbgl/renderer/update_parameters.hpp>
+#include <mbgl/storage/file_source.hpp>
+#include <mbgl/storage/resource_options.hpp>
 #include <mbgl/util/convert.hpp>
 #include <mbgl/util/string.hpp>
 #include <mbgl/util/logging.hpp>
@@ -62,13 +65,21 @@ void Renderer::Impl::setObserver(RendererObserver* observer_) {
 }
 
 void Renderer::Impl::render(const RenderTree& renderTree,
-                            [[maybe_unused]] const std::shared_ptr<UpdateParameters>& updateParameters) {
+                            const std::shared_ptr<UpdateParameters>& updateParameters) {
     auto& context = backend.getContext();
 
     // Blocks execution until the renderable is available.
     backend.getDefaultRenderable().wait();
 
     if (!staticData) {
+        // Keep compiled shader programs next to the ambient cache database.
+        if (updateParameters && updateParameters->fileSource) {
+            const std::string cachePath = updateParameters->fileSource->getResourceOptions().cachePath();
+            if (!cachePath.empty() && cachePath != ":memory:") {
+                context.setProgramCachePath(cachePath + "-programs");
+            }
+        }
+
         staticData = std::make_unique<RenderStaticData>(pixelRatio, std::make_unique<gfx::ShaderRegistry>());
 
         // Initialize legacy shader programs
@@ -142,8 +153,12 @@ void Renderer::Impl::render(const RenderTree& renderTree,
     // - LAYER GROUP UPDATE ------------------------------------------------------------------------
     // Updates all layer groups and process changes
     if (staticData && staticData->shaders) {
-        orchestrator.updateLayers(
-            *staticData->shaders, context, renderTreeParameters.transformParams.state, updateParameters, renderTree);
+        orchestrator.updateLayers(*staticData->shaders,
+                                  context,
+                                  renderTreeParameters.transformParams.state,
+                                  updateParameters,
+                                  renderTree,
+                                  frameBudget);
     }
 
     orchestrator.processChanges();
@@ -404,14 +419,21 @@ void Renderer::Impl::render(const RenderTree& renderTree,
 
     const auto encodingTime = renderTree.getElapsedTime() - renderingTime;
 
+    // Tiles and layers left for later frames need those frames to be drawn, and the map isn't complete until they are
+    const auto deferredTiles = frameBudget.getDeferredCount();
+    const bool loaded = renderTreeParameters.loaded && deferredTiles == 0;
+    if (frameBudget.isExceeded()) {
+        observer->onFrameBudgetExceeded(frameBudget.elapsed(), frameBudget.getBudget(), deferredTiles);
+    }
+
     observer->onDidFinishRenderingFrame(
-        renderTreeParameters.loaded ? RendererObserver::RenderMode::Full : RendererObserver::RenderMode::Partial,
-        renderTreeParameters.needsRepaint,
+        loaded ? RendererObserver::RenderMode::Full : RendererObserver::RenderMode::Partial,
+        renderTreeParameters.needsRepaint || deferredTiles > 0,
         renderTreeParameters.placementChanged,
         encodingTime,
         renderingTime);
 
-    if (!renderTreeParameters.loaded) {
+    if (!loaded) {
         renderState = RenderState::Partial;
     } else if (renderState != RenderState::Fully) {
         renderState = RenderState::Fully;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <mbgl/renderer/frame_budget.hpp>
 #include <mbgl/renderer/render_orchestrator.hpp>
 
 #include <memory>
@@ -49,6 +50,10 @@ private:
     RenderState renderState = RenderState::Never;
 
     uint64_t frameCount = 0;
+
+    // Zero for no limit
+    Duration frameTimeBudget = Duration::zero();
+    FrameBudget frameBudget;
 };
 
 } // namespace mbgl
@@ -20,6 +20,7 @@
 #include <mbgl/util/convert.hpp>
 #include <mbgl/util/string_indexer.hpp>
 #include <mbgl/tile/geojson_tile_data.hpp>
+#include <mbgl/gfx/drawable_geometry.hpp>
 #include <mbgl/gfx/polyline_generator.hpp>
 #include <mbgl/style/types.hpp>
 #include <mbgl/shaders/line_layer_ubo.hpp>
@@ -96,6 +97,7 @@ void TileSourceRenderItem::updateDebugDrawables(DebugLayerGroupMap& debugLayerGr
     };
 
     std::unique_ptr<gfx::DrawableBuilder> polylineBuilder;
+    std::optional<gfx::PolylineGeometry> borderGeometry;
     const auto createPolylineBuilder = [&](gfx::ShaderPtr shader) -> std::unique_ptr<gfx::DrawableBuilder> {
         std::unique_ptr<gfx::DrawableBuilder> builder = context.createDrawableBuilder("debug-polyline-builder");
         builder->setShader(std::static_pointer_cast<gfx::ShaderProgramBase>(shader));
@@ -260,15 +262,22 @@ void TileSourceRenderItem::updateDebugDrawables(DebugLayerGroupMap& debugLayerGr
             shaders::LinePropertiesUBO linePropertiesUBO;
         };
 
-        GeometryCoordinates coords{{0, 0}, {util::EXTENT, 0}, {util::EXTENT, util::EXTENT}, {0, util::EXTENT}, {0, 0}};
-        gfx::PolylineGeneratorOptions options;
-        options.type = FeatureType::Polygon;
+        // The tile border is the same for every tile, generate it once and share it
+        if (!borderGeometry) {
+            GeometryCoordinates coords{
+                {0, 0}, {util::EXTENT, 0}, {util::EXTENT, util::EXTENT}, {0, util::EXTENT}, {0, 0}};
+            gfx::PolylineGeneratorOptions options;
+            options.type = FeatureType::Polygon;
+
+            borderGeometry.emplace();
+            borderGeometry->add(coords, options);
+        }
 
         if (!polylineShader) polylineShader = createPolylineShader();
         if (!polylineBuilder) {
             polylineBuilder = createPolylineBuilder(polylineShader);
         }
-        polylineBuilder->addPolyline(coords, options);
+        polylineBuilder->setPolylineGeometry(context, *borderGeometry);
 
         // create line tweaker
         const shaders::LinePropertiesUBO linePropertiesUBO{/*color*/ Color::red(),
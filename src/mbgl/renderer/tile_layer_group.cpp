@@ -1,5 +1,6 @@
 #include <mbgl/renderer/layer_group.hpp>
 
+#include <mbgl/gfx/drawable.hpp>
 #include <mbgl/gfx/upload_pass.hpp>
 #include <mbgl/renderer/paint_parameters.hpp>
 #include <mbgl/renderer/render_orchestrator.hpp>
@@ -74,4 +75,13 @@ void TileLayerGroup::setStencilTiles(RenderTiles tiles) {
     stencilTiles = std::move(tiles);
 }
 
+bool TileLayerGroup::isCulled(const gfx::Drawable& drawable, const PaintParameters& parameters) {
+    // Only 2D drawables clipped to their tile are known to stay within its bounds
+    const auto& tileID = drawable.getTileID();
+    if (!tileID || drawable.getIs3D() || !drawable.getEnableStencil()) {
+        return false;
+    }
+    return parameters.isTileCulled(tileID->toUnwrapped());
+}
+
 } // namespace mbgl
@@ -5,6 +5,7 @@
 #include <mbgl/renderer/query.hpp>
 #include <mbgl/map/transform.hpp>
 #include <mbgl/math/clamp.hpp>
+#include <mbgl/util/tile_coordinate.hpp>
 #include <mbgl/util/tile_cover.hpp>
 #include <mbgl/util/tile_range.hpp>
 #include <mbgl/util/enum.hpp>
@@ -23,6 +24,22 @@ using namespace style;
 
 static TileObserver nullObserver;
 
+namespace {
+
+// Tiles at the ideal zoom level under the center of the screen load first,
+// followed by the tiles around them and by the tiles at other zoom levels.
+// `center` is in tile units at zoom level 0.
+Resource::Priority tilePriority(const OverscaledTileID& id, const TileCoordinatePoint& center, int32_t idealZoom) {
+    const double scale = std::pow(2.0, id.canonical.z);
+    const double dx = id.canonical.x + id.wrap * scale + 0.5 - center.x * scale;
+    const double dy = id.canonical.y + 0.5 - center.y * scale;
+    const auto ring = static_cast<int32_t>(std::min(std::round(std::max(std::abs(dx), std::abs(dy))), 7.0));
+    const int32_t zoomDelta = std::min(std::abs(idealZoom - static_cast<int32_t>(id.canonical.z)), 3);
+    return Resource::priorityAt(static_cast<uint8_t>(32 + 32 * zoomDelta + 8 * ring));
+}
+
+} // namespace
+
 TilePyramid::TilePyramid()
     : observer(&nullObserver) {}
 
@@ -93,13 +110,13 @@ void TilePyramid::update(const std::vector<Immutable<style::LayerProperties>>& l
     const std::optional<uint8_t>& maxParentTileOverscaleFactor = sourceImpl.getMaxOverscaleFactorForParentTiles();
     const Duration minimumUpdateInterval = sourceImpl.getMinimumTileUpdateInterval();
     const bool isVolatile = sourceImpl.isVolatile();
+    const bool staleWhileRevalidate = sourceImpl.isStaleWhileRevalidate();
 
     std::vector<OverscaledTileID> idealTiles;
     std::vector<OverscaledTileID> panTiles;
+    int32_t idealZoom = std::min<int32_t>(zoomRange.max, overscaledZoom);
 
     if (overscaledZoom >= zoomRange.min) {
-        int32_t idealZoom = std::min<int32_t>(zoomRange.max, overscaledZoom);
-
         // Make sure we're not reparsing overzoomed raster tiles.
         if (type == SourceType::Raster) {
             tileZoom = idealZoom;
@@ -138,9 +155,15 @@ void TilePyramid::update(const std::vector<Immutable<style::LayerProperties>>& l
     // using, e.g. as a replacement for tile that aren't loaded yet.
     std::set<OverscaledTileID> retain;
 
+    const Size size = parameters.transformState.getSize();
+    const TileCoordinatePoint center =
+        TileCoordinate::fromScreenCoordinate(parameters.transformState, 0, {size.width / 2.0, size.height / 2.0}).p;
+
     auto retainTileFn = [&](Tile& tile, TileNecessity necessity) -> void {
         if (retain.emplace(tile.id).second) {
-            tile.setUpdateParameters({minimumUpdateInterval, isVolatile});
+            tile.setUpdateParameters({minimumUpdateInterval, isVolatile, staleWhileRevalidate});
+            // Set before the necessity, so that a network request made now is queued at the right priority.
+            tile.setPriority(tilePriority(tile.id, center, idealZoom));
             tile.setNecessity(necessity);
         }
 
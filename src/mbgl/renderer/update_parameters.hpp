@@ -44,6 +44,9 @@ public:
     const bool stillImageRequest;
 
     const bool crossSourceCollisions;
+
+    // Place independent collision domains concurrently
+    const bool parallelPlacement;
 };
 
 } // namespace mbgl
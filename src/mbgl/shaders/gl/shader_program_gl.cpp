@@ -103,7 +103,8 @@ ShaderProgramGL::ShaderProgramGL(ShaderProgramGL&& other)
       glProgram(std::move(other.glProgram)),
       uniformBlocks(std::move(other.uniformBlocks)),
       vertexAttributes(std::move(other.vertexAttributes)),
-      samplerLocations(std::move(other.samplerLocations)) {}
+      samplerLocations(std::move(other.samplerLocations)),
+      samplerUnits(std::move(other.samplerUnits)) {}
 
 std::optional<uint32_t> ShaderProgramGL::getSamplerLocation(const StringIdentity id) const {
     std::optional<uint32_t> result{};
@@ -113,6 +114,15 @@ std::optional<uint32_t> ShaderProgramGL::getSamplerLocation(const StringIdentity
     return result;
 }
 
+bool ShaderProgramGL::setSamplerUnit(int32_t location, int32_t textureUnit) {
+    if (auto it = samplerUnits.find(location); it != samplerUnits.end() && it->second == textureUnit) {
+        return false;
+    }
+    MBGL_CHECK_ERROR(glUniform1i(location, textureUnit));
+    samplerUnits.insert_or_assign(location, textureUnit);
+    return true;
+}
+
 std::shared_ptr<ShaderProgramGL> ShaderProgramGL::create(Context& context,
                                                          const ProgramParameters& programParameters,
                                                          const std::string& /*name*/,
@@ -120,23 +130,34 @@ std::shared_ptr<ShaderProgramGL> ShaderProgramGL::create(Context& context,
                                                          const std::string& vertexSource,
                                                          const std::string& fragmentSource,
                                                          const std::string& additionalDefines) noexcept(false) {
-    // throws on compile error
-    auto vertProg = context.createShader(
-        ShaderType::Vertex,
-        std::initializer_list<const char*>{
-            "#version 300 es\n",
-            programParameters.getDefinesString().c_str(),
-            additionalDefines.c_str(),
-            shaders::ShaderSource<shaders::BuiltIn::Prelude, gfx::Backend::Type::OpenGL>::vertex,
-            vertexSource.c_str()});
-    auto fragProg = context.createShader(
-        ShaderType::Fragment,
+    return finish(context,
+                  start(context, programParameters, firstAttribName, vertexSource, fragmentSource, additionalDefines));
+}
+
+Context::ProgramBuild ShaderProgramGL::start(Context& context,
+                                             const ProgramParameters& programParameters,
+                                             const std::string_view firstAttribName,
+                                             const std::string& vertexSource,
+                                             const std::string& fragmentSource,
+                                             const std::string& additionalDefines) {
+    return context.startProgram(
+        {"#version 300 es\n",
+         programParameters.getDefinesString().c_str(),
+         additionalDefines.c_str(),
+         shaders::ShaderSource<shaders::BuiltIn::Prelude, gfx::Backend::Type::OpenGL>::vertex,
+         vertexSource.c_str()},
         {"#version 300 es\n",
          programParameters.getDefinesString().c_str(),
          additionalDefines.c_str(),
          shaders::ShaderSource<shaders::BuiltIn::Prelude, gfx::Backend::Type::OpenGL>::fragment,
-         fragmentSource.c_str()});
-    auto program = context.createProgram(vertProg, fragProg, firstAttribName.data());
+         fragmentSource.c_str()},
+        firstAttribName.data());
+}
+
+std::shared_ptr<ShaderProgramGL> ShaderProgramGL::finish(Context& context,
+                                                         Context::ProgramBuild&& build) noexcept(false) {
+    // throws on compile error
+    auto program = context.finishProgram(std::move(build));
 
     // GLES3.1
     // GLint numAttribs;
@@ -0,0 +1,60 @@
+#include <mbgl/storage/response_buffer_pool.hpp>
+
+#include <algorithm>
+
+namespace mbgl {
+
+std::shared_ptr<std::string> ResponseBufferPool::acquire(std::size_t sizeHint) {
+    // Don't trust the server with unbounded allocations, the buffer still grows as needed
+    const std::size_t reservation = std::min(sizeHint, maxReservation);
+    const std::size_t maxCapacity = std::max(reservation * maxReuseFactor, minReuseCapacity);
+
+    std::unique_ptr<std::string> buffer;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        // The smallest idle buffer that fits, so that larger ones stay available for larger responses
+        auto best = buffers.end();
+        for (auto it = buffers.begin(); it != buffers.end(); ++it) {
+            const std::size_t capacity = (*it)->capacity();
+            if (capacity >= reservation && capacity <= maxCapacity &&
+                (best == buffers.end() || capacity < (*best)->capacity())) {
+                best = it;
+            }
+        }
+        if (best != buffers.end()) {
+            buffer = std::move(*best);
+            buffers.erase(best);
+        }
+    }
+    if (!buffer) {
+        buffer = std::make_unique<std::string>();
+    }
+
+    buffer->reserve(reservation);
+
+    return std::shared_ptr<std::string>(buffer.release(), [weakPool = weak_from_this()](std::string* released) {
+        std::unique_ptr<std::string> owned(released);
+        if (auto pool = weakPool.lock()) {
+            pool->release(std::move(owned));
+        }
+    });
+}
+
+std::size_t ResponseBufferPool::size() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return buffers.size();
+}
+
+void ResponseBufferPool::release(std::unique_ptr<std::string> buffer) {
+    if (buffer->capacity() > maxPooledCapacity) {
+        return;
+    }
+    buffer->clear();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (buffers.size() < maxPooledBuffers) {
+        buffers.push_back(std::move(buffer));
+    }
+}
+
+} // namespace mbgl
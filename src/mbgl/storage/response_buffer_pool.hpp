@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace mbgl {
+
+// Recycles response body buffers. A buffer goes back to the pool, keeping its capacity, when
+// the last reference to the response data is dropped, which may happen on any thread.
+//
+// The buffers become the response data, which tiles, glyphs and the caches may keep for a long
+// time, so a buffer is only reused for a response of about its size.
+class ResponseBufferPool : public std::enable_shared_from_this<ResponseBufferPool> {
+public:
+    // Returns an empty buffer with room for `sizeHint` bytes.
+    std::shared_ptr<std::string> acquire(std::size_t sizeHint);
+
+    // The number of idle buffers.
+    std::size_t size();
+
+    // Idle buffers are only reused when their capacity is at most this many times the size
+    // hint, or the minimum below.
+    static constexpr std::size_t maxReuseFactor = 2;
+    static constexpr std::size_t minReuseCapacity = 16 * 1024;
+
+    // Bounds the memory held by idle buffers to 16 MiB
+    static constexpr std::size_t maxPooledBuffers = 16;
+    static constexpr std::size_t maxPooledCapacity = 1024 * 1024;
+    static constexpr std::size_t maxReservation = 32 * 1024 * 1024;
+
+private:
+    void release(std::unique_ptr<std::string>);
+
+    std::mutex mutex;
+    std::vector<std::unique_ptr<std::string>> buffers;
+};
+
+} // namespace mbgl
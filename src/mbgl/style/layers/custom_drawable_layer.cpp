@@ -21,7 +21,7 @@
 #include <mbgl/tile/geometry_tile_data.hpp>
 #include <mbgl/util/containers.hpp>
 
-#include <mbgl/gfx/fill_generator.hpp>
+#include <mbgl/gfx/drawable_geometry.hpp>
 
 namespace mbgl {
 
@@ -276,7 +276,31 @@ void CustomDrawableLayerHost::Interface::addPolyline(const GeometryCoordinates&
     builder->addPolyline(coordinates, lineOptions.geometry);
 }
 
+void CustomDrawableLayerHost::Interface::addPolylines(const gfx::PolylineGeometry& geometry) {
+    if (!lineShader) lineShader = lineShaderDefault();
+    assert(lineShader);
+    if (!builder || builder->getShader() != lineShader) {
+        builder = createBuilder("lines", lineShader);
+    }
+    assert(builder);
+    assert(builder->getShader() == lineShader);
+
+    // keep polylines added one at a time in their own drawable
+    builder->flush(context);
+    builder->setPolylineGeometry(context, geometry);
+
+    // flush current builder drawable
+    builder->flush(context);
+}
+
 void CustomDrawableLayerHost::Interface::addFill(const GeometryCollection& geometry) {
+    // generate fill geometry into buffers
+    gfx::FillGeometry fill;
+    fill.add(geometry);
+    addFill(fill);
+}
+
+void CustomDrawableLayerHost::Interface::addFill(const gfx::FillGeometry& geometry) {
     if (!fillShader) fillShader = fillShaderDefault();
     assert(fillShader);
     if (!builder || builder->getShader() != fillShader) {
@@ -284,36 +308,7 @@ void CustomDrawableLayerHost::Interface::addFill(const GeometryCollection& geome
     }
     assert(builder);
     assert(builder->getShader() == fillShader);
-
-    // provision buffers for fill vertices, indexes and segments
-    using VertexVector = gfx::VertexVector<FillLayoutVertex>;
-    const std::shared_ptr<VertexVector> sharedVertices = std::make_shared<VertexVector>();
-    VertexVector& vertices = *sharedVertices;
-
-    using TriangleIndexVector = gfx::IndexVector<gfx::Triangles>;
-    const std::shared_ptr<TriangleIndexVector> sharedTriangles = std::make_shared<TriangleIndexVector>();
-    TriangleIndexVector& triangles = *sharedTriangles;
-
-    SegmentVector<FillAttributes> triangleSegments;
-
-    // generate fill geometry into buffers
-    gfx::generateFillBuffers(geometry, vertices, triangles, triangleSegments);
-
-    // add to builder
-    static const StringIdentity idVertexAttribName = stringIndexer().get("a_pos");
-    builder->setVertexAttrNameId(idVertexAttribName);
-
-    auto attrs = context.createVertexAttributeArray();
-    if (const auto& attr = attrs->add(idVertexAttribName)) {
-        attr->setSharedRawData(sharedVertices,
-                               offsetof(FillLayoutVertex, a1),
-                               /*vertexOffset=*/0,
-                               sizeof(FillLayoutVertex),
-                               gfx::AttributeDataType::Short2);
-    }
-    builder->setVertexAttributes(std::move(attrs));
-    builder->setRawVertices({}, vertices.elements(), gfx::AttributeDataType::Short2);
-    builder->setSegments(gfx::Triangles(), sharedTriangles, triangleSegments.data(), triangleSegments.size());
+    builder->setFillGeometry(context, geometry);
 
     // flush current builder drawable
     builder->flush(context);
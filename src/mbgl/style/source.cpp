@@ -38,6 +38,18 @@ void Source::setVolatile(bool set) noexcept {
     observer->onSourceChanged(*this);
 }
 
+bool Source::isStaleWhileRevalidate() const noexcept {
+    return baseImpl->isStaleWhileRevalidate();
+}
+
+void Source::setStaleWhileRevalidate(bool set) noexcept {
+    if (isStaleWhileRevalidate() == set) return;
+    auto newImpl = createMutable();
+    newImpl->setStaleWhileRevalidate(set);
+    baseImpl = std::move(newImpl);
+    observer->onSourceChanged(*this);
+}
+
 void Source::setObserver(SourceObserver* observer_) {
     observer = observer_ ? observer_ : &nullObserver;
 }
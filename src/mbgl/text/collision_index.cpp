@@ -379,6 +379,11 @@ bool polygonIntersectsBox(const LineString<float>& polygon, const GridIndex<Inde
     return util::polygonIntersectsPolygon(integerPolygon, bboxPoints);
 }
 
+void CollisionIndex::merge(const CollisionIndex& other) {
+    collisionGrid.merge(other.collisionGrid);
+    ignoredGrid.merge(other.ignoredGrid);
+}
+
 std::unordered_map<uint32_t, std::vector<IndexedSubfeature>> CollisionIndex::queryRenderedSymbols(
     const ScreenLineString& queryGeometry) const {
     std::unordered_map<uint32_t, std::vector<IndexedSubfeature>> result;
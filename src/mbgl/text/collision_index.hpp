@@ -58,6 +58,9 @@ public:
                        uint32_t bucketInstanceId,
                        uint16_t collisionGroupId);
 
+    // Appends the features placed into another index built for the same transform state.
+    void merge(const CollisionIndex&);
+
     std::unordered_map<uint32_t, std::vector<IndexedSubfeature>> queryRenderedSymbols(const ScreenLineString&) const;
 
     CollisionBoundaries projectTileBoundaries(const mat4& posMatrix) const;
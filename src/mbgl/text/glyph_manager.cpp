@@ -1,9 +1,11 @@
+#include <mbgl/actor/scheduler.hpp>
 #include <mbgl/storage/file_source.hpp>
 #include <mbgl/storage/resource.hpp>
 #include <mbgl/storage/response.hpp>
 #include <mbgl/text/glyph_manager.hpp>
 #include <mbgl/text/glyph_manager_observer.hpp>
 #include <mbgl/text/glyph_pbf.hpp>
+#include <mbgl/text/local_glyph_cache.hpp>
 #include <mbgl/util/async_request.hpp>
 #include <mbgl/util/std.hpp>
 #include <mbgl/util/tiny_sdf.hpp>
@@ -14,7 +16,8 @@ static GlyphManagerObserver nullObserver;
 
 GlyphManager::GlyphManager(std::unique_ptr<LocalGlyphRasterizer> localGlyphRasterizer_)
     : observer(&nullObserver),
-      localGlyphRasterizer(std::move(localGlyphRasterizer_)) {}
+      localGlyphRasterizer(std::move(localGlyphRasterizer_)),
+      threadPool(Scheduler::GetBackground()) {}
 
 GlyphManager::~GlyphManager() = default;
 
@@ -32,16 +35,33 @@ void GlyphManager::getGlyphs(GlyphRequestor& requestor, GlyphDependencies glyphD
 
         const GlyphIDs& glyphIDs = dependency.second;
         std::unordered_set<GlyphRange> ranges;
+        std::vector<Glyph> localGlyphs;
         for (const auto& glyphID : glyphIDs) {
             if (localGlyphRasterizer->canRasterizeGlyph(fontStack, glyphID)) {
-                if (entry.glyphs.find(glyphID) == entry.glyphs.end()) {
-                    entry.glyphs.emplace(glyphID, makeMutable<Glyph>(generateLocalSDF(fontStack, glyphID)));
+                if (entry.glyphs.find(glyphID) != entry.glyphs.end()) {
+                    continue;
+                }
+                if (auto cached = localGlyphCache ? localGlyphCache->get(fontStack, glyphID) : std::nullopt) {
+                    entry.glyphs.emplace(glyphID, std::move(*cached));
+                } else {
+                    auto pending = entry.pendingLocalGlyphs.find(glyphID);
+                    if (pending == entry.pendingLocalGlyphs.end()) {
+                        // Rasterization stays on this thread, as platform
+                        // rasterizers are not required to be thread-safe.
+                        localGlyphs.push_back(localGlyphRasterizer->rasterizeGlyph(fontStack, glyphID));
+                        pending = entry.pendingLocalGlyphs.emplace(glyphID, Requestors()).first;
+                    }
+                    pending->second[&requestor] = dependencies;
                 }
             } else {
                 ranges.insert(getGlyphRange(glyphID));
             }
         }
 
+        if (!localGlyphs.empty()) {
+            generateLocalSDFs(fontStack, std::move(localGlyphs));
+        }
+
         for (const auto& range : ranges) {
             auto it = entry.ranges.find(range);
             if (it == entry.ranges.end() || !it->second.parsed) {
@@ -59,10 +79,58 @@ void GlyphManager::getGlyphs(GlyphRequestor& requestor, GlyphDependencies glyphD
     }
 }
 
-Glyph GlyphManager::generateLocalSDF(const FontStack& fontStack, GlyphID glyphID) {
-    Glyph local = localGlyphRasterizer->rasterizeGlyph(fontStack, glyphID);
-    local.bitmap = util::transformRasterToSDF(local.bitmap, 8, .25);
-    return local;
+void GlyphManager::generateLocalSDFs(const FontStack& fontStack, std::vector<Glyph> rasterized) {
+    auto glyphs = std::make_shared<std::vector<Glyph>>(std::move(rasterized));
+
+    auto sdfClosure = [glyphs] {
+        for (auto& glyph : *glyphs) {
+            glyph.bitmap = util::transformRasterToSDF(glyph.bitmap, 8, .25);
+        }
+        return glyphs;
+    };
+
+    auto resultClosure = [this, fontStack, weak = weakFactory.makeWeakPtr()](
+                             const std::shared_ptr<std::vector<Glyph>>& result) {
+        if (!weak) return; // This instance has been deleted.
+        onLocalSDFsGenerated(fontStack, std::move(*result));
+    };
+
+    threadPool->scheduleAndReplyValue(sdfClosure, resultClosure);
+}
+
+void GlyphManager::onLocalSDFsGenerated(const FontStack& fontStack, std::vector<Glyph> generated) {
+    std::vector<Immutable<Glyph>> glyphs;
+    glyphs.reserve(generated.size());
+    for (auto& glyph : generated) {
+        glyphs.emplace_back(makeMutable<Glyph>(std::move(glyph)));
+    }
+
+    if (localGlyphCache) {
+        for (const auto& glyph : glyphs) {
+            localGlyphCache->put(fontStack, glyph);
+        }
+        // Flushes queued behind each other find nothing left to write.
+        threadPool->schedule([cache = localGlyphCache] { cache->flush(); });
+    }
+
+    auto it = entries.find(fontStack);
+    if (it == entries.end()) {
+        return; // The font stack has been evicted in the meantime.
+    }
+
+    Entry& entry = it->second;
+    Requestors requestors;
+    for (auto& glyph : glyphs) {
+        const GlyphID id = glyph->id;
+        auto pending = entry.pendingLocalGlyphs.find(id);
+        if (pending != entry.pendingLocalGlyphs.end()) {
+            requestors.insert(pending->second.begin(), pending->second.end());
+            entry.pendingLocalGlyphs.erase(pending);
+        }
+        entry.glyphs.emplace(id, std::move(glyph));
+    }
+
+    notifyRequestors(requestors);
 }
 
 void GlyphManager::requestRange(GlyphRequest& request,
@@ -88,43 +156,69 @@ void GlyphManager::processResponse(const Response& res, const FontStack& fontSta
         return;
     }
 
-    Entry& entry = entries[fontStack];
-    GlyphRequest& request = entry.ranges[range];
+    if (res.noContent) {
+        onRangeParsed(fontStack, range, {});
+        return;
+    }
 
-    if (!res.noContent) {
-        std::vector<Glyph> glyphs;
+    struct ParseResult {
+        std::shared_ptr<std::vector<Glyph>> glyphs;
+        std::exception_ptr error;
+    };
 
+    auto parseClosure = [range, data = res.data]() -> ParseResult {
         try {
-            glyphs = parseGlyphPBF(range, *res.data);
+            return {std::make_shared<std::vector<Glyph>>(parseGlyphPBF(range, *data)), nullptr};
         } catch (...) {
-            observer->onGlyphsError(fontStack, range, std::current_exception());
-            return;
+            return {nullptr, std::current_exception()};
         }
+    };
 
-        for (auto& glyph : glyphs) {
-            auto id = glyph.id;
-            if (!localGlyphRasterizer->canRasterizeGlyph(fontStack, id)) {
-                entry.glyphs.erase(id);
-                entry.glyphs.emplace(id, makeMutable<Glyph>(std::move(glyph)));
-            }
+    auto resultClosure = [this, fontStack, range, weak = weakFactory.makeWeakPtr()](const ParseResult& result) {
+        if (!weak) return; // This instance has been deleted.
+
+        if (result.error) {
+            observer->onGlyphsError(fontStack, range, result.error);
+            return;
         }
+        onRangeParsed(fontStack, range, std::move(*result.glyphs));
+    };
+
+    threadPool->scheduleAndReplyValue(parseClosure, resultClosure);
+}
+
+void GlyphManager::onRangeParsed(const FontStack& fontStack, const GlyphRange& range, std::vector<Glyph> glyphs) {
+    auto it = entries.find(fontStack);
+    if (it == entries.end()) {
+        return; // The font stack has been evicted in the meantime.
     }
 
-    request.parsed = true;
+    Entry& entry = it->second;
+    GlyphRequest& request = entry.ranges[range];
 
-    for (auto& pair : request.requestors) {
-        GlyphRequestor& requestor = *pair.first;
-        const std::shared_ptr<GlyphDependencies>& dependencies = pair.second;
-        if (dependencies.unique()) {
-            notify(requestor, *dependencies);
+    for (auto& glyph : glyphs) {
+        auto id = glyph.id;
+        if (!localGlyphRasterizer->canRasterizeGlyph(fontStack, id)) {
+            entry.glyphs.erase(id);
+            entry.glyphs.emplace(id, makeMutable<Glyph>(std::move(glyph)));
         }
     }
 
-    request.requestors.clear();
+    request.parsed = true;
+
+    notifyRequestors(request.requestors);
 
     observer->onGlyphsLoaded(fontStack, range);
 }
 
+void GlyphManager::setLocalGlyphCache(std::shared_ptr<LocalGlyphCache> cache) {
+    localGlyphCache = std::move(cache);
+    if (localGlyphCache) {
+        // Glyphs looked up before the file is read are rasterized as usual
+        threadPool->schedule([cache = localGlyphCache] { cache->load(); });
+    }
+}
+
 void GlyphManager::setObserver(GlyphManagerObserver* observer_) {
     observer = observer_ ? observer_ : &nullObserver;
 }
@@ -152,11 +246,26 @@ void GlyphManager::notify(GlyphRequestor& requestor, const GlyphDependencies& gl
     requestor.onGlyphsAvailable(response);
 }
 
+void GlyphManager::notifyRequestors(Requestors& requestors) {
+    for (auto& pair : requestors) {
+        GlyphRequestor& requestor = *pair.first;
+        const std::shared_ptr<GlyphDependencies>& dependencies = pair.second;
+        if (dependencies.unique()) {
+            notify(requestor, *dependencies);
+        }
+    }
+
+    requestors.clear();
+}
+
 void GlyphManager::removeRequestor(GlyphRequestor& requestor) {
     for (auto& entry : entries) {
         for (auto& range : entry.second.ranges) {
             range.second.requestors.erase(&requestor);
         }
+        for (auto& pending : entry.second.pendingLocalGlyphs) {
+            pending.second.erase(&requestor);
+        }
     }
 }
 
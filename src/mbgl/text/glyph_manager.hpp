@@ -7,14 +7,19 @@
 #include <mbgl/util/font_stack.hpp>
 #include <mbgl/util/immutable.hpp>
 
+#include <mapbox/std/weak.hpp>
+
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace mbgl {
 
 class FileSource;
 class AsyncRequest;
 class Response;
+class Scheduler;
+class LocalGlyphCache;
 
 class GlyphRequestor {
 public:
@@ -36,7 +41,9 @@ public:
     // determined their `GlyphDependencies`. If all glyphs are already locally
     // available, GlyphManager will provide them to the requestor immediately.
     // Otherwise, it makes a request on the FileSource is made for each range
-    // needed, and notifies the observer when all are complete.
+    // needed, and notifies the observer when all are complete. Glyph PBF
+    // decoding and SDF generation of locally rasterized glyphs run on the
+    // background thread pool; results are applied back on this thread.
     void getGlyphs(GlyphRequestor&, GlyphDependencies, FileSource&);
     void removeRequestor(GlyphRequestor&);
 
@@ -44,33 +51,47 @@ public:
 
     void setObserver(GlyphManagerObserver*);
 
+    // Locally generated glyph SDFs are looked up in and added to this cache,
+    // which persists them across sessions.
+    void setLocalGlyphCache(std::shared_ptr<LocalGlyphCache>);
+
     // Remove glyphs for all but the supplied font stacks.
     void evict(const std::set<FontStack>&);
 
 private:
-    Glyph generateLocalSDF(const FontStack& fontStack, GlyphID glyphID);
     std::string glyphURL;
 
+    using Requestors = std::unordered_map<GlyphRequestor*, std::shared_ptr<GlyphDependencies>>;
+
     struct GlyphRequest {
         bool parsed = false;
         std::unique_ptr<AsyncRequest> req;
-        std::unordered_map<GlyphRequestor*, std::shared_ptr<GlyphDependencies>> requestors;
+        Requestors requestors;
     };
 
     struct Entry {
         std::map<GlyphRange, GlyphRequest> ranges;
         std::map<GlyphID, Immutable<Glyph>> glyphs;
+        // Locally rasterized glyphs whose SDF is still being generated.
+        std::map<GlyphID, Requestors> pendingLocalGlyphs;
     };
 
     std::unordered_map<FontStack, Entry, FontStackHasher> entries;
 
     void requestRange(GlyphRequest&, const FontStack&, const GlyphRange&, FileSource& fileSource);
     void processResponse(const Response&, const FontStack&, const GlyphRange&);
+    void onRangeParsed(const FontStack&, const GlyphRange&, std::vector<Glyph>);
+    void generateLocalSDFs(const FontStack&, std::vector<Glyph>);
+    void onLocalSDFsGenerated(const FontStack&, std::vector<Glyph>);
     void notify(GlyphRequestor&, const GlyphDependencies&);
+    void notifyRequestors(Requestors&);
 
     GlyphManagerObserver* observer = nullptr;
 
     std::unique_ptr<LocalGlyphRasterizer> localGlyphRasterizer;
+    std::shared_ptr<LocalGlyphCache> localGlyphCache;
+    std::shared_ptr<Scheduler> threadPool;
+    mapbox::base::WeakPtrFactory<GlyphManager> weakFactory{this};
 };
 
 } // namespace mbgl
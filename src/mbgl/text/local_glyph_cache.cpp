@@ -0,0 +1,298 @@
+#include <mbgl/text/local_glyph_cache.hpp>
+#include <mbgl/util/cache_file.hpp>
+#include <mbgl/util/compression.hpp>
+#include <mbgl/util/io.hpp>
+#include <mbgl/util/logging.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace mbgl {
+
+namespace {
+
+using namespace util::cache_file;
+
+constexpr const char magic[4] = {'M', 'L', 'N', 'G'};
+
+} // namespace
+
+LocalGlyphCache::LocalGlyphCache(std::string path_, std::optional<std::string> fontFamily_, std::size_t maxSize_)
+    : path(std::move(path_)),
+      fontFamily(fontFamily_ ? *fontFamily_ : std::string()),
+      maxSize(maxSize_) {}
+
+std::optional<Immutable<Glyph>> LocalGlyphCache::get(const FontStack& fontStack, GlyphID glyphID) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = index.find({fontStackToString(fontStack), glyphID});
+    if (it == index.end()) {
+        return std::nullopt;
+    }
+    entries.splice(entries.begin(), entries, it->second);
+    return it->second->second;
+}
+
+void LocalGlyphCache::put(const FontStack& fontStack, Immutable<Glyph> glyph) {
+    std::lock_guard<std::mutex> lock(mutex);
+    Key key{fontStackToString(fontStack), glyph->id};
+    pending.push_back(key);
+    insert(std::move(key), std::move(glyph), true);
+    evict();
+}
+
+std::size_t LocalGlyphCache::size() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+}
+
+void LocalGlyphCache::insert(Key key, Immutable<Glyph> glyph, bool recent) {
+    if (auto it = index.find(key); it != index.end()) {
+        currentSize -= sizeOf(*it->second);
+        entries.erase(it->second);
+        index.erase(it);
+    }
+    auto it = entries.emplace(recent ? entries.begin() : entries.end(), std::move(key), std::move(glyph));
+    currentSize += sizeOf(*it);
+    index.emplace(it->first, it);
+}
+
+void LocalGlyphCache::evict() {
+    while (currentSize > maxSize && !entries.empty()) {
+        currentSize -= sizeOf(entries.back());
+        index.erase(entries.back().first);
+        entries.pop_back();
+    }
+}
+
+std::size_t LocalGlyphCache::sizeOf(const Entry& entry) {
+    return sizeof(Entry) + entry.first.first.size() + entry.second->bitmap.bytes();
+}
+
+void LocalGlyphCache::load() {
+    std::lock_guard<std::mutex> fileLock(fileMutex);
+    read();
+}
+
+void LocalGlyphCache::read() {
+    if (loaded) {
+        return;
+    }
+    loaded = true;
+
+    const std::optional<std::string> data = util::readFile(path);
+    if (!data) {
+        return;
+    }
+
+    try {
+        auto decoded = decode(fontFamily, *data);
+        if (!decoded) {
+            Log::Info(Event::Glyph, "Discarding outdated local glyph cache");
+            return;
+        }
+        if (decoded->truncated) {
+            Log::Warning(Event::Glyph, "Local glyph cache is truncated, keeping the glyphs before that");
+        }
+        appendable = !decoded->truncated;
+        fileSize = decoded->size;
+        merge(std::move(decoded->entries));
+    } catch (const std::exception& ex) {
+        Log::Warning(Event::Glyph, std::string("Can't read local glyph cache: ") + ex.what());
+    }
+}
+
+void LocalGlyphCache::merge(std::vector<Entry> decoded) {
+    // Later batches are more recent, and glyphs added in the meantime more recent still
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto it = decoded.rbegin(); it != decoded.rend(); ++it) {
+        if (index.find(it->first) == index.end()) {
+            insert(std::move(it->first), std::move(it->second), false);
+        }
+    }
+    evict();
+}
+
+void LocalGlyphCache::flush() {
+    // Serializes concurrent flushes of this cache and makes sure the file is
+    // read before it's written.
+    std::lock_guard<std::mutex> fileLock(fileMutex);
+    read();
+
+    std::vector<Entry> batch;
+    std::size_t batchSize = 0;
+    bool rewrite = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (pending.empty()) {
+            return;
+        }
+        std::sort(pending.begin(), pending.end());
+        pending.erase(std::unique(pending.begin(), pending.end()), pending.end());
+        for (const auto& key : pending) {
+            // Glyphs evicted in the meantime aren't worth keeping
+            if (auto it = index.find(key); it != index.end()) {
+                batchSize += sizeOf(*it->second);
+                batch.push_back(*it->second);
+            }
+        }
+        pending.clear();
+
+        // Rewriting drops the glyphs which were replaced or evicted since the file was last written
+        rewrite = !appendable || fileSize + batchSize > 2 * maxSize;
+    }
+    if (batch.empty()) {
+        return;
+    }
+
+    try {
+        // Other renderers and processes using the same cache path write the same
+        // file. Appending is only safe if the file still has the header written
+        // for this cache, e.g., not one for another font family.
+        const Lock lock(path);
+        const std::string header = encodeHeader(fontFamily);
+        rewrite = rewrite || !hasHeader(header);
+
+        if (rewrite) {
+            // Keep the glyphs that other writers added to the file since it was read
+            if (const auto data = util::readFile(path)) {
+                if (auto decoded = decode(fontFamily, *data)) {
+                    merge(std::move(decoded->entries));
+                }
+            }
+            {
+                // Least recently used first, so that they're read back in the same order
+                std::lock_guard<std::mutex> guard(mutex);
+                batch.assign(entries.rbegin(), entries.rend());
+                batchSize = currentSize;
+            }
+            if (!replace(path, header + encodeBatch(batch))) {
+                Log::Warning(Event::Glyph, "Can't replace local glyph cache");
+                return;
+            }
+            appendable = true;
+            fileSize = batchSize;
+        } else {
+            // An interrupted append leaves a batch that can't be read, and the
+            // file is rewritten after the next load. Batches appended by other
+            // writers aren't counted in `fileSize`, which only delays a rewrite.
+            if (!append(path, encodeBatch(batch))) {
+                appendable = false;
+                Log::Warning(Event::Glyph, "Can't append to local glyph cache");
+                return;
+            }
+            fileSize += batchSize;
+        }
+    } catch (const std::exception& ex) {
+        Log::Warning(Event::Glyph, std::string("Can't write local glyph cache: ") + ex.what());
+    }
+}
+
+bool LocalGlyphCache::hasHeader(const std::string& header) const {
+    std::ifstream file(path, std::ios::binary);
+    std::string fileHeader(header.size(), '\0');
+    return file.read(fileHeader.data(), static_cast<std::streamsize>(fileHeader.size())) && fileHeader == header;
+}
+
+// File layout: magic, version and font family, followed by batches of glyph
+// records, each zlib compressed and preceded by its compressed size.
+std::string LocalGlyphCache::encodeHeader(const std::string& fontFamily) {
+    std::string out(magic, sizeof(magic));
+    write<uint32_t>(out, version);
+    writeString(out, fontFamily);
+    return out;
+}
+
+std::string LocalGlyphCache::encodeBatch(const std::vector<Entry>& batch) {
+    std::string body;
+    write<uint32_t>(body, static_cast<uint32_t>(batch.size()));
+    for (const auto& [key, glyph] : batch) {
+        writeString(body, key.first);
+        write<uint16_t>(body, static_cast<uint16_t>(key.second));
+        write<uint32_t>(body, glyph->metrics.width);
+        write<uint32_t>(body, glyph->metrics.height);
+        write<int32_t>(body, glyph->metrics.left);
+        write<int32_t>(body, glyph->metrics.top);
+        write<uint32_t>(body, glyph->metrics.advance);
+        const Size size = glyph->bitmap.valid() ? glyph->bitmap.size : Size();
+        write<uint32_t>(body, size.width);
+        write<uint32_t>(body, size.height);
+        if (glyph->bitmap.valid()) {
+            body.append(reinterpret_cast<const char*>(glyph->bitmap.data.get()), glyph->bitmap.bytes());
+        }
+    }
+
+    std::string out;
+    writeString(out, util::compress(body));
+    return out;
+}
+
+std::optional<LocalGlyphCache::Decoded> LocalGlyphCache::decode(const std::string& fontFamily,
+                                                                 const std::string& data) {
+    Reader reader(data);
+    const char* fileMagic = nullptr;
+    uint32_t fileVersion = 0;
+    std::string fileFontFamily;
+    if (!reader.readBytes(sizeof(magic), fileMagic) || std::memcmp(fileMagic, magic, sizeof(magic)) != 0 ||
+        !reader.read(fileVersion) || fileVersion != version || !reader.readString(fileFontFamily) ||
+        fileFontFamily != fontFamily) {
+        return std::nullopt;
+    }
+
+    Decoded decoded;
+    while (!reader.empty()) {
+        std::string compressed;
+        std::string body;
+        try {
+            if (!reader.readString(compressed)) {
+                decoded.truncated = true;
+                break;
+            }
+            body = util::decompress(compressed);
+        } catch (const std::exception&) {
+            decoded.truncated = true;
+            break;
+        }
+
+        Reader batchReader(body);
+        uint32_t count = 0;
+        if (!batchReader.read(count)) {
+            decoded.truncated = true;
+            break;
+        }
+
+        std::vector<Entry> batch;
+        for (uint32_t i = 0; i < count; ++i) {
+            std::string fontStack;
+            uint16_t id = 0;
+            Glyph glyph;
+            Size size;
+            const char* bitmap = nullptr;
+            if (!batchReader.readString(fontStack) || !batchReader.read(id) ||
+                !batchReader.read(glyph.metrics.width) || !batchReader.read(glyph.metrics.height) ||
+                !batchReader.read(glyph.metrics.left) || !batchReader.read(glyph.metrics.top) ||
+                !batchReader.read(glyph.metrics.advance) || !batchReader.read(size.width) ||
+                !batchReader.read(size.height) ||
+                !batchReader.readBytes(static_cast<std::size_t>(size.width) * size.height, bitmap)) {
+                break;
+            }
+
+            glyph.id = static_cast<GlyphID>(id);
+            glyph.bitmap = AlphaImage(size, reinterpret_cast<const uint8_t*>(bitmap), size.area());
+            batch.emplace_back(Key{std::move(fontStack), glyph.id}, makeMutable<Glyph>(std::move(glyph)));
+        }
+        if (batch.size() != count) {
+            decoded.truncated = true;
+            break;
+        }
+
+        for (auto& entry : batch) {
+            decoded.size += sizeOf(entry);
+            decoded.entries.push_back(std::move(entry));
+        }
+    }
+
+    return decoded;
+}
+
+} // namespace mbgl
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <mbgl/text/glyph.hpp>
+#include <mbgl/util/font_stack.hpp>
+#include <mbgl/util/immutable.hpp>
+
+#include <list>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace mbgl {
+
+// Persists the SDF bitmaps of locally rasterized glyphs across sessions, so
+// that they don't need to be rasterized and transformed again on every start.
+//
+// The file starts with a header recording the format version and the local
+// font family the glyphs were rasterized with; a file with a different version
+// or font family is ignored and replaced on the next flush. Each flush appends
+// the glyphs added since the previous one as a compressed batch, and the file
+// is only rewritten once it holds about twice the glyphs the cache keeps.
+//
+// The cache keeps the most recently used glyphs up to `maxSize` bytes of
+// bitmaps. The file is read by `load`, which should run on a background
+// thread; until then, lookups find only the glyphs added since. Lookups and
+// insertions may happen on any thread. Renderers sharing a cache path, in the
+// same or other processes, share the file and take turns writing it.
+class LocalGlyphCache {
+public:
+    static constexpr uint32_t version = 1;
+    static constexpr std::size_t defaultMaxSize = 4 * 1024 * 1024;
+
+    LocalGlyphCache(std::string path, std::optional<std::string> fontFamily, std::size_t maxSize = defaultMaxSize);
+
+    std::optional<Immutable<Glyph>> get(const FontStack&, GlyphID);
+    void put(const FontStack&, Immutable<Glyph>);
+
+    // Reads the cache file, unless it was read already. Blocks on file I/O.
+    void load();
+
+    // Writes the glyphs added since the last flush, if any. Blocks on file I/O.
+    void flush();
+
+    std::size_t size();
+
+private:
+    using Key = std::pair<std::string, GlyphID>;
+    using Entry = std::pair<Key, Immutable<Glyph>>;
+    using Entries = std::list<Entry>;
+
+    // Reads the file, with `fileMutex` held
+    void read();
+    // Adds the glyphs read from the file that the cache doesn't have, as the least recently used
+    void merge(std::vector<Entry>);
+
+    // Adds or replaces a glyph, as the most recently used unless `recent` is false. These
+    // require `mutex` to be held.
+    void insert(Key, Immutable<Glyph>, bool recent);
+    void evict();
+
+    // Whether the file starts with the given header
+    bool hasHeader(const std::string& header) const;
+
+    static std::size_t sizeOf(const Entry&);
+    static std::string encodeHeader(const std::string& fontFamily);
+    static std::string encodeBatch(const std::vector<Entry>&);
+
+    struct Decoded {
+        std::vector<Entry> entries;
+        // Size of the glyphs in the batches read, see `sizeOf`
+        std::size_t size = 0;
+        // The file ends in a batch that couldn't be read, e.g., after an interrupted write
+        bool truncated = false;
+    };
+    static std::optional<Decoded> decode(const std::string& fontFamily, const std::string& data);
+
+    const std::string path;
+    const std::string fontFamily;
+    const std::size_t maxSize;
+
+    std::mutex mutex;
+    // Most recently used first
+    Entries entries;
+    std::map<Key, Entries::iterator> index;
+    std::size_t currentSize = 0;
+    // Glyphs added since the last flush
+    std::vector<Key> pending;
+
+    // Serializes loads and flushes of this cache, and guards the state of the
+    // file below. Writers in other caches are excluded by a file lock.
+    std::mutex fileMutex;
+    bool loaded = false;
+    // Whether new batches can be appended, rather than rewriting the file
+    bool appendable = false;
+    // Size of the glyphs in the file, including ones since replaced or evicted
+    std::size_t fileSize = 0;
+};
+
+} // namespace mbgl
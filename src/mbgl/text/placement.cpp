@@ -1,4 +1,5 @@
 #include <list>
+#include <mbgl/actor/scheduler.hpp>
 #include <mbgl/layout/symbol_layout.hpp>
 #include <mbgl/renderer/bucket.hpp>
 #include <mbgl/renderer/buckets/symbol_bucket.hpp>
@@ -8,6 +9,7 @@
 #include <mbgl/text/placement.hpp>
 #include <mbgl/tile/geometry_tile.hpp>
 #include <mbgl/util/math.hpp>
+#include <future>
 #include <utility>
 
 namespace mbgl {
@@ -200,6 +202,15 @@ Placement::Placement()
 Placement::~Placement() = default;
 
 void Placement::placeLayers(const RenderLayerReferences& layers) {
+    if (updateParameters && updateParameters->parallelPlacement) {
+        const auto domains = getCollisionDomains(layers);
+        if (domains.size() > 1) {
+            placeCollisionDomainsInParallel(domains);
+            commit();
+            return;
+        }
+    }
+
     for (auto it = layers.crbegin(); it != layers.crend(); ++it) {
         std::set<uint32_t> seenCrossTileIDs;
         placeLayer(*it, seenCrossTileIDs);
@@ -214,6 +225,107 @@ void Placement::placeLayer(const RenderLayer& layer, std::set<uint32_t>& seenCro
     }
 }
 
+namespace {
+// A layer neither tests against nor blocks any other symbol if all of its
+// symbols both allow overlap and ignore placement.
+bool isCollisionFree(const RenderLayer& layer) {
+    for (const BucketPlacementData& data : layer.getPlacementData()) {
+        const auto& layout = *static_cast<const SymbolBucket&>(data.bucket.get()).layout;
+        if (!layout.get<TextAllowOverlap>() || !layout.get<IconAllowOverlap>() ||
+            !layout.get<TextIgnorePlacement>() || !layout.get<IconIgnorePlacement>()) {
+            return false;
+        }
+    }
+    return true;
+}
+} // namespace
+
+std::vector<CollisionDomain> Placement::getCollisionDomains(const RenderLayerReferences& layers) {
+    std::vector<CollisionDomain> domains;
+    std::map<uint16_t, std::size_t> domainForGroup;
+    for (auto it = layers.crbegin(); it != layers.crend(); ++it) {
+        const RenderLayer& layer = *it;
+        const auto& placementData = layer.getPlacementData();
+        if (placementData.empty()) continue;
+
+        // Resolve the collision group in the sequential placement order, so that
+        // group IDs do not depend on which thread places the layer.
+        const uint16_t groupID = collisionGroups.get(placementData.front().sourceId).first;
+        if (isCollisionFree(layer)) {
+            domains.push_back({layer});
+            continue;
+        }
+
+        auto found = domainForGroup.find(groupID);
+        if (found == domainForGroup.end()) {
+            found = domainForGroup.emplace(groupID, domains.size()).first;
+            domains.emplace_back();
+        }
+        domains[found->second].emplace_back(layer);
+    }
+    return domains;
+}
+
+void Placement::placeCollisionDomain(const CollisionDomain& domain) {
+    for (const RenderLayer& layer : domain) {
+        std::set<uint32_t> seenCrossTileIDs;
+        placeLayer(layer, seenCrossTileIDs);
+    }
+}
+
+void Placement::placeCollisionDomainsInParallel(const std::vector<CollisionDomain>& domains) {
+    assert(!domains.empty());
+    // Every domain but the first one is placed by a separate placement with its
+    // own collision index. Once all domains are placed, the workers are merged
+    // back in domain order, which is not the layer order of sequential placement.
+    // Domains never share a bucket though, so each bucket's placements and the
+    // order of its features in the collision grid match sequential placement.
+    std::vector<std::unique_ptr<Placement>> workers;
+    std::vector<std::future<void>> results;
+    workers.reserve(domains.size() - 1);
+    results.reserve(domains.size() - 1);
+
+    // The tasks refer to the workers and domains, so wait for all of them
+    // before leaving, even if placing a domain throws.
+    struct JoinResults {
+        std::vector<std::future<void>>& results;
+        ~JoinResults() {
+            for (auto& result : results) {
+                if (result.valid()) {
+                    result.wait();
+                }
+            }
+        }
+    } joinResults{results};
+
+    auto scheduler = Scheduler::GetBackground();
+    for (std::size_t i = 1; i < domains.size(); ++i) {
+        workers.push_back(std::make_unique<Placement>(updateParameters, prevPlacement));
+        Placement& worker = *workers.back();
+        worker.collisionGroups = collisionGroups;
+
+        auto task = std::make_shared<std::packaged_task<void()>>(
+            [&worker, &domain = domains[i]] { worker.placeCollisionDomain(domain); });
+        results.push_back(task->get_future());
+        scheduler->schedule([task] { (*task)(); });
+    }
+
+    placeCollisionDomain(domains.front());
+
+    for (std::size_t i = 0; i < workers.size(); ++i) {
+        results[i].get();
+        Placement& worker = *workers[i];
+        collisionIndex.merge(worker.collisionIndex);
+        placements.insert(worker.placements.begin(), worker.placements.end());
+        variableOffsets.insert(worker.variableOffsets.begin(), worker.variableOffsets.end());
+        placedOrientations.insert(worker.placedOrientations.begin(), worker.placedOrientations.end());
+        retainedQueryData.insert(std::make_move_iterator(worker.retainedQueryData.begin()),
+                                 std::make_move_iterator(worker.retainedQueryData.end()));
+        collisionCircles.insert(std::make_move_iterator(worker.collisionCircles.begin()),
+                                std::make_move_iterator(worker.collisionCircles.end()));
+    }
+}
+
 namespace {
 Point<float> calculateVariableLayoutOffset(style::SymbolAnchorType anchor,
                                            float width,
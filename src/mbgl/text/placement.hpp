@@ -94,6 +94,9 @@ private:
 
 class Placement;
 class PlacementContext;
+// Layers, in placement order, whose symbols can only collide with each other.
+using CollisionDomain = std::vector<std::reference_wrapper<const RenderLayer>>;
+
 class PlacementController {
 public:
     PlacementController();
@@ -147,6 +150,9 @@ protected:
     virtual void placeSymbolBucket(const BucketPlacementData&, std::set<uint32_t>& seenCrossTileIDs);
     JointPlacement placeSymbol(const SymbolInstance& symbolInstance, const PlacementContext&);
     void placeLayer(const RenderLayer&, std::set<uint32_t>&);
+    std::vector<CollisionDomain> getCollisionDomains(const RenderLayerReferences&);
+    void placeCollisionDomain(const CollisionDomain&);
+    void placeCollisionDomainsInParallel(const std::vector<CollisionDomain>&);
     virtual void commit();
     virtual void newSymbolPlaced(const SymbolInstance&,
                                  const PlacementContext&,
@@ -10,6 +10,8 @@
 #include <mbgl/util/math.hpp>
 
 #include <cassert>
+#include <cmath>
+#include <limits>
 
 namespace mbgl {
 
@@ -330,4 +332,33 @@ SymbolQuads getGlyphQuads(const Shaping& shapedText,
 
     return quads;
 }
+
+PackedSymbolQuad::PackedSymbolQuad(const SymbolQuad& quad)
+    : tex(quad.tex),
+      glyphOffsetX(quad.glyphOffset.x),
+      sectionIndex(static_cast<uint16_t>(quad.sectionIndex)),
+      isSDF(quad.isSDF) {
+    assert(quad.sectionIndex <= std::numeric_limits<uint16_t>::max());
+    const auto packOffset = [&](const Point<float>& corner) {
+        return Point<int16_t>{static_cast<int16_t>(std::round(corner.x * 32)),
+                              static_cast<int16_t>(std::round((corner.y + quad.glyphOffset.y) * 32))};
+    };
+    tl = packOffset(quad.tl);
+    tr = packOffset(quad.tr);
+    bl = packOffset(quad.bl);
+    br = packOffset(quad.br);
+    pixelOffsetTL = {static_cast<int16_t>(quad.pixelOffsetTL.x * 16), static_cast<int16_t>(quad.pixelOffsetTL.y * 16)};
+    pixelOffsetBR = {static_cast<int16_t>(quad.pixelOffsetBR.x * 16), static_cast<int16_t>(quad.pixelOffsetBR.y * 16)};
+    minFontScale = {static_cast<int16_t>(quad.minFontScale.x * 256), static_cast<int16_t>(quad.minFontScale.y * 256)};
+}
+
+PackedSymbolQuads packSymbolQuads(const SymbolQuads& quads) {
+    PackedSymbolQuads packed;
+    packed.reserve(quads.size());
+    for (const auto& quad : quads) {
+        packed.emplace_back(quad);
+    }
+    return packed;
+}
+
 } // namespace mbgl
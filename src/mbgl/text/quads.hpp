@@ -57,6 +57,34 @@ public:
 
 using SymbolQuads = std::vector<SymbolQuad>;
 
+// A SymbolQuad reduced to the values needed to build its layout vertices,
+// already encoded in the vertices' fixed-point format. Symbol instances keep
+// their quads in this form until the bucket is created, which takes about
+// half the memory of the float representation.
+class PackedSymbolQuad {
+public:
+    explicit PackedSymbolQuad(const SymbolQuad&);
+
+    // Corner offsets in 1/32 pixels, with the vertical glyph offset applied.
+    Point<int16_t> tl;
+    Point<int16_t> tr;
+    Point<int16_t> bl;
+    Point<int16_t> br;
+    Rect<uint16_t> tex;
+    // Pixel offsets in 1/16 pixels.
+    Point<int16_t> pixelOffsetTL;
+    Point<int16_t> pixelOffsetBR;
+    // Minimum font scale in 1/256 units.
+    Point<int16_t> minFontScale;
+    float glyphOffsetX;
+    uint16_t sectionIndex;
+    bool isSDF;
+};
+
+using PackedSymbolQuads = std::vector<PackedSymbolQuad>;
+
+PackedSymbolQuads packSymbolQuads(const SymbolQuads&);
+
 SymbolQuads getIconQuads(const PositionedIcon& shapedIcon,
                          float iconRotate,
                          SymbolContent iconType,
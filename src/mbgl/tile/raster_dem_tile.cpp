@@ -125,4 +125,8 @@ void RasterDEMTile::setUpdateParameters(const TileUpdateParameters& params) {
     loader.setUpdateParameters(params);
 }
 
+void RasterDEMTile::setPriority(Resource::Priority priority) {
+    loader.setPriority(priority);
+}
+
 } // namespace mbgl
@@ -37,10 +37,12 @@ class UploadPass;
 struct TileUpdateParameters {
     Duration minimumUpdateInterval;
     bool isVolatile;
+    bool staleWhileRevalidate;
 };
 
 inline bool operator==(const TileUpdateParameters& a, const TileUpdateParameters& b) {
-    return a.minimumUpdateInterval == b.minimumUpdateInterval && a.isVolatile == b.isVolatile;
+    return a.minimumUpdateInterval == b.minimumUpdateInterval && a.isVolatile == b.isVolatile &&
+           a.staleWhileRevalidate == b.staleWhileRevalidate;
 }
 
 inline bool operator!=(const TileUpdateParameters& a, const TileUpdateParameters& b) {
@@ -67,6 +69,10 @@ public:
 
     virtual void setUpdateParameters(const TileUpdateParameters&) {}
 
+    // Sets the priority of the network requests made for this tile, relative
+    // to the other resources being loaded.
+    virtual void setPriority(Resource::Priority) {}
+
     // Mark this tile as no longer needed and cancel any pending work.
     virtual void cancel();
 
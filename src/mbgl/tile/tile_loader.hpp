@@ -21,6 +21,7 @@ public:
 
     void setNecessity(TileNecessity newNecessity);
     void setUpdateParameters(const TileUpdateParameters&);
+    void setPriority(Resource::Priority);
 
 private:
     // called when the tile is one of the ideal tiles that we want to show
@@ -47,7 +48,7 @@ private:
     Resource resource;
     std::shared_ptr<FileSource> fileSource;
     std::unique_ptr<AsyncRequest> request;
-    TileUpdateParameters updateParameters{Duration::zero(), false};
+    TileUpdateParameters updateParameters{Duration::zero(), false, false};
 };
 
 } // namespace mbgl
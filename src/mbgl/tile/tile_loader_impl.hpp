@@ -81,6 +81,16 @@ void TileLoader<T>::setUpdateParameters(const TileUpdateParameters& params) {
     }
 }
 
+template <typename T>
+void TileLoader<T>::setPriority(Resource::Priority priority) {
+    if (resource.priority != priority) {
+        resource.priority = priority;
+        if (request) {
+            request->setPriority(priority);
+        }
+    }
+}
+
 template <typename T>
 void TileLoader<T>::loadFromCache() {
     assert(!request);
@@ -95,7 +105,18 @@ void TileLoader<T>::loadFromCache() {
 
         tile.setTriedCache();
 
-        if (res.error && res.error->reason == Response::Error::Reason::NotFound) {
+        if (res.error && res.error->reason == Response::Error::Reason::NotFound && res.data &&
+            updateParameters.staleWhileRevalidate) {
+            // The data is expired and must be revalidated, but we may show it
+            // until the conditional network request below tells us whether it
+            // changed. If it didn't, the 304 response only updates the
+            // metadata; otherwise, the new data replaces it.
+            resource.priorModified = res.modified;
+            resource.priorExpires = res.expires;
+            resource.priorEtag = res.etag;
+            tile.setMetadata(res.modified, res.expires);
+            tile.setData(res.data);
+        } else if (res.error && res.error->reason == Response::Error::Reason::NotFound) {
             // When the cache-only request could not be satisfied, don't treat
             // it as an error. A cache lookup could still return data, _and_ an
             // error, in particular when we were able to find the data, but it
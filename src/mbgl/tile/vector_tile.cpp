@@ -21,6 +21,10 @@ void VectorTile::setUpdateParameters(const TileUpdateParameters& params) {
     loader.setUpdateParameters(params);
 }
 
+void VectorTile::setPriority(Resource::Priority priority) {
+    loader.setPriority(priority);
+}
+
 void VectorTile::setMetadata(std::optional<Timestamp> modified_, std::optional<Timestamp> expires_) {
     modified = std::move(modified_);
     expires = std::move(expires_);
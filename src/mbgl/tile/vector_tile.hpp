@@ -14,6 +14,7 @@ public:
 
     void setNecessity(TileNecessity) final;
     void setUpdateParameters(const TileUpdateParameters&) final;
+    void setPriority(Resource::Priority) final;
     void setMetadata(std::optional<Timestamp> modified, std::optional<Timestamp> expires);
     void setData(const std::shared_ptr<const std::string>& data);
 
@@ -0,0 +1,124 @@
+#include <mbgl/util/cache_file.hpp>
+#include <mbgl/util/io.hpp>
+
+#include <cerrno>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <sstream>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+#endif
+
+namespace mbgl {
+namespace util {
+namespace cache_file {
+
+void writeString(std::string& out, const std::string& value) {
+    write<uint32_t>(out, static_cast<uint32_t>(value.size()));
+    out.append(value);
+}
+
+bool Reader::readBytes(std::size_t length, const char*& bytes) {
+    if (data.size() - offset < length) return false;
+    bytes = data.data() + offset;
+    offset += length;
+    return true;
+}
+
+bool Reader::readString(std::string& value) {
+    uint32_t length = 0;
+    const char* bytes = nullptr;
+    if (!read(length) || !readBytes(length, bytes)) return false;
+    value.assign(bytes, length);
+    return true;
+}
+
+#if defined(_WIN32)
+
+Lock::Lock(const std::string& path) {
+    handle = CreateFileA((path + ".lock").c_str(),
+                         GENERIC_READ | GENERIC_WRITE,
+                         FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                         nullptr,
+                         OPEN_ALWAYS,
+                         FILE_ATTRIBUTE_NORMAL,
+                         nullptr);
+    if (handle != INVALID_HANDLE_VALUE) {
+        OVERLAPPED overlapped = {};
+        if (!LockFileEx(handle, LOCKFILE_EXCLUSIVE_LOCK, 0, MAXDWORD, MAXDWORD, &overlapped)) {
+            CloseHandle(handle);
+            handle = INVALID_HANDLE_VALUE;
+        }
+    }
+}
+
+Lock::~Lock() {
+    if (handle != INVALID_HANDLE_VALUE) {
+        // Closing the handle releases the lock
+        CloseHandle(handle);
+    }
+}
+
+#else
+
+Lock::Lock(const std::string& path) {
+    fd = ::open((path + ".lock").c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd >= 0) {
+        int result = 0;
+        do {
+            result = ::flock(fd, LOCK_EX);
+        } while (result != 0 && errno == EINTR);
+        if (result != 0) {
+            ::close(fd);
+            fd = -1;
+        }
+    }
+}
+
+Lock::~Lock() {
+    if (fd >= 0) {
+        // Closing the descriptor releases the lock
+        ::close(fd);
+    }
+}
+
+#endif
+
+bool replace(const std::string& path, const std::string& data) {
+    // A name of its own keeps concurrent writers from writing to the same temporary file
+    static thread_local std::mt19937_64 random{std::random_device{}()};
+    std::ostringstream temporaryPath;
+    temporaryPath << path << '.' << std::hex << random() << ".tmp";
+
+    try {
+        util::write_file(temporaryPath.str(), data);
+    } catch (const std::exception&) {
+        std::remove(temporaryPath.str().c_str());
+        return false;
+    }
+    if (std::rename(temporaryPath.str().c_str(), path.c_str()) != 0) {
+        std::remove(temporaryPath.str().c_str());
+        return false;
+    }
+    return true;
+}
+
+bool append(const std::string& path, const std::string& data) {
+    std::ofstream file(path, std::ios::binary | std::ios::app);
+    file.write(data.data(), static_cast<std::streamsize>(data.size()));
+    file.close();
+    return !file.fail();
+}
+
+} // namespace cache_file
+} // namespace util
+} // namespace mbgl
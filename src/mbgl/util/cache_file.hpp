@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+namespace mbgl {
+namespace util {
+
+// Helpers for the files the renderer caches on the device, e.g., linked program
+// binaries and locally rasterized glyphs. Values are stored in native byte
+// order, as these files never leave the device that wrote them.
+namespace cache_file {
+
+template <typename T>
+void write(std::string& out, T value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+// Writes the length of the string, followed by its contents
+void writeString(std::string& out, const std::string& value);
+
+// Bounds-checked reader over the contents of a cache file.
+class Reader {
+public:
+    explicit Reader(const std::string& data_)
+        : data(data_) {}
+
+    template <typename T>
+    bool read(T& value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        if (data.size() - offset < sizeof(T)) return false;
+        std::memcpy(&value, data.data() + offset, sizeof(T));
+        offset += sizeof(T);
+        return true;
+    }
+
+    bool readBytes(std::size_t length, const char*& bytes);
+    bool readString(std::string& value);
+
+    bool empty() const { return offset == data.size(); }
+
+private:
+    const std::string& data;
+    std::size_t offset = 0;
+};
+
+// An advisory lock on a cache file, held from construction to destruction,
+// which serializes writers of the same file in this and other processes. The
+// lock is taken on a separate `.lock` file next to it, as the cache file
+// itself is replaced when it's written. Blocks until the lock is acquired;
+// if the lock file can't be opened, writers aren't serialized.
+class Lock {
+public:
+    explicit Lock(const std::string& path);
+    ~Lock();
+
+    Lock(const Lock&) = delete;
+    Lock& operator=(const Lock&) = delete;
+
+private:
+#if defined(_WIN32)
+    void* handle;
+#else
+    int fd;
+#endif
+};
+
+// Replaces the file with `data`. The data is written to a temporary file unique
+// to this call first, and renamed over the file, so that neither an interrupted
+// write nor another writer leaves a truncated or mixed file behind. Returns
+// false if the file couldn't be replaced.
+bool replace(const std::string& path, const std::string& data);
+
+// Appends `data` to the file, which should be done with the `Lock` held.
+// Returns false if the data couldn't be written completely.
+bool append(const std::string& path, const std::string& data);
+
+} // namespace cache_file
+} // namespace util
+} // namespace mbgl
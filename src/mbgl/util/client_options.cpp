@@ -6,6 +6,11 @@ class ClientOptions::Impl {
 public:
     std::string name;
     std::string version;
+    bool http2 = true;
+    uint32_t maximumConnectionsPerHost = 0;
+    uint32_t connectionPoolSize = 0;
+    Seconds tcpKeepAlive{60};
+    Seconds dnsCacheTimeout{60};
 };
 
 // These requires the complete type of Impl.
@@ -46,4 +51,49 @@ const std::string& ClientOptions::version() const {
     return impl_->version;
 }
 
+ClientOptions& ClientOptions::withHTTP2(bool enabled) {
+    impl_->http2 = enabled;
+    return *this;
+}
+
+bool ClientOptions::http2() const {
+    return impl_->http2;
+}
+
+ClientOptions& ClientOptions::withMaximumConnectionsPerHost(uint32_t count) {
+    impl_->maximumConnectionsPerHost = count;
+    return *this;
+}
+
+uint32_t ClientOptions::maximumConnectionsPerHost() const {
+    return impl_->maximumConnectionsPerHost;
+}
+
+ClientOptions& ClientOptions::withConnectionPoolSize(uint32_t count) {
+    impl_->connectionPoolSize = count;
+    return *this;
+}
+
+uint32_t ClientOptions::connectionPoolSize() const {
+    return impl_->connectionPoolSize;
+}
+
+ClientOptions& ClientOptions::withTCPKeepAlive(Seconds idle) {
+    impl_->tcpKeepAlive = idle;
+    return *this;
+}
+
+Seconds ClientOptions::tcpKeepAlive() const {
+    return impl_->tcpKeepAlive;
+}
+
+ClientOptions& ClientOptions::withDNSCacheTimeout(Seconds timeout) {
+    impl_->dnsCacheTimeout = timeout;
+    return *this;
+}
+
+Seconds ClientOptions::dnsCacheTimeout() const {
+    return impl_->dnsCacheTimeout;
+}
+
 } // namespace mbgl
@@ -67,6 +67,10 @@ public:
     void insert(T&& t, const BBox&);
     void insert(T&& t, const BCircle&);
 
+    /// Appends all elements of another index with the same dimensions,
+    /// preserving their relative insertion order.
+    void merge(const GridIndex<T>&);
+
     std::vector<T> query(const BBox&) const;
     std::vector<std::pair<T, BBox>> queryWithBoxes(const BBox&) const;
 
@@ -165,6 +169,21 @@ void GridIndex<T>::insert(T&& t, const BCircle& bcircle) {
     circleElements.emplace_back(t, bcircle);
 }
 
+template <class T>
+void GridIndex<T>::merge(const GridIndex<T>& other) {
+    assert(xCellCount == other.xCellCount && yCellCount == other.yCellCount);
+    boxElements.reserve(boxElements.size() + other.boxElements.size());
+    circleElements.reserve(circleElements.size() + other.circleElements.size());
+    for (const auto& element : other.boxElements) {
+        T copy = element.first;
+        insert(std::move(copy), element.second);
+    }
+    for (const auto& element : other.circleElements) {
+        T copy = element.first;
+        insert(std::move(copy), element.second);
+    }
+}
+
 template <class T>
 std::vector<T> GridIndex<T>::query(const BBox& queryBBox) const {
     std::vector<T> result;
@@ -9,6 +9,7 @@
 
 #include <functional>
 #include <list>
+#include <stdexcept>
 
 namespace mbgl {
 
@@ -325,13 +326,8 @@ uint64_t tileCount(const LatLngBounds& bounds, uint8_t zoom) {
 }
 
 uint64_t tileCount(const Geometry<double>& geometry, uint8_t z) {
-    uint64_t tileCount = 0;
-
     TileCover tc(geometry, z, true);
-    while (tc.next()) {
-        tileCount++;
-    };
-    return tileCount;
+    return tc.skip(std::numeric_limits<uint64_t>::max());
 }
 
 TileCover::TileCover(const LatLngBounds& bounds_, uint8_t z) {
@@ -364,5 +360,103 @@ bool TileCover::hasNext() {
     return impl->hasNext();
 }
 
+uint64_t TileCover::skip(uint64_t count) {
+    return impl->skip(count);
+}
+
+// TileCoverIterator
+
+std::string TileCoverIterator::Cursor::serialize() const {
+    return std::to_string(position) + "-" + std::to_string(end);
+}
+
+std::optional<TileCoverIterator::Cursor> TileCoverIterator::Cursor::deserialize(const std::string& serialized) {
+    const auto separator = serialized.find('-');
+    if (separator == std::string::npos || separator == 0 || separator + 1 == serialized.size() ||
+        serialized.find_first_not_of("0123456789-") != std::string::npos ||
+        serialized.find('-', separator + 1) != std::string::npos) {
+        return std::nullopt;
+    }
+
+    try {
+        Cursor cursor;
+        cursor.position = std::stoull(serialized.substr(0, separator));
+        cursor.end = std::stoull(serialized.substr(separator + 1));
+        if (cursor.position > cursor.end) {
+            return std::nullopt;
+        }
+        return cursor;
+    } catch (const std::out_of_range&) {
+        return std::nullopt;
+    }
+}
+
+TileCoverIterator::TileCoverIterator(const LatLngBounds& bounds,
+                                     const Range<uint8_t>& zoomRange_,
+                                     const Cursor& cursor_)
+    : TileCoverIterator([bounds](uint8_t zoom) { return std::make_unique<TileCover>(bounds, zoom); },
+                        zoomRange_,
+                        cursor_) {}
+
+TileCoverIterator::TileCoverIterator(const Geometry<double>& geometry,
+                                     const Range<uint8_t>& zoomRange_,
+                                     const Cursor& cursor_)
+    : TileCoverIterator([geometry](uint8_t zoom) { return std::make_unique<TileCover>(geometry, zoom); },
+                        zoomRange_,
+                        cursor_) {}
+
+TileCoverIterator::TileCoverIterator(CoverFactory makeCover_, const Range<uint8_t>& zoomRange_, const Cursor& cursor_)
+    : makeCover(std::move(makeCover_)),
+      zoomRange(zoomRange_),
+      z(zoomRange.min),
+      end(cursor_.end) {
+    // Seek to the cursor position, skipping whole row spans at a time.
+    while (position < cursor_.position && advance()) {
+        position += cover->skip(cursor_.position - position);
+    }
+}
+
+TileCoverIterator::~TileCoverIterator() = default;
+
+bool TileCoverIterator::advance() {
+    while (z <= zoomRange.max) {
+        if (!cover) {
+            cover = makeCover(static_cast<uint8_t>(z));
+        }
+        if (cover->hasNext()) {
+            return true;
+        }
+        cover.reset();
+        z++;
+    }
+    return false;
+}
+
+bool TileCoverIterator::hasNext() {
+    return position < end && advance();
+}
+
+std::optional<UnwrappedTileID> TileCoverIterator::next() {
+    if (!hasNext()) return std::nullopt;
+    position++;
+    return cover->next();
+}
+
+std::vector<TileCoverIterator::Cursor> TileCoverIterator::shards(uint64_t total, uint32_t count) {
+    std::vector<Cursor> result;
+    if (count == 0) return result;
+
+    result.reserve(count);
+    const uint64_t shardSize = total / count;
+    const uint64_t remainder = total % count;
+    uint64_t begin = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        const uint64_t size = shardSize + (i < remainder ? 1 : 0);
+        result.push_back({begin, i + 1 == count ? std::numeric_limits<uint64_t>::max() : begin + size});
+        begin += size;
+    }
+    return result;
+}
+
 } // namespace util
 } // namespace mbgl
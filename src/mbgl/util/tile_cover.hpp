@@ -3,10 +3,14 @@
 #include <mbgl/tile/tile_id.hpp>
 #include <mbgl/style/types.hpp>
 #include <mbgl/util/geometry.hpp>
+#include <mbgl/util/range.hpp>
 
+#include <functional>
+#include <limits>
 #include <vector>
 #include <memory>
 #include <optional>
+#include <string>
 
 namespace mbgl {
 
@@ -26,11 +30,62 @@ public:
     std::optional<UnwrappedTileID> next();
     bool hasNext();
 
+    // Skips up to `count` tiles a row span at a time, without producing them.
+    // Returns the number of tiles skipped.
+    uint64_t skip(uint64_t count);
+
 private:
     class Impl;
     std::unique_ptr<Impl> impl;
 };
 
+// Streams the tile cover of bounds or a geometry over a range of zoom levels,
+// lowest zoom level first, holding only one zoom level's current row in memory.
+// Tiles are numbered in that order, so that the iteration can be resumed from a
+// saved cursor, or split into shards that are iterated independently.
+class TileCoverIterator {
+public:
+    // The tiles from `position` up to, but not including, `end`
+    struct Cursor {
+        uint64_t position = 0;
+        uint64_t end = std::numeric_limits<uint64_t>::max();
+
+        std::string serialize() const;
+        static std::optional<Cursor> deserialize(const std::string&);
+
+        bool operator==(const Cursor& other) const { return position == other.position && end == other.end; }
+    };
+
+    TileCoverIterator(const LatLngBounds&, const Range<uint8_t>& zoomRange, const Cursor& = {});
+    TileCoverIterator(const Geometry<double>&, const Range<uint8_t>& zoomRange, const Cursor& = {});
+    ~TileCoverIterator();
+
+    std::optional<UnwrappedTileID> next();
+    bool hasNext();
+
+    // Resuming from this cursor continues with the next tile
+    Cursor cursor() const { return {position, end}; }
+
+    // Splits the positions of `total` tiles into `count` contiguous shards of
+    // about the same size. The last shard is open-ended.
+    static std::vector<Cursor> shards(uint64_t total, uint32_t count);
+
+private:
+    using CoverFactory = std::function<std::unique_ptr<TileCover>(uint8_t z)>;
+
+    TileCoverIterator(CoverFactory, const Range<uint8_t>& zoomRange, const Cursor&);
+
+    // Moves on to the next zoom level with tiles left, if needed
+    bool advance();
+
+    const CoverFactory makeCover;
+    const Range<uint8_t> zoomRange;
+    unsigned z;
+    std::unique_ptr<TileCover> cover;
+    uint64_t position = 0;
+    const uint64_t end;
+};
+
 int32_t coveringZoomLevel(double z, style::SourceType type, uint16_t tileSize);
 
 std::vector<OverscaledTileID> tileCover(const TransformState&,
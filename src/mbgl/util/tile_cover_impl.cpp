@@ -350,17 +350,35 @@ std::optional<UnwrappedTileID> TileCover::Impl::next() {
     const auto y = tileY;
     tileX++;
     if (tileX >= tileXSpans.front().second) {
-        tileXSpans.pop();
-        if (tileXSpans.empty()) {
-            tileY++;
-            nextRow();
-        }
-        if (!tileXSpans.empty()) {
-            tileX = tileXSpans.front().first;
-        }
+        nextSpan();
     }
     return UnwrappedTileID(zoom, x, y);
 }
 
+uint64_t TileCover::Impl::skip(uint64_t count) {
+    uint64_t skipped = 0;
+    while (skipped < count && hasNext()) {
+        const auto remaining = static_cast<uint64_t>(tileXSpans.front().second - tileX);
+        if (count - skipped < remaining) {
+            tileX += static_cast<int32_t>(count - skipped);
+            return count;
+        }
+        skipped += remaining;
+        nextSpan();
+    }
+    return skipped;
+}
+
+void TileCover::Impl::nextSpan() {
+    tileXSpans.pop();
+    if (tileXSpans.empty()) {
+        tileY++;
+        nextRow();
+    }
+    if (!tileXSpans.empty()) {
+        tileX = tileXSpans.front().first;
+    }
+}
+
 } // namespace util
 } // namespace mbgl
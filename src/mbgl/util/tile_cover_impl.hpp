@@ -81,11 +81,13 @@ public:
 
     std::optional<UnwrappedTileID> next();
     bool hasNext() const;
+    uint64_t skip(uint64_t count);
 
 private:
     using TileSpans = std::queue<std::pair<int32_t, int32_t>>;
 
     void nextRow();
+    void nextSpan();
 
     const int32_t zoom;
     bool isClosed;
@@ -11,9 +11,8 @@ namespace tinysdf {
 
 static const double INF = 1e20;
 
-// 1D squared distance transform
-void edt1d(
-    std::vector<double>& f, std::vector<double>& d, std::vector<int16_t>& v, std::vector<double>& z, uint32_t n) {
+// 1D squared distance transform of `n` contiguous values from `f` into `d`
+void edt1d(const double* f, double* d, int16_t* v, double* z, uint32_t n) {
     v[0] = 0;
     z[0] = -INF;
     z[1] = +INF;
@@ -37,31 +36,37 @@ void edt1d(
 }
 
 // 2D Euclidean distance transform by Felzenszwalb & Huttenlocher https://cs.brown.edu/~pff/dt/
+//
+// The column pass runs on a transposed copy of the grid, so that both passes
+// work on contiguous memory instead of gathering every column with a stride
+// of `width`. Leaves squared distances in `data`.
 void edt(std::vector<double>& data,
          uint32_t width,
          uint32_t height,
-         std::vector<double>& f,
+         std::vector<double>& transposed,
          std::vector<double>& d,
          std::vector<int16_t>& v,
          std::vector<double>& z) {
-    for (uint32_t x = 0; x < width; x++) {
-        for (uint32_t y = 0; y < height; y++) {
-            f[y] = data[y * width + x];
-        }
-        edt1d(f, d, v, z, height);
-        for (uint32_t y = 0; y < height; y++) {
-            data[y * width + x] = d[y];
-        }
-    }
     for (uint32_t y = 0; y < height; y++) {
         for (uint32_t x = 0; x < width; x++) {
-            f[x] = data[y * width + x];
+            transposed[x * height + y] = data[y * width + x];
         }
-        edt1d(f, d, v, z, width);
+    }
+    for (uint32_t x = 0; x < width; x++) {
+        double* column = &transposed[x * height];
+        edt1d(column, d.data(), v.data(), z.data(), height);
+        std::copy(d.begin(), d.begin() + height, column);
+    }
+    for (uint32_t y = 0; y < height; y++) {
         for (uint32_t x = 0; x < width; x++) {
-            data[y * width + x] = std::sqrt(d[x]);
+            data[y * width + x] = transposed[x * height + y];
         }
     }
+    for (uint32_t y = 0; y < height; y++) {
+        double* row = &data[y * width];
+        edt1d(row, d.data(), v.data(), z.data(), width);
+        std::copy(d.begin(), d.begin() + width, row);
+    }
 }
 
 } // namespace tinysdf
@@ -75,24 +80,28 @@ AlphaImage transformRasterToSDF(const AlphaImage& rasterInput, double radius, do
     // temporary arrays for the distance transform
     std::vector<double> gridOuter(size);
     std::vector<double> gridInner(size);
-    std::vector<double> f(maxDimension);
+    std::vector<double> transposed(size);
     std::vector<double> d(maxDimension);
     std::vector<double> z(maxDimension + 1);
     std::vector<int16_t> v(maxDimension);
 
+    // Element-wise loops below are kept free of branches and library calls so
+    // that they can be vectorized.
     for (uint32_t i = 0; i < size; i++) {
-        double a = static_cast<double>(rasterInput.data[i]) / 255; // alpha value
-        gridOuter[i] = a == 1.0 ? 0.0 : a == 0.0 ? tinysdf::INF : std::pow(std::max(0.0, 0.5 - a), 2.0);
-        gridInner[i] = a == 1.0 ? tinysdf::INF : a == 0.0 ? 0.0 : std::pow(std::max(0.0, a - 0.5), 2.0);
+        const double a = static_cast<double>(rasterInput.data[i]) / 255; // alpha value
+        const double outer = std::max(0.0, 0.5 - a);
+        const double inner = std::max(0.0, a - 0.5);
+        gridOuter[i] = a == 1.0 ? 0.0 : a == 0.0 ? tinysdf::INF : outer * outer;
+        gridInner[i] = a == 1.0 ? tinysdf::INF : a == 0.0 ? 0.0 : inner * inner;
     }
 
-    tinysdf::edt(gridOuter, rasterInput.size.width, rasterInput.size.height, f, d, v, z);
-    tinysdf::edt(gridInner, rasterInput.size.width, rasterInput.size.height, f, d, v, z);
+    tinysdf::edt(gridOuter, rasterInput.size.width, rasterInput.size.height, transposed, d, v, z);
+    tinysdf::edt(gridInner, rasterInput.size.width, rasterInput.size.height, transposed, d, v, z);
 
     for (uint32_t i = 0; i < size; i++) {
-        double distance = gridOuter[i] - gridInner[i];
-        sdf.data[i] = static_cast<uint8_t>(
-            std::max(0l, std::min(255l, ::lround(255.0 - 255.0 * (distance / radius + cutoff)))));
+        const double distance = std::sqrt(gridOuter[i]) - std::sqrt(gridInner[i]);
+        const double value = std::round(255.0 - 255.0 * (distance / radius + cutoff));
+        sdf.data[i] = static_cast<uint8_t>(std::max(0.0, std::min(255.0, value)));
     }
 
     return sdf;
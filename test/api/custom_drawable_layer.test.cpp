@@ -12,11 +12,13 @@
 
 #if MLN_DRAWABLE_RENDERER
 
+#include <mbgl/gfx/drawable_geometry.hpp>
 #include <mbgl/style/layers/custom_drawable_layer.hpp>
 #include <mbgl/util/constants.hpp>
 
 #include <memory>
 #include <cmath>
+#include <future>
 
 class TestDrawableLayer : public mbgl::style::CustomDrawableLayerHost {
 public:
@@ -171,4 +173,92 @@ TEST(CustomDrawableLayer, Basic) {
     test::checkImage("test/fixtures/custom_drawable_layer/basic", frontend.render(map).image, 0.000657, 0.1);
 }
 
+// Draws a line and a fill, either from geometry generated on another thread or from geometry handed to the builder
+class PregeneratedDrawableLayer : public mbgl::style::CustomDrawableLayerHost {
+public:
+    PregeneratedDrawableLayer(bool pregenerated_)
+        : pregenerated(pregenerated_) {}
+
+    void initialize() override {}
+
+    void update(Interface& interface) override {
+        using namespace mbgl;
+
+        if (interface.getDrawableCount()) return;
+
+        GeometryCoordinates polyline;
+        for (auto ipoint{0}; ipoint < 100; ++ipoint) {
+            polyline.emplace_back(ipoint * util::EXTENT / 100, util::EXTENT / 2 + std::sin(ipoint * M_PI / 50) * 1000);
+        }
+        const GeometryCollection polygon{{
+            {static_cast<int16_t>(util::EXTENT * 0.1f), static_cast<int16_t>(util::EXTENT * 0.2f)},
+            {static_cast<int16_t>(util::EXTENT * 0.7f), static_cast<int16_t>(util::EXTENT * 0.5f)},
+            {static_cast<int16_t>(util::EXTENT * 0.1f), static_cast<int16_t>(util::EXTENT * 0.8f)},
+            {static_cast<int16_t>(util::EXTENT * 0.1f), static_cast<int16_t>(util::EXTENT * 0.2f)},
+        }};
+        Interface::LineOptions lineOptions{/*color=*/Color::blue(),
+                                           /*blur=*/1.0f,
+                                           /*opacity=*/1.0f,
+                                           /*gapWidth=*/0.0f,
+                                           /*offset=*/0.0f,
+                                           /*width=*/8.0f,
+                                           {}};
+        lineOptions.geometry.joinType = style::LineJoinType::Round;
+
+        interface.setTileID({11, 327, 791});
+        interface.setLineOptions(lineOptions);
+        interface.setFillOptions({/*color=*/Color::green(), /*opacity=*/0.5f});
+
+        if (pregenerated) {
+            auto line = std::async(std::launch::async, [&] {
+                gfx::PolylineGeometry geometry;
+                geometry.add(polyline, lineOptions.geometry);
+                return geometry;
+            });
+            auto fill = std::async(std::launch::async, [&] {
+                gfx::FillGeometry geometry;
+                geometry.add(polygon);
+                return geometry;
+            });
+            interface.addPolylines(line.get());
+            interface.addFill(fill.get());
+        } else {
+            interface.addPolyline(polyline);
+            interface.addFill(polygon);
+        }
+
+        interface.finish();
+    }
+
+    void deinitialize() override {}
+
+private:
+    const bool pregenerated;
+};
+
+TEST(CustomDrawableLayer, PregeneratedGeometry) {
+    using namespace mbgl;
+    using namespace mbgl::style;
+
+    util::RunLoop loop;
+
+    const auto render = [](bool pregenerated) {
+        HeadlessFrontend frontend{1};
+        Map map(frontend,
+                MapObserver::nullObserver(),
+                MapOptions().withMapMode(MapMode::Static).withSize(frontend.getSize()),
+                ResourceOptions().withCachePath(":memory:").withAssetPath("test/fixtures/api/assets"));
+
+        map.getStyle().loadJSON(util::read_file("test/fixtures/api/water.json"));
+        map.jumpTo(CameraOptions().withCenter(LatLng{37.8, -122.4426032}).withZoom(10.0));
+        map.getStyle().addLayer(std::make_unique<CustomDrawableLayer>(
+            "custom-drawable", std::make_unique<PregeneratedDrawableLayer>(pregenerated)));
+
+        return frontend.render(map).image;
+    };
+
+    // Geometry generated off the render thread draws the same as geometry generated by the builder
+    EXPECT_TRUE(render(false) == render(true));
+}
+
 #endif // MLN_DRAWABLE_RENDERER
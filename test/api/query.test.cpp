@@ -282,3 +282,50 @@ TEST(Query, QueryFeatureExtensionsSuperclusterLeaves) {
     EXPECT_EQ(offsetLeaves3[1].properties["name"].get<std::string>(), "Cape Sable"s);
     EXPECT_EQ(offsetLeaves3[2].properties["name"].get<std::string>(), "Cape Cod"s);
 }
+
+TEST(Query, ParallelPlacementMatchesSequentialPlacement) {
+    // Renders a style whose symbol layers fall into several collision domains,
+    // one per source plus a layer that collides with nothing, and checks that
+    // placing the domains in parallel gives the same result as placing them in
+    // order: the same symbols shown with the same opacities, and the same
+    // features in the same order in the collision grid.
+    struct Result {
+        PremultipliedImage image;
+        std::vector<std::string> features;
+    };
+
+    auto place = [](bool parallel) {
+        util::RunLoop loop;
+        auto fileSource = std::make_shared<StubFileSource>();
+        HeadlessFrontend frontend{1};
+        MapAdapter map{frontend,
+                       MapObserver::nullObserver(),
+                       fileSource,
+                       MapOptions()
+                           .withMapMode(MapMode::Static)
+                           .withSize(frontend.getSize())
+                           .withCrossSourceCollisions(false)
+                           .withParallelPlacement(parallel)};
+        map.getStyle().loadJSON(util::read_file("test/fixtures/api/parallel_placement_style.json"));
+        map.getStyle().addImage(std::make_unique<style::Image>(
+            "test-icon", decodeImage(util::read_file("test/fixtures/sprites/default_marker.png")), 1.0f));
+        map.jumpTo(CameraOptions().withCenter(LatLng{0, 0}).withZoom(3.0));
+
+        Result result;
+        result.image = frontend.render(map).image;
+
+        const auto size = frontend.getSize();
+        const ScreenBox box{{0, 0}, {static_cast<double>(size.width), static_cast<double>(size.height)}};
+        for (const auto& feature : frontend.getRenderer()->queryRenderedFeatures(box)) {
+            result.features.push_back(feature.properties.at("name").get<std::string>());
+        }
+        return result;
+    };
+
+    const Result sequential = place(false);
+    const Result parallel = place(true);
+
+    EXPECT_FALSE(sequential.features.empty());
+    EXPECT_EQ(sequential.features, parallel.features);
+    EXPECT_TRUE(sequential.image == parallel.image);
+}
@@ -0,0 +1,73 @@
+#if MLN_RENDER_BACKEND_OPENGL
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/gfx/backend_scope.hpp>
+#include <mbgl/gl/buffer_allocator.hpp>
+#include <mbgl/gl/context.hpp>
+#include <mbgl/gl/headless_backend.hpp>
+
+#include <set>
+#include <vector>
+
+using namespace mbgl;
+
+TEST(GLBufferAllocator, SubAllocation) {
+    gl::HeadlessBackend backend{{256, 256}};
+    gfx::BackendScope scope{backend};
+    gl::Context context{backend};
+
+    auto& allocator = context.getBufferAllocator(gl::BufferAllocator::Target::Vertex);
+    const auto& stats = context.renderingStats();
+    const std::vector<uint8_t> data(1000, 1);
+
+    std::vector<gl::BufferAllocation> allocations;
+    std::set<std::size_t> offsets;
+    for (int i = 0; i < 100; ++i) {
+        allocations.push_back(allocator.allocate(data.data(), data.size(), gfx::BufferUsageType::StaticDraw));
+        const auto& allocation = allocations.back();
+        EXPECT_EQ(allocations.front().getBuffer(), allocation.getBuffer());
+        EXPECT_EQ(0u, allocation.getOffset() % gl::BufferAllocator::alignment);
+        offsets.insert(allocation.getOffset());
+    }
+    EXPECT_EQ(100u, offsets.size());
+    EXPECT_EQ(1u, allocator.getSlabCount());
+    EXPECT_EQ(1, stats.numBufferSlabs);
+    EXPECT_EQ(static_cast<int>(gl::BufferAllocator::slabSize), stats.memBufferSlabs);
+
+    // Released ranges are reused
+    const auto offset = allocations[10].getOffset();
+    allocations[10] = {};
+    allocations[10] = allocator.allocate(data.data(), data.size(), gfx::BufferUsageType::StaticDraw);
+    EXPECT_EQ(offset, allocations[10].getOffset());
+
+    // Large and frequently updated data get buffers of their own
+    auto large = allocator.allocate(
+        nullptr, gl::BufferAllocator::maxSubAllocationSize + 1, gfx::BufferUsageType::StaticDraw);
+    auto dynamic = allocator.allocate(data.data(), data.size(), gfx::BufferUsageType::DynamicDraw);
+    EXPECT_NE(allocations.front().getBuffer(), large.getBuffer());
+    EXPECT_NE(allocations.front().getBuffer(), dynamic.getBuffer());
+    EXPECT_EQ(0u, large.getOffset());
+    EXPECT_EQ(1u, allocator.getSlabCount());
+    EXPECT_EQ(3, stats.numBuffers);
+
+    // Fill a second slab
+    for (int i = 0; i < 4; ++i) {
+        allocations.push_back(allocator.allocate(
+            nullptr, gl::BufferAllocator::maxSubAllocationSize, gfx::BufferUsageType::StaticDraw));
+    }
+    EXPECT_EQ(2u, allocator.getSlabCount());
+    EXPECT_EQ(2, stats.numBufferSlabs);
+
+    // One empty slab is kept for reuse
+    allocations.clear();
+    large = {};
+    dynamic = {};
+    EXPECT_EQ(1u, allocator.getSlabCount());
+    EXPECT_EQ(1, stats.numBufferSlabs);
+
+    context.reset();
+    EXPECT_EQ(0u, allocator.getSlabCount());
+    EXPECT_TRUE(stats.isZero());
+}
+
+#endif
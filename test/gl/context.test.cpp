@@ -1,16 +1,21 @@
 #if MLN_RENDER_BACKEND_OPENGL
 #include <mbgl/test/util.hpp>
+#include <mbgl/test/stub_map_observer.hpp>
 
 #include <mbgl/gfx/backend_scope.hpp>
 #include <mbgl/gfx/headless_frontend.hpp>
 #include <mbgl/gl/context.hpp>
+#include <mbgl/gl/headless_backend.hpp>
 #include <mbgl/style/layers/custom_layer.hpp>
 #include <mbgl/gl/defines.hpp>
 #include <mbgl/gl/renderable_resource.hpp>
+#include <mbgl/gl/uniform_buffer_gl.hpp>
 #include <mbgl/map/map.hpp>
 #include <mbgl/map/map_options.hpp>
 #include <mbgl/platform/gl_functions.hpp>
+#include <mbgl/programs/program_parameters.hpp>
 #include <mbgl/renderer/renderer.hpp>
+#include <mbgl/shaders/gl/shader_group_gl.hpp>
 #include <mbgl/storage/resource_options.hpp>
 #include <mbgl/style/layers/background_layer.hpp>
 #include <mbgl/style/layers/fill_layer.hpp>
@@ -124,4 +129,189 @@ TEST(GLContextMode, Shared) {
     test::checkImage("test/fixtures/shared_context", frontend.render(map).image, 0.5, 0.1);
 }
 
+#if MLN_DRAWABLE_RENDERER
+TEST(GLContext, UniformBufferArena) {
+    gl::HeadlessBackend backend{{256, 256}};
+    gfx::BackendScope scope{backend};
+    gl::Context context{backend};
+
+    constexpr int count = 100;
+    std::vector<gfx::UniformBufferPtr> buffers;
+    for (int i = 0; i < count; ++i) {
+        const float data[4] = {float(i), 0, 0, 1};
+        buffers.push_back(context.createUniformBuffer(data, sizeof(data)));
+    }
+    EXPECT_EQ(count, context.renderingStats().numUniformBuffers);
+
+    // Updates are deferred until a buffer is bound, and all pending updates
+    // are uploaded together.
+    for (int i = 0; i < count; ++i) {
+        const float data[4] = {float(i), 1, 0, 1};
+        buffers[i]->update(data, sizeof(data));
+    }
+    EXPECT_EQ(count, context.renderingStats().numUniformUpdates);
+    EXPECT_EQ(0, context.renderingStats().numUniformUploads);
+
+    for (const auto& buffer : buffers) {
+        static_cast<const gl::UniformBufferGL&>(*buffer).bind(0);
+    }
+    EXPECT_EQ(1, context.renderingStats().numUniformUploads);
+
+    // Unchanged data is neither an update nor an upload.
+    const float data[4] = {0, 1, 0, 1};
+    buffers[0]->update(data, sizeof(data));
+    static_cast<const gl::UniformBufferGL&>(*buffers[0]).bind(0);
+    EXPECT_EQ(count, context.renderingStats().numUniformUpdates);
+    EXPECT_EQ(1, context.renderingStats().numUniformUploads);
+
+    buffers.clear();
+    context.reset();
+    EXPECT_EQ(0, context.renderingStats().numUniformBuffers);
+}
+
+TEST(GLContext, UniformBufferDistantWrites) {
+    gl::HeadlessBackend backend{{256, 256}};
+    gfx::BackendScope scope{backend};
+    gl::Context context{backend};
+
+    // Blocks far enough apart that uploading the bytes between them isn't worth it
+    constexpr std::size_t blockSize = gl::UniformBufferAllocator::maxRangeGap;
+    const std::vector<uint8_t> zeros(blockSize, 0);
+    std::vector<gfx::UniformBufferPtr> buffers;
+    for (int i = 0; i < 4; ++i) {
+        buffers.push_back(context.createUniformBuffer(zeros.data(), blockSize));
+    }
+    static_cast<const gl::UniformBufferGL&>(*buffers[0]).bind(0);
+    const auto uploads = context.renderingStats().numUniformUploads;
+    const auto uploadBytes = context.renderingStats().uniformUpdateBytes;
+
+    const std::vector<uint8_t> ones(blockSize, 1);
+    buffers[0]->update(ones.data(), blockSize);
+    buffers[3]->update(ones.data(), blockSize);
+    static_cast<const gl::UniformBufferGL&>(*buffers[0]).bind(0);
+    EXPECT_EQ(uploads + 2, context.renderingStats().numUniformUploads);
+    EXPECT_EQ(uploadBytes + 2 * blockSize, context.renderingStats().uniformUpdateBytes);
+
+    // Adjacent blocks are uploaded together
+    const std::vector<uint8_t> twos(blockSize, 2);
+    buffers[1]->update(twos.data(), blockSize);
+    buffers[2]->update(twos.data(), blockSize);
+    static_cast<const gl::UniformBufferGL&>(*buffers[0]).bind(0);
+    EXPECT_EQ(uploads + 3, context.renderingStats().numUniformUploads);
+}
+
+TEST(GLContext, UniformBufferOutlivesContext) {
+    gl::HeadlessBackend backend{{256, 256}};
+    gfx::BackendScope scope{backend};
+
+    gfx::UniformBufferPtr buffer;
+    {
+        gl::Context context{backend};
+        const float data[4] = {0, 0, 0, 1};
+        buffer = context.createUniformBuffer(data, sizeof(data));
+    }
+
+    // The arena went away with the context, releasing the block is a no-op
+    buffer.reset();
+}
+
+TEST(GLContext, PrewarmedShader) {
+    gl::HeadlessBackend backend{{256, 256}};
+    gfx::BackendScope scope{backend};
+    gl::Context context{backend};
+
+    gl::ShaderGroupGL<shaders::BuiltIn::FillShader> group{ProgramParameters{1.0f, false}};
+    const mbgl::unordered_set<StringIdentity> propertiesAsUniforms;
+
+    // Checking on a pending program doesn't start it again
+    group.prewarmShader(context, propertiesAsUniforms, "a_pos");
+    group.prewarmShader(context, propertiesAsUniforms, "a_pos");
+    EXPECT_EQ(1, context.renderingStats().numLinkedPrograms);
+
+    // Using it finishes the same program
+    const auto shader = group.getOrCreateShader(context, propertiesAsUniforms, "a_pos");
+    ASSERT_TRUE(shader);
+    EXPECT_EQ(1, context.renderingStats().numLinkedPrograms);
+
+    EXPECT_TRUE(group.prewarmShader(context, propertiesAsUniforms, "a_pos"));
+    EXPECT_EQ(shader, group.getOrCreateShader(context, propertiesAsUniforms, "a_pos"));
+    EXPECT_EQ(1, context.renderingStats().numLinkedPrograms);
+}
+
+TEST(GLContext, PrewarmedShadersRenderTheSame) {
+    util::RunLoop loop;
+
+    const auto load = [](Map& map) {
+        map.getStyle().loadJSON(util::read_file("test/fixtures/api/water.json"));
+        map.jumpTo(CameraOptions().withCenter(LatLng{37.8, -122.5}).withZoom(10.0));
+    };
+
+    // A still image waits for the shaders in the frame that first needs them
+    HeadlessFrontend stillFrontend{1};
+    Map stillMap(stillFrontend,
+                 MapObserver::nullObserver(),
+                 MapOptions().withMapMode(MapMode::Static).withSize(stillFrontend.getSize()),
+                 ResourceOptions().withCachePath(":memory:").withAssetPath("test/fixtures/api/assets"));
+    load(stillMap);
+    const auto still = stillFrontend.render(stillMap);
+
+    // A continuous map draws the layers once their shaders are done, in a later frame if needed
+    HeadlessFrontend frontend{1};
+    StubMapObserver observer;
+    observer.didBecomeIdleCallback = [&] {
+        loop.stop();
+    };
+    Map map(frontend,
+            observer,
+            MapOptions().withMapMode(MapMode::Continuous).withSize(frontend.getSize()),
+            ResourceOptions().withCachePath(":memory:").withAssetPath("test/fixtures/api/assets"));
+    load(map);
+    loop.run();
+
+    gfx::BackendScope scope{*frontend.getBackend()};
+    EXPECT_TRUE(still.image == frontend.readStillImage());
+
+    // Each variant is linked once, whether it was ready in time or not
+    EXPECT_LT(0, still.stats.numLinkedPrograms);
+    EXPECT_EQ(still.stats.numLinkedPrograms, frontend.getBackend()->getContext().renderingStats().numLinkedPrograms);
+}
+
+TEST(GLContext, BatchedBackground) {
+    util::RunLoop loop;
+
+    HeadlessFrontend frontend{{1024, 1024}, 1};
+    Map map(frontend,
+            MapObserver::nullObserver(),
+            MapOptions().withMapMode(MapMode::Static).withSize(frontend.getSize()),
+            ResourceOptions().withCachePath(":memory:").withAssetPath("test/fixtures/api/assets"));
+    map.getStyle().loadJSON(R"STYLE({
+  "version": 8,
+  "sources": {},
+  "layers": [{
+    "id": "background",
+    "type": "background",
+    "paint": {
+      "background-color": "rgba(255, 0, 0, 0.5)"
+    }
+  }]
+})STYLE");
+
+    // Centered on tile 5.5/5.5 at z4, the viewport covers tiles 4 to 6 in both directions. Batches start at
+    // multiples of 3 tiles, so the 9 tiles are drawn in 4 batches.
+    map.jumpTo(CameraOptions().withCenter(LatLng{48.92249926375824, -56.25}).withZoom(4.0));
+    const auto result = frontend.render(map);
+    EXPECT_EQ(4, result.stats.numDrawCalls);
+
+    // The batches cover the viewport without gaps or overlaps, so the translucent color is blended once everywhere
+    const auto& image = result.image;
+    ASSERT_TRUE(image.valid());
+    const std::array<uint8_t, 4> first{{image.data[0], image.data[1], image.data[2], image.data[3]}};
+    EXPECT_NE(0, first[3]);
+    for (std::size_t i = 0; i < image.bytes(); i += 4) {
+        const std::array<uint8_t, 4> pixel{{image.data[i], image.data[i + 1], image.data[i + 2], image.data[i + 3]}};
+        ASSERT_EQ(first, pixel) << "at pixel " << i / 4;
+    }
+}
+#endif
+
 #endif
@@ -0,0 +1,100 @@
+#if MLN_RENDER_BACKEND_OPENGL && MLN_DRAWABLE_RENDERER
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/gfx/backend_scope.hpp>
+#include <mbgl/gl/context.hpp>
+#include <mbgl/gl/drawable_gl.hpp>
+#include <mbgl/gl/headless_backend.hpp>
+#include <mbgl/gl/layer_group_gl.hpp>
+#include <mbgl/programs/program_parameters.hpp>
+#include <mbgl/shaders/gl/shader_group_gl.hpp>
+
+#include <map>
+#include <memory>
+#include <optional>
+#include <vector>
+
+using namespace mbgl;
+
+namespace {
+
+class TestTileLayerGroup : public gl::TileLayerGroupGL {
+public:
+    TestTileLayerGroup()
+        : gl::TileLayerGroupGL(0, 0, "test") {}
+
+    using gl::TileLayerGroupGL::sortByState;
+};
+
+} // namespace
+
+TEST(GLTileLayerGroup, SortByState) {
+    gl::HeadlessBackend backend{{256, 256}};
+    gfx::BackendScope scope{backend};
+    gl::Context context{backend};
+
+    const mbgl::unordered_set<StringIdentity> propertiesAsUniforms;
+    gl::ShaderGroupGL<shaders::BuiltIn::FillShader> fillGroup{ProgramParameters{1.0f, false}};
+    gl::ShaderGroupGL<shaders::BuiltIn::FillOutlineShader> outlineGroup{ProgramParameters{1.0f, false}};
+    const auto fill = fillGroup.getOrCreateShader(context, propertiesAsUniforms, "a_pos");
+    const auto outline = outlineGroup.getOrCreateShader(context, propertiesAsUniforms, "a_pos");
+    ASSERT_TRUE(fill && outline);
+
+    std::vector<std::unique_ptr<gfx::Drawable>> owned;
+    const auto make = [&](std::optional<OverscaledTileID> tileID, gfx::ShaderProgramBasePtr shader, bool clipped) {
+        owned.push_back(std::make_unique<gl::DrawableGL>("test"));
+        auto& drawable = *owned.back();
+        if (tileID) {
+            drawable.setTileID(*tileID);
+        }
+        drawable.setShader(std::move(shader));
+        drawable.setEnableStencil(clipped);
+        return &drawable;
+    };
+
+    const OverscaledTileID tile1{1, 0, 0};
+    const OverscaledTileID tile2{1, 1, 0};
+    const OverscaledTileID tile3{1, 0, 1};
+    const std::vector<gfx::Drawable*> drawables{
+        // Tile-clipped: a fill and an outline for each tile, and another outline for the first one
+        make(tile1, fill, true),
+        make(tile1, outline, true),
+        make(tile2, fill, true),
+        make(tile2, outline, true),
+        make(tile1, outline, true),
+        // Not tile-clipped: no tile, no stencil, or 3D
+        make(std::nullopt, fill, true),
+        make(tile3, fill, false),
+        make(tile3, outline, true),
+        make(tile3, fill, true),
+    };
+    drawables[7]->setIs3D(true);
+
+    auto sorted = drawables;
+    TestTileLayerGroup group;
+    group.sortByState(sorted);
+    ASSERT_EQ(drawables.size(), sorted.size());
+
+    // Drawables that aren't tile-clipped split the runs that are sorted, and are never moved
+    for (const std::size_t i : {5, 6, 7, 8}) {
+        EXPECT_EQ(drawables[i], sorted[i]) << "at " << i;
+    }
+
+    // Within the sorted run, each tile's drawables are drawn in their original order
+    std::map<OverscaledTileID, std::vector<gfx::Drawable*>> before;
+    std::map<OverscaledTileID, std::vector<gfx::Drawable*>> after;
+    for (std::size_t i = 0; i < 5; ++i) {
+        before[*drawables[i]->getTileID()].push_back(drawables[i]);
+        after[*sorted[i]->getTileID()].push_back(sorted[i]);
+    }
+    EXPECT_EQ(before, after);
+
+    // The fills of both tiles are drawn before their outlines, so draws with the same shader are adjacent
+    EXPECT_EQ(drawables[0], sorted[0]);
+    EXPECT_EQ(drawables[2], sorted[1]);
+    EXPECT_EQ(drawables[1], sorted[2]);
+    EXPECT_EQ(drawables[3], sorted[3]);
+    EXPECT_EQ(drawables[4], sorted[4]);
+}
+
+#endif
@@ -0,0 +1,116 @@
+#if MLN_RENDER_BACKEND_OPENGL
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/gl/program_binary_cache.hpp>
+#include <mbgl/util/io.hpp>
+
+using namespace mbgl;
+
+namespace {
+
+constexpr const char* cachePath = "test/fixtures/shader_registry/program_binary_cache.tmp";
+
+// Removes the cache file and the lock file its writers leave next to it
+void deleteCache() {
+    util::deleteFile(cachePath);
+    util::deleteFile(std::string(cachePath) + ".lock");
+}
+
+gl::ProgramBinaryCache::Binary makeBinary(uint32_t format, std::string data) {
+    gl::ProgramBinaryCache::Binary binary;
+    binary.format = format;
+    binary.data = std::move(data);
+    return binary;
+}
+
+} // namespace
+
+TEST(GLProgramBinaryCache, Key) {
+    const auto key = gl::ProgramBinaryCache::makeKey({"#define A\n", "void main() {}"}, {"void main() {}"}, "a_pos");
+    EXPECT_EQ(key, gl::ProgramBinaryCache::makeKey({"#define A\n", "void main() {}"}, {"void main() {}"}, "a_pos"));
+
+    // Defines, sources and attribute bindings are all part of the key
+    EXPECT_NE(key, gl::ProgramBinaryCache::makeKey({"#define B\n", "void main() {}"}, {"void main() {}"}, "a_pos"));
+    EXPECT_NE(key, gl::ProgramBinaryCache::makeKey({"#define A\n", "void main() {}"}, {"void main() { }"}, "a_pos"));
+    EXPECT_NE(key, gl::ProgramBinaryCache::makeKey({"#define A\n", "void main() {}"}, {"void main() {}"}, "a_uv"));
+    EXPECT_NE(key, gl::ProgramBinaryCache::makeKey({"#define A\nvoid main() {}"}, {"void main() {}"}, "a_pos"));
+}
+
+TEST(GLProgramBinaryCache, PersistsAcrossInstances) {
+    deleteCache();
+
+    {
+        gl::ProgramBinaryCache cache(cachePath, "Vendor\nRenderer\n1.0\n");
+        EXPECT_FALSE(cache.get(1));
+
+        cache.put(1, makeBinary(7, std::string("\0binary\0", 8)));
+        cache.put(2, makeBinary(7, "other"));
+        cache.flush();
+    }
+
+    {
+        gl::ProgramBinaryCache cache(cachePath, "Vendor\nRenderer\n1.0\n");
+        EXPECT_EQ(2u, cache.size());
+
+        const auto binary = cache.get(1);
+        ASSERT_TRUE(binary);
+        EXPECT_EQ(7u, binary->format);
+        EXPECT_EQ(std::string("\0binary\0", 8), binary->data);
+
+        cache.remove(2);
+        cache.flush();
+    }
+
+    // Binaries from another driver are discarded
+    gl::ProgramBinaryCache cache(cachePath, "Vendor\nRenderer\n2.0\n");
+    EXPECT_EQ(0u, cache.size());
+
+    deleteCache();
+}
+
+TEST(GLProgramBinaryCache, EvictsLeastRecentlyUsed) {
+    deleteCache();
+
+    {
+        // Room for three binaries
+        gl::ProgramBinaryCache cache(cachePath, "Vendor\nRenderer\n1.0\n", 30);
+        cache.put(1, makeBinary(7, std::string(10, 'a')));
+        cache.put(2, makeBinary(7, std::string(10, 'b')));
+        cache.put(3, makeBinary(7, std::string(10, 'c')));
+        EXPECT_TRUE(cache.get(1));
+
+        cache.put(4, makeBinary(7, std::string(10, 'd')));
+        EXPECT_EQ(3u, cache.size());
+        EXPECT_FALSE(cache.get(2));
+
+        // Too large to keep at all
+        cache.put(5, makeBinary(7, std::string(31, 'e')));
+        EXPECT_EQ(3u, cache.size());
+        EXPECT_FALSE(cache.get(5));
+
+        EXPECT_TRUE(cache.needsFlush());
+        cache.flush();
+        EXPECT_FALSE(cache.needsFlush());
+    }
+
+    // The order of use is kept in the file, 3 is the least recently used
+    gl::ProgramBinaryCache cache(cachePath, "Vendor\nRenderer\n1.0\n", 30);
+    cache.put(6, makeBinary(7, std::string(10, 'f')));
+    EXPECT_FALSE(cache.get(3));
+    EXPECT_TRUE(cache.get(1));
+    EXPECT_TRUE(cache.get(4));
+    EXPECT_TRUE(cache.get(6));
+
+    deleteCache();
+}
+
+TEST(GLProgramBinaryCache, IgnoresCorruptFile) {
+    util::write_file(cachePath, "MLNP garbage");
+
+    gl::ProgramBinaryCache cache(cachePath, "Vendor\nRenderer\n1.0\n");
+    EXPECT_EQ(0u, cache.size());
+
+    deleteCache();
+}
+
+#endif
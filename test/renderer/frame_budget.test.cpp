@@ -0,0 +1,78 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/renderer/frame_budget.hpp>
+
+using namespace mbgl;
+
+namespace {
+
+// A clock which only moves when told to
+struct ManualClock {
+    std::chrono::duration<double> now{0};
+
+    FrameBudget::Clock get() {
+        return [this] { return now; };
+    }
+};
+
+} // namespace
+
+TEST(FrameBudget, Unlimited) {
+    ManualClock clock;
+    FrameBudget budget{clock.get()};
+    budget.start(Duration::zero());
+    clock.now += Seconds(1);
+
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_TRUE(budget.admit());
+    }
+    EXPECT_FALSE(budget.isLimited());
+    EXPECT_FALSE(budget.isExceeded());
+    EXPECT_EQ(100u, budget.getAdmittedCount());
+    EXPECT_EQ(0u, budget.getDeferredCount());
+}
+
+TEST(FrameBudget, DefersOnceExceeded) {
+    ManualClock clock;
+    FrameBudget budget{clock.get()};
+    budget.start(Milliseconds(10));
+    EXPECT_TRUE(budget.admit());
+    clock.now += Milliseconds(5);
+    EXPECT_FALSE(budget.isExceeded());
+    EXPECT_TRUE(budget.admit());
+
+    clock.now += Milliseconds(6);
+    EXPECT_TRUE(budget.isExceeded());
+    EXPECT_DOUBLE_EQ(0.011, budget.elapsed());
+    EXPECT_FALSE(budget.admit());
+    EXPECT_FALSE(budget.admit());
+    EXPECT_EQ(2u, budget.getAdmittedCount());
+    EXPECT_EQ(2u, budget.getDeferredCount());
+
+    // Each frame starts afresh
+    budget.start(Milliseconds(10));
+    EXPECT_EQ(0u, budget.getDeferredCount());
+    EXPECT_FALSE(budget.isExceeded());
+    EXPECT_TRUE(budget.admit());
+}
+
+TEST(FrameBudget, AlwaysAdmitsFirst) {
+    // Work deferred from frames which exceed the budget on their own must still make progress
+    ManualClock clock;
+    FrameBudget budget{clock.get()};
+    budget.start(Milliseconds(10));
+    clock.now += Milliseconds(20);
+
+    EXPECT_TRUE(budget.admit());
+    EXPECT_FALSE(budget.admit());
+}
+
+TEST(FrameBudget, Defer) {
+    // Work can be left to a later frame regardless of the budget
+    ManualClock clock;
+    FrameBudget budget{clock.get()};
+    budget.start(Duration::zero());
+    budget.defer();
+    EXPECT_TRUE(budget.admit());
+    EXPECT_EQ(1u, budget.getDeferredCount());
+}
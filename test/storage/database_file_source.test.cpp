@@ -1,12 +1,19 @@
+#include <mbgl/storage/database_file_source.hpp>
 #include <mbgl/storage/file_source_manager.hpp>
 #include <mbgl/storage/resource.hpp>
 #include <mbgl/storage/resource_options.hpp>
+#include <mbgl/storage/response.hpp>
+#include <mbgl/storage/sqlite3.hpp>
 #include <mbgl/test/util.hpp>
+#include <mbgl/util/client_options.hpp>
+#include <mbgl/util/io.hpp>
 #include <mbgl/util/run_loop.hpp>
 #include <mbgl/util/timer.hpp>
 
 #include <gtest/gtest.h>
 
+#include <future>
+
 using namespace mbgl;
 
 TEST(DatabaseFileSource, PauseResume) {
@@ -54,4 +61,140 @@ TEST(DatabaseFileSource, VolatileResource) {
         });
     });
     loop.run();
-}
\ No newline at end of file
+}
+TEST(DatabaseFileSource, TEST_REQUIRES_WRITE(ReadFromReader)) {
+    using namespace std::chrono_literals;
+
+    util::RunLoop loop;
+
+    const std::string path = "test/fixtures/offline_database/database_file_source.db";
+    const auto deleteDatabaseFiles = [&] {
+        util::deleteFile(path);
+        util::deleteFile(path + "-journal");
+    };
+    deleteDatabaseFiles();
+
+    auto dbfs = std::make_shared<DatabaseFileSource>(ResourceOptions().withCachePath(path), ClientOptions());
+
+    const Resource resource{Resource::Unknown, "http://127.0.0.1:3000/test", {}, Resource::LoadingMethod::CacheOnly};
+    Response response;
+    response.data = std::make_shared<std::string>("Cached value");
+
+    const auto accessed = [&] {
+        auto db = mapbox::sqlite::Database::open(path, mapbox::sqlite::ReadWriteCreate);
+        db.setBusyTimeout(Milliseconds::max());
+        mapbox::sqlite::Statement stmt{db, "SELECT accessed FROM resources WHERE url = ?"};
+        mapbox::sqlite::Query query{stmt};
+        query.bind(1, resource.url);
+        return query.run() ? query.get<int64_t>(0) : -1;
+    };
+
+    std::promise<void> served;
+    std::unique_ptr<AsyncRequest> req;
+
+    dbfs->forward(resource, response, [&] {
+        {
+            auto db = mapbox::sqlite::Database::open(path, mapbox::sqlite::ReadWriteCreate);
+            db.setBusyTimeout(Milliseconds::max());
+            db.exec("UPDATE resources SET accessed = 0");
+        }
+        EXPECT_EQ(0, accessed());
+
+        // The callback runs on the database thread, which stays busy until a
+        // reader has served the cached value.
+        dbfs->packDatabase([&](std::exception_ptr) {
+            loop.invoke([&] {
+                req = dbfs->request(resource, [&](Response res) {
+                    EXPECT_EQ(nullptr, res.error);
+                    ASSERT_TRUE(res.data.get());
+                    EXPECT_EQ("Cached value", *res.data);
+                    served.set_value();
+
+                    // The reader forwarded the timestamp update to the writer.
+                    dbfs->packDatabase([&](std::exception_ptr) {
+                        EXPECT_LT(0, accessed());
+
+                        // The readers follow the writer to the new database.
+                        dbfs->resetDatabase([&](std::exception_ptr error) {
+                            EXPECT_FALSE(error);
+                            loop.invoke([&] {
+                                req = dbfs->request(resource, [&](Response res2) {
+                                    req.reset();
+                                    ASSERT_TRUE(res2.error.get());
+                                    EXPECT_EQ(Response::Error::Reason::NotFound, res2.error->reason);
+                                    loop.stop();
+                                });
+                            });
+                        });
+                    });
+                });
+            });
+            EXPECT_EQ(std::future_status::ready, served.get_future().wait_for(10s));
+        });
+    });
+
+    loop.run();
+
+    req.reset();
+    dbfs.reset();
+    deleteDatabaseFiles();
+}
+
+TEST(DatabaseFileSource, TEST_REQUIRES_WRITE(JournalMode)) {
+    util::RunLoop loop;
+
+    const std::string path = "test/fixtures/offline_database/database_file_source.db";
+    const auto deleteDatabaseFiles = [&] {
+        util::deleteFile(path);
+        util::deleteFile(path + "-wal");
+        util::deleteFile(path + "-shm");
+        util::deleteFile(path + "-journal");
+    };
+    deleteDatabaseFiles();
+
+    auto dbfs = std::make_shared<DatabaseFileSource>(ResourceOptions().withCachePath(path), ClientOptions());
+
+    const Resource resource{Resource::Unknown, "http://127.0.0.1:3000/test", {}, Resource::LoadingMethod::CacheOnly};
+    Response response;
+    response.data = std::make_shared<std::string>("Cached value");
+
+    const auto journalMode = [&] {
+        auto db = mapbox::sqlite::Database::open(path, mapbox::sqlite::ReadOnly);
+        mapbox::sqlite::Statement stmt{db, "PRAGMA journal_mode"};
+        mapbox::sqlite::Query query{stmt};
+        query.run();
+        return query.get<std::string>(0);
+    };
+
+    std::unique_ptr<AsyncRequest> req;
+
+    dbfs->setProperty(JOURNAL_MODE_KEY, std::string("wal"));
+    dbfs->setProperty(WAL_CHECKPOINT_PAGES_KEY, uint64_t{100});
+    dbfs->forward(resource, response, [&] {
+        EXPECT_EQ("wal", journalMode());
+
+        // The readers opened the database again after the switch.
+        loop.invoke([&] {
+            req = dbfs->request(resource, [&](Response res) {
+                EXPECT_EQ(nullptr, res.error);
+                ASSERT_TRUE(res.data.get());
+                EXPECT_EQ("Cached value", *res.data);
+
+                // The readers close their connections, so that the file can leave WAL mode.
+                dbfs->setProperty(JOURNAL_MODE_KEY, std::string("delete"));
+                dbfs->forward(resource, response, [&] {
+                    EXPECT_EQ("delete", journalMode());
+                    loop.invoke([&] {
+                        req.reset();
+                        loop.stop();
+                    });
+                });
+            });
+        });
+    });
+
+    loop.run();
+
+    dbfs.reset();
+    deleteDatabaseFiles();
+}
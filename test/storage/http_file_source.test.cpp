@@ -207,3 +207,30 @@ TEST(HTTPFileSource, TEST_REQUIRES_SERVER(Load)) {
 
     loop.run();
 }
+
+TEST(HTTPFileSource, TEST_REQUIRES_SERVER(ConnectionLimits)) {
+    util::RunLoop loop;
+    HTTPFileSource fs(ResourceOptions::Default(),
+                      ClientOptions().withMaximumConnectionsPerHost(2).withConnectionPoolSize(2).withTCPKeepAlive(
+                          Seconds(30)));
+
+    // Requests beyond the connection limit queue up rather than fail
+    const int concurrency = 20;
+    int pending = concurrency;
+    std::unique_ptr<AsyncRequest> reqs[concurrency];
+    for (int i = 0; i < concurrency; i++) {
+        reqs[i] = fs.request({Resource::Unknown, std::string("http://127.0.0.1:3000/load/") + util::toString(i)},
+                             [&, i](Response res) {
+                                 reqs[i].reset();
+                                 EXPECT_EQ(nullptr, res.error);
+                                 ASSERT_TRUE(res.data.get());
+                                 EXPECT_EQ(std::string("Request ") + util::toString(i), *res.data);
+                                 if (--pending == 0) {
+                                     loop.stop();
+                                 }
+                             });
+    }
+
+    loop.run();
+    EXPECT_EQ(0, pending);
+}
@@ -12,6 +12,8 @@
 #include <mbgl/util/timer.hpp>
 #include <mbgl/util/tile_server_options.hpp>
 
+#include <set>
+
 using namespace mbgl;
 
 TEST(MainResourceLoader, TEST_REQUIRES_SERVER(CacheResponse)) {
@@ -842,6 +844,120 @@ TEST(MainResourceLoader, TEST_REQUIRES_SERVER(NoDoubleDispatch)) {
     loop.run();
 }
 
+TEST(MainResourceLoader, TEST_REQUIRES_SERVER(CoalesceIdenticalRequests)) {
+    util::RunLoop loop;
+    MainResourceLoader fs(ResourceOptions{}, ClientOptions{});
+
+    // Every request that reaches the server gets a different response.
+    const Resource resource{
+        Resource::Unknown, "http://127.0.0.1:3000/revalidate-etag", {}, Resource::LoadingMethod::NetworkOnly};
+
+    std::vector<Response> responses;
+    auto callback = [&](Response res) {
+        responses.push_back(res);
+        if (responses.size() == 2) {
+            loop.stop();
+        }
+    };
+
+    std::unique_ptr<AsyncRequest> req1 = fs.request(resource, callback);
+    std::unique_ptr<AsyncRequest> req2 = fs.request(resource, callback);
+    // Cancelling one of the requests doesn't cancel the others.
+    std::unique_ptr<AsyncRequest> req3 = fs.request(resource, [](Response) { FAIL() << "Should never be called"; });
+    req3.reset();
+
+    loop.run();
+
+    ASSERT_EQ(2u, responses.size());
+    for (const auto& res : responses) {
+        EXPECT_EQ(nullptr, res.error);
+        ASSERT_TRUE(res.data.get());
+    }
+    EXPECT_EQ(*responses[0].data, *responses[1].data);
+    EXPECT_EQ(responses[0].etag, responses[1].etag);
+}
+
+TEST(MainResourceLoader, TEST_REQUIRES_SERVER(CoalescedRequestGetsDataAfterNotModified)) {
+    util::RunLoop loop;
+    MainResourceLoader fs(ResourceOptions{}, ClientOptions{});
+
+    const Resource revalidateSame{Resource::Unknown, "http://127.0.0.1:3000/revalidate-same"};
+    std::unique_ptr<AsyncRequest> req1;
+    std::unique_ptr<AsyncRequest> req2;
+    std::unique_ptr<AsyncRequest> req3;
+    std::vector<Response> responses;
+
+    // The first request caches a response that must be revalidated.
+    req1 = fs.request(revalidateSame, [&](Response) {
+        req1.reset();
+
+        // The second request gets the revalidated data, and a 304 without data
+        // once the response expires after a second.
+        req2 = fs.request(revalidateSame, [&](Response res2) {
+            if (!res2.notModified) {
+                return;
+            }
+            EXPECT_FALSE(res2.data.get());
+
+            // A request that attaches now gets the data, followed by the 304.
+            req3 = fs.request(revalidateSame, [&](Response res3) {
+                responses.push_back(res3);
+                if (responses.size() == 2) {
+                    req2.reset();
+                    req3.reset();
+                    loop.stop();
+                }
+            });
+        });
+    });
+
+    loop.run();
+
+    ASSERT_EQ(2u, responses.size());
+    EXPECT_FALSE(responses[0].notModified);
+    ASSERT_TRUE(responses[0].data.get());
+    EXPECT_EQ("Response", *responses[0].data);
+    EXPECT_TRUE(responses[1].notModified);
+    EXPECT_FALSE(responses[1].data.get());
+}
+
+TEST(MainResourceLoader, TEST_REQUIRES_SERVER(DontCoalesceDifferentRequests)) {
+    util::RunLoop loop;
+    MainResourceLoader fs(ResourceOptions{}, ClientOptions{});
+
+    // Every request that reaches the server gets a different response.
+    const std::string url = "http://127.0.0.1:3000/revalidate-etag";
+    Resource unknown{Resource::Unknown, url, {}, Resource::LoadingMethod::NetworkOnly};
+    Resource style{Resource::Style, url, {}, Resource::LoadingMethod::NetworkOnly};
+    Resource offline = unknown;
+    offline.setUsage(Resource::Usage::Offline);
+    Resource withPriorData = unknown;
+    withPriorData.priorData = std::make_shared<const std::string>("Prior");
+
+    std::vector<Response> responses;
+    auto callback = [&](Response res) {
+        responses.push_back(res);
+        if (responses.size() == 4) {
+            loop.stop();
+        }
+    };
+
+    std::unique_ptr<AsyncRequest> req1 = fs.request(unknown, callback);
+    std::unique_ptr<AsyncRequest> req2 = fs.request(style, callback);
+    std::unique_ptr<AsyncRequest> req3 = fs.request(offline, callback);
+    std::unique_ptr<AsyncRequest> req4 = fs.request(withPriorData, callback);
+
+    loop.run();
+
+    ASSERT_EQ(4u, responses.size());
+    std::set<std::string> etags;
+    for (const auto& res : responses) {
+        ASSERT_TRUE(res.etag);
+        etags.insert(*res.etag);
+    }
+    EXPECT_EQ(4u, etags.size());
+}
+
 TEST(MainResourceLoader, ResourceOptions) {
     MainResourceLoader fs(ResourceOptions().withTileServerOptions(
                               TileServerOptions().withBaseURL("originalBaseURL").withUriSchemeAlias("originalAlias")),
@@ -32,6 +32,7 @@ static void deleteDatabaseFiles() {
     // Delete leftover journaling files as well.
     util::deleteFile(filename);
     util::deleteFile(filename + "-wal"s);
+    util::deleteFile(filename + "-shm"s);
     util::deleteFile(filename + "-journal"s);
 }
 
@@ -98,6 +99,14 @@ static std::vector<std::string> databaseTableColumns(const std::string& path, co
     return columns;
 }
 
+static int64_t databaseTileDataCount(const std::string& path) {
+    mapbox::sqlite::Database db = mapbox::sqlite::Database::open(path, mapbox::sqlite::ReadOnly);
+    mapbox::sqlite::Statement stmt{db, "SELECT COUNT(*) FROM tile_data"};
+    mapbox::sqlite::Query query{stmt};
+    query.run();
+    return query.get<int64_t>(0);
+}
+
 static int databaseAutoVacuum(const std::string& path) {
     mapbox::sqlite::Database db = mapbox::sqlite::Database::open(path, mapbox::sqlite::ReadOnly);
     mapbox::sqlite::Statement stmt{db, "pragma auto_vacuum"};
@@ -238,7 +247,7 @@ TEST(OfflineDatabase, TEST_REQUIRES_WRITE(SchemaVersion)) {
 
     { OfflineDatabase db(filename, fixture::tileServerOptions); }
 
-    EXPECT_EQ(6, databaseUserVersion(filename));
+    EXPECT_EQ(8, databaseUserVersion(filename));
 
     OfflineDatabase db(filename, fixture::tileServerOptions);
     // Now try inserting and reading back to make sure we have a valid database.
@@ -432,6 +441,183 @@ TEST(OfflineDatabase, PutTileNotFound) {
     EXPECT_EQ(0u, log.uncheckedCount());
 }
 
+TEST(OfflineDatabase, TEST_REQUIRES_WRITE(PutTileSharesIdenticalData)) {
+    FixtureLog log;
+    deleteDatabaseFiles();
+    OfflineDatabase db(filename, fixture::tileServerOptions);
+
+    Resource first{Resource::Tile, "http://example.com/"};
+    first.tileData = Resource::TileData{"http://example.com/", 1, 0, 0, 1};
+    Resource second{Resource::Tile, "http://example.com/"};
+    second.tileData = Resource::TileData{"http://example.com/", 1, 1, 0, 1};
+    Response response;
+
+    response.data = std::make_shared<std::string>("ocean");
+    db.put(first, response);
+    db.put(second, response);
+    EXPECT_EQ(1, databaseTileDataCount(filename));
+
+    // Replacing the contents of one tile leaves the other one intact.
+    response.data = std::make_shared<std::string>("land");
+    db.put(first, response);
+    EXPECT_EQ(2, databaseTileDataCount(filename));
+    EXPECT_EQ("land", *db.get(first)->data);
+    EXPECT_EQ("ocean", *db.get(second)->data);
+
+    // Contents are deleted along with the last tile referencing them.
+    db.put(second, response);
+    EXPECT_EQ(1, databaseTileDataCount(filename));
+    EXPECT_EQ("land", *db.get(second)->data);
+
+    db.clearAmbientCache();
+    EXPECT_EQ(0, databaseTileDataCount(filename));
+
+    EXPECT_EQ(0u, log.uncheckedCount());
+}
+
+TEST(OfflineDatabase, TEST_REQUIRES_WRITE(AmbientCacheSizeCountsSharedDataOnce)) {
+    FixtureLog log;
+    deleteDatabaseFiles();
+
+    // 60 tiles with the same 10 KB of contents take far less than the 200 KB
+    // limit, but 600 KB if the contents were counted once for every tile.
+    Response response;
+    response.data = randomString(10 * 1024);
+    const auto tile = [](int32_t x) {
+        return Resource::tile("http://example.com/{z}-{x}-{y}", 1, x, 0, 10, Tileset::Scheme::XYZ);
+    };
+    {
+        OfflineDatabase db(filename, fixture::tileServerOptions);
+        db.setMaximumAmbientCacheSize(200 * 1024);
+        for (int32_t x = 0; x < 60; ++x) {
+            db.put(tile(x), response);
+        }
+        EXPECT_EQ(1, databaseTileDataCount(filename));
+    }
+
+    // The size of the ambient cache is computed again from the database, and
+    // nothing needs to be evicted to make room for another 100 KB.
+    OfflineDatabase db(filename, fixture::tileServerOptions);
+    db.setMaximumAmbientCacheSize(200 * 1024);
+    Response other;
+    other.data = randomString(100 * 1024);
+    EXPECT_TRUE(db.put(Resource::style("http://example.com/style.json"), other).first);
+    for (int32_t x = 0; x < 60; ++x) {
+        EXPECT_TRUE(bool(db.get(tile(x)))) << x;
+    }
+    EXPECT_EQ(1, databaseTileDataCount(filename));
+
+    EXPECT_EQ(0u, log.uncheckedCount());
+}
+
+TEST(OfflineDatabase, PutWithCompression) {
+    FixtureLog log;
+    OfflineDatabase db(":memory:", fixture::tileServerOptions);
+
+    const std::string text(1024, 'a');
+    Response response;
+    response.data = std::make_shared<std::string>(text);
+
+    Resource deflated{Resource::Style, "http://example.com/deflated"};
+    EXPECT_GT(text.size(), db.put(deflated, response).second);
+
+    // Data in a compressed format isn't deflated again.
+    Resource image{Resource::Image, "http://example.com/image.png"};
+    Response png;
+    png.data = std::make_shared<std::string>(std::string("\x89PNG\r\n\x1a\n", 8) + text);
+    EXPECT_EQ(png.data->size(), db.put(image, png).second);
+
+    db.setCompression(OfflineCompression::None);
+    Resource stored{Resource::Style, "http://example.com/stored"};
+    EXPECT_EQ(text.size(), db.put(stored, response).second);
+
+    // Rows are read back with the codec they were written with.
+    EXPECT_EQ(text, *db.get(deflated)->data);
+    EXPECT_EQ(text, *db.get(stored)->data);
+    EXPECT_EQ(*png.data, *db.get(image)->data);
+
+    EXPECT_EQ(0u, log.uncheckedCount());
+}
+
+TEST(OfflineDatabase, TEST_REQUIRES_WRITE(GetWithUnknownCompression)) {
+    FixtureLog log;
+    deleteDatabaseFiles();
+
+    Resource resource{Resource::Style, "http://example.com/"};
+    Response response;
+    response.data = std::make_shared<std::string>(1024, 'a');
+    {
+        OfflineDatabase db(filename, fixture::tileServerOptions);
+        db.put(resource, response);
+    }
+
+    // Tag the row with a codec this version doesn't implement, as a newer
+    // version would.
+    {
+        mapbox::sqlite::Database db = mapbox::sqlite::Database::open(filename, mapbox::sqlite::ReadWriteCreate);
+        db.exec("UPDATE resources SET compressed = 2");
+    }
+
+    OfflineDatabase db(filename, fixture::tileServerOptions);
+    EXPECT_FALSE(bool(db.get(resource)));
+    EXPECT_EQ(1u,
+              log.count({EventSeverity::Error,
+                         Event::Database,
+                         -1,
+                         "Can't read resource: Unsupported compression codec 2"}));
+
+    EXPECT_EQ(0u, log.uncheckedCount());
+}
+
+TEST(OfflineDatabase, TEST_REQUIRES_WRITE(JournalModeWAL)) {
+    FixtureLog log;
+    deleteDatabaseFiles();
+
+    OfflineDatabase db(filename, fixture::tileServerOptions);
+    EXPECT_EQ("delete", databaseJournalMode(filename));
+    db.setJournalMode(OfflineJournalMode::WAL);
+    db.setWALCheckpointPages(10);
+    EXPECT_EQ("wal", databaseJournalMode(filename));
+
+    Response response;
+    response.data = randomString(5 * 1024);
+
+    // A reader in the middle of a transaction doesn't keep the writer from
+    // committing, and keeps seeing the database as it was when it started.
+    {
+        mapbox::sqlite::Database reader = mapbox::sqlite::Database::open(filename, mapbox::sqlite::ReadOnly);
+        mapbox::sqlite::Statement stmt{reader, "SELECT COUNT(*) FROM resources"};
+        reader.exec("BEGIN");
+        {
+            mapbox::sqlite::Query query{stmt};
+            query.run();
+            EXPECT_EQ(0, query.get<int64_t>(0));
+        }
+        EXPECT_TRUE(db.put(Resource::style("http://example.com/"), response).first);
+        {
+            mapbox::sqlite::Query query{stmt};
+            query.run();
+            EXPECT_EQ(0, query.get<int64_t>(0));
+        }
+        reader.exec("COMMIT");
+    }
+
+    // The log is checkpointed as it grows, and emptied when packing.
+    for (int i = 0; i < 100; ++i) {
+        db.put(Resource::style("http://example.com/" + std::to_string(i)), response);
+    }
+    EXPECT_GT(100u * 5 * 1024, util::read_file(filename + "-wal"s).size());
+    EXPECT_EQ(nullptr, db.pack());
+    EXPECT_EQ(0u, util::read_file(filename + "-wal"s).size());
+
+    // Switching back is possible once no other connection has the file open.
+    db.setJournalMode(OfflineJournalMode::Delete);
+    EXPECT_EQ("delete", databaseJournalMode(filename));
+    EXPECT_TRUE(bool(db.get(Resource::style("http://example.com/"))));
+
+    EXPECT_EQ(0u, log.uncheckedCount());
+}
+
 TEST(OfflineDatabase, CreateRegion) {
     FixtureLog log;
     OfflineDatabase db(":memory:", fixture::tileServerOptions);
@@ -1419,7 +1605,7 @@ TEST(OfflineDatabase, MigrateFromV2Schema) {
         }
     }
 
-    EXPECT_EQ(6, databaseUserVersion(filename));
+    EXPECT_EQ(8, databaseUserVersion(filename));
     EXPECT_LT(databasePageCount(filename), databasePageCount("test/fixtures/offline_database/v2.db"));
 
     EXPECT_EQ(0u, log.uncheckedCount());
@@ -1441,7 +1627,7 @@ TEST(OfflineDatabase, MigrateFromV3Schema) {
         }
     }
 
-    EXPECT_EQ(6, databaseUserVersion(filename));
+    EXPECT_EQ(8, databaseUserVersion(filename));
 
     EXPECT_EQ(0u, log.uncheckedCount());
 }
@@ -1463,7 +1649,7 @@ TEST(OfflineDatabase, MigrateFromV4Schema) {
         }
     }
 
-    EXPECT_EQ(6, databaseUserVersion(filename));
+    EXPECT_EQ(8, databaseUserVersion(filename));
 
     // Journal mode should be DELETE after migration to v5.
     EXPECT_EQ("delete", databaseJournalMode(filename));
@@ -1490,7 +1676,7 @@ TEST(OfflineDatabase, MigrateFromV5Schema) {
         }
     }
 
-    EXPECT_EQ(6, databaseUserVersion(filename));
+    EXPECT_EQ(8, databaseUserVersion(filename));
 
     EXPECT_EQ((std::vector<std::string>{"id",
                                         "url_template",
@@ -1501,8 +1687,7 @@ TEST(OfflineDatabase, MigrateFromV5Schema) {
                                         "expires",
                                         "modified",
                                         "etag",
-                                        "data",
-                                        "compressed",
+                                        "data_id",
                                         "accessed",
                                         "must_revalidate"}),
               databaseTableColumns(filename, "tiles"));
@@ -1510,6 +1695,53 @@ TEST(OfflineDatabase, MigrateFromV5Schema) {
         (std::vector<std::string>{
             "id", "url", "kind", "expires", "modified", "etag", "data", "compressed", "accessed", "must_revalidate"}),
         databaseTableColumns(filename, "resources"));
+    EXPECT_EQ((std::vector<std::string>{"region_id",
+                                        "url_template",
+                                        "min_zoom",
+                                        "max_zoom",
+                                        "scheme",
+                                        "position",
+                                        "tile_count",
+                                        "tile_size"}),
+              databaseTableColumns(filename, "region_checkpoints"));
+    EXPECT_EQ((std::vector<std::string>{"id", "hash", "data", "compressed", "ref_count"}),
+              databaseTableColumns(filename, "tile_data"));
+
+    EXPECT_EQ(0u, log.uncheckedCount());
+}
+
+TEST(OfflineDatabase, MigrateFromV5SchemaKeepsTiles) {
+    FixtureLog log;
+    deleteDatabaseFiles();
+    util::copyFile(filename, "test/fixtures/offline_database/v5.db");
+
+    // Three tiles sharing two distinct blobs
+    const std::vector<std::string> tileData{"tile-a", "tile-b", "tile-a"};
+    {
+        mapbox::sqlite::Database db = mapbox::sqlite::Database::open(filename, mapbox::sqlite::ReadWriteCreate);
+        mapbox::sqlite::Statement stmt{db,
+                                       "INSERT INTO tiles (url_template, pixel_ratio, z, x, y, data, accessed) "
+                                       "VALUES ('maptiler://test', 1, 1, ?1, 0, ?2, 0)"};
+        for (std::size_t i = 0; i < tileData.size(); ++i) {
+            mapbox::sqlite::Query query{stmt};
+            query.bind(1, static_cast<int64_t>(i));
+            query.bindBlob(2, tileData[i].data(), tileData[i].size(), false);
+            query.run();
+        }
+    }
+
+    {
+        OfflineDatabase db(filename, fixture::tileServerOptions);
+        for (std::size_t i = 0; i < tileData.size(); ++i) {
+            auto result = db.get(
+                Resource::tile("maptiler://test", 1, static_cast<int32_t>(i), 0, 1, Tileset::Scheme::XYZ));
+            ASSERT_TRUE(result && result->data);
+            EXPECT_EQ(tileData[i], *result->data);
+        }
+    }
+
+    EXPECT_EQ(8, databaseUserVersion(filename));
+    EXPECT_EQ(2, databaseTileDataCount(filename));
 
     EXPECT_EQ(0u, log.uncheckedCount());
 }
@@ -1547,7 +1779,7 @@ TEST(OfflineDatabase, DowngradeSchema) {
         db.setMaximumAmbientCacheSize(0);
     }
 
-    EXPECT_EQ(6, databaseUserVersion(filename));
+    EXPECT_EQ(8, databaseUserVersion(filename));
 
     EXPECT_EQ((std::vector<std::string>{"id",
                                         "url_template",
@@ -1558,8 +1790,7 @@ TEST(OfflineDatabase, DowngradeSchema) {
                                         "expires",
                                         "modified",
                                         "etag",
-                                        "data",
-                                        "compressed",
+                                        "data_id",
                                         "accessed",
                                         "must_revalidate"}),
               databaseTableColumns(filename, "tiles"));
@@ -1630,6 +1861,25 @@ TEST(OfflineDatabase, CorruptDatabaseOnQuery) {
     }
 }
 
+TEST(OfflineDatabase, CorruptDatabaseOnReadOnlyQuery) {
+    FixtureLog log;
+    util::deleteFile(filename);
+    util::copyFile(filename, "test/fixtures/offline_database/corrupt-delayed.db");
+
+    // A read-only connection reports the error, but leaves replacing the
+    // database to the connection writing to it.
+    OfflineDatabase db(filename, fixture::tileServerOptions, true /*readOnly*/);
+    EXPECT_EQ(std::nullopt, db.get(fixture::resource));
+    EXPECT_EQ(1u, log.count(error(ResultCode::Corrupt, "Can't read resource: database disk image is malformed"), true));
+    EXPECT_EQ(0u, log.uncheckedCount());
+    EXPECT_EQ(util::readFile("test/fixtures/offline_database/corrupt-delayed.db"), util::readFile(filename));
+
+    // The next request opens the database again.
+    EXPECT_EQ(std::nullopt, db.get(fixture::resource));
+    EXPECT_EQ(1u, log.count(error(ResultCode::Corrupt, "Can't read resource: database disk image is malformed"), true));
+    EXPECT_EQ(0u, log.uncheckedCount());
+}
+
 #ifndef __QT__ // Qt doesn't expose the ability to register virtual file system handlers.
 TEST(OfflineDatabase, TEST_REQUIRES_WRITE(DisallowedIO)) {
     FixtureLog log;
@@ -2024,3 +2274,36 @@ TEST(OfflineDatabase, TEST_REQUIRES_WRITE(UpdateDatabaseReadOnlyMode)) {
 
     EXPECT_EQ(0u, log.uncheckedCount());
 }
+
+TEST(OfflineDatabase, TEST_REQUIRES_WRITE(ReadOnlyConnectionReadsCommittedWrites)) {
+    FixtureLog log;
+    deleteDatabaseFiles();
+
+    OfflineDatabase writer(filename, fixture::tileServerOptions);
+
+    OfflineDatabase reader(filename, fixture::tileServerOptions, true /*readOnly*/);
+    EXPECT_FALSE(reader.get(fixture::tile));
+
+    Response response;
+    response.data = std::make_shared<std::string>("first");
+    writer.put(fixture::tile, response);
+
+    // The reader sees each write once it's committed.
+    auto result = reader.get(fixture::tile);
+    ASSERT_TRUE(result && result->data);
+    EXPECT_EQ("first", *result->data);
+
+    response.data = std::make_shared<std::string>("second");
+    writer.put(fixture::tile, response);
+    result = reader.get(fixture::tile);
+    ASSERT_TRUE(result && result->data);
+    EXPECT_EQ("second", *result->data);
+
+    // Timestamps are updated through the writer; the reader leaves them alone.
+    reader.updateAccessed(fixture::tile);
+    writer.updateAccessed(fixture::tile);
+    EXPECT_EQ(std::make_pair(false, uint64_t(0)), reader.put(fixture::tile, response));
+
+    EXPECT_EQ(0u, log.uncheckedCount());
+}
+
@@ -18,6 +18,8 @@
 #include <mbgl/storage/sqlite3.hpp>
 #include <gtest/gtest.h>
 
+#include <set>
+
 using namespace mbgl;
 using namespace std::literals::string_literals;
 using mapbox::sqlite::ResultCode;
@@ -395,7 +397,17 @@ TEST(OfflineDownload, DoesNotFloodTheFileSourceWithRequests) {
     fileSource.respond(Resource::Kind::Style, test.response("style.json"));
     test.loop.runOnce();
 
-    EXPECT_EQ(*fileSource.getProperty(MAX_CONCURRENT_REQUESTS_KEY).getUint(), fileSource.requests.size());
+    // The number of concurrent requests ramps up as requests complete, up to the maximum.
+    const auto maxConcurrentRequests = *fileSource.getProperty(MAX_CONCURRENT_REQUESTS_KEY).getUint();
+    EXPECT_GT(maxConcurrentRequests, fileSource.requests.size());
+
+    for (int i = 0; i < 100 && !fileSource.requests.empty(); i++) {
+        fileSource.respond(fileSource.requests.front()->resource.kind, test.response("glyph.pbf"));
+        test.loop.runOnce();
+        EXPECT_GE(maxConcurrentRequests, fileSource.requests.size());
+    }
+
+    EXPECT_EQ(maxConcurrentRequests, fileSource.requests.size());
 }
 
 TEST(OfflineDownload, GetStatusNoResources) {
@@ -724,22 +736,22 @@ TEST(OfflineDownload, ReactivatePreviouslyCompletedDownload) {
 
     test.loop.run();
 
-    ASSERT_EQ(4u, statusesAfterReactivate.size());
+    ASSERT_EQ(3u, statusesAfterReactivate.size());
 
     EXPECT_EQ(OfflineRegionDownloadState::Active, statusesAfterReactivate[0].downloadState);
     EXPECT_FALSE(statusesAfterReactivate[0].requiredResourceCountIsPrecise);
     EXPECT_EQ(1u, statusesAfterReactivate[0].requiredResourceCount);
     EXPECT_EQ(0u, statusesAfterReactivate[0].completedResourceCount);
 
+    // The tile is covered by the checkpoint of the previous download, so it is
+    // counted along with the style.
     EXPECT_EQ(OfflineRegionDownloadState::Active, statusesAfterReactivate[1].downloadState);
     EXPECT_TRUE(statusesAfterReactivate[1].requiredResourceCountIsPrecise);
     EXPECT_EQ(2u, statusesAfterReactivate[1].requiredResourceCount);
-    EXPECT_EQ(1u, statusesAfterReactivate[1].completedResourceCount);
+    EXPECT_EQ(2u, statusesAfterReactivate[1].completedResourceCount);
+    EXPECT_EQ(1u, statusesAfterReactivate[1].completedTileCount);
 
-    EXPECT_EQ(OfflineRegionDownloadState::Active, statusesAfterReactivate[2].downloadState);
-    EXPECT_TRUE(statusesAfterReactivate[2].requiredResourceCountIsPrecise);
-    EXPECT_EQ(2u, statusesAfterReactivate[2].requiredResourceCount);
-    EXPECT_EQ(2u, statusesAfterReactivate[2].completedResourceCount);
+    EXPECT_EQ(OfflineRegionDownloadState::Inactive, statusesAfterReactivate[2].downloadState);
 }
 
 TEST(OfflineDownload, Deactivate) {
@@ -1052,6 +1064,134 @@ TEST(OfflineDownload, InterruptAndResume) {
     test.loop.run();
 }
 
+TEST(OfflineDownload, ResumeFromCheckpoint) {
+    OfflineTest test;
+    auto region = test.createRegion();
+    ASSERT_TRUE(region);
+    OfflineTilePyramidRegionDefinition definition(
+        "http://127.0.0.1:3000/style.json", LatLngBounds::world(), 0.0, 1.0, 1.0, true);
+
+    test.fileSource.styleResponse = [&](const Resource&) {
+        return test.response("inline_source.style.json");
+    };
+
+    // One of the five tiles doesn't exist.
+    unsigned tileRequests = 0;
+    test.fileSource.tileResponse = [&](const Resource& resource) {
+        tileRequests++;
+        if (resource.tileData->z == 1 && resource.tileData->x == 1 && resource.tileData->y == 1) {
+            Response response;
+            response.error = std::make_unique<Response::Error>(Response::Error::Reason::NotFound);
+            return response;
+        }
+        return test.response("0-0-0.vector.pbf");
+    };
+
+    OfflineRegionStatus completedStatus;
+    {
+        OfflineDownload download(region->getID(), definition, test.db, test.fileSource);
+        auto observer = std::make_unique<MockObserver>();
+        observer->statusChangedFn = [&](OfflineRegionStatus status) {
+            if (status.complete()) {
+                completedStatus = status;
+                test.loop.stop();
+            }
+        };
+        download.setObserver(std::move(observer));
+        download.setState(OfflineRegionDownloadState::Active);
+        test.loop.run();
+    }
+
+    EXPECT_EQ(5u, tileRequests);
+    EXPECT_EQ(4u, completedStatus.completedTileCount);
+
+    // The checkpoint stops at the missing tile.
+    const auto checkpoints = test.db.getRegionCheckpoints(region->getID());
+    ASSERT_EQ(1u, checkpoints.size());
+    const auto& checkpoint = checkpoints.at("http://127.0.0.1:3000/{z}-{x}-{y}.vector.pbf");
+    EXPECT_LT(checkpoint.position, 5u);
+    EXPECT_EQ(checkpoint.position, checkpoint.tileCount);
+
+    // The resumed download requests the missing tile again, and looks up the
+    // stored tiles past the checkpoint instead of requesting them.
+    OfflineDownload download(region->getID(), definition, test.db, test.fileSource);
+    auto observer = std::make_unique<MockObserver>();
+    observer->statusChangedFn = [&](OfflineRegionStatus status) {
+        if (status.complete()) {
+            EXPECT_EQ(completedStatus.requiredResourceCount, status.requiredResourceCount);
+            EXPECT_EQ(completedStatus.completedResourceCount, status.completedResourceCount);
+            EXPECT_EQ(completedStatus.completedTileCount, status.completedTileCount);
+            EXPECT_EQ(completedStatus.completedTileSize, status.completedTileSize);
+            test.loop.stop();
+        }
+    };
+    download.setObserver(std::move(observer));
+    download.setState(OfflineRegionDownloadState::Active);
+    test.loop.run();
+
+    EXPECT_EQ(6u, tileRequests);
+}
+
+TEST(OfflineDownload, DiscardCheckpointOfOtherZoomRange) {
+    OfflineTest test;
+    auto region = test.createRegion();
+    ASSERT_TRUE(region);
+    OfflineTilePyramidRegionDefinition definition(
+        "http://127.0.0.1:3000/style.json", LatLngBounds::world(), 0.0, 1.0, 1.0, true);
+
+    uint8_t minzoom = 1;
+    test.fileSource.styleResponse = [&](const Resource&) {
+        Response response;
+        response.data = std::make_shared<std::string>(
+            R"({"version": 8, "sources": {"inline": {"type": "vector", "minzoom": )" + std::to_string(minzoom) +
+            R"(, "maxzoom": 15, "tiles": ["http://127.0.0.1:3000/{z}-{x}-{y}.vector.pbf"]}},)"
+            R"( "layers": [{"id": "fill", "type": "fill", "source": "inline", "source-layer": "water"}]})");
+        return response;
+    };
+
+    std::set<std::string> requestedTiles;
+    test.fileSource.tileResponse = [&](const Resource& resource) {
+        const auto& tile = *resource.tileData;
+        requestedTiles.insert(std::to_string(tile.z) + "/" + std::to_string(tile.x) + "/" + std::to_string(tile.y));
+        return test.response("0-0-0.vector.pbf");
+    };
+
+    const auto download = [&](OfflineRegionStatus& completedStatus) {
+        OfflineDownload offlineDownload(region->getID(), definition, test.db, test.fileSource);
+        auto observer = std::make_unique<MockObserver>();
+        observer->statusChangedFn = [&](OfflineRegionStatus status) {
+            if (status.complete()) {
+                completedStatus = status;
+                test.loop.stop();
+            }
+        };
+        offlineDownload.setObserver(std::move(observer));
+        offlineDownload.setState(OfflineRegionDownloadState::Active);
+        test.loop.run();
+    };
+
+    // The source starts at z1: the checkpoint is past the four z1 tiles.
+    OfflineRegionStatus status;
+    download(status);
+    EXPECT_EQ(4u, status.completedTileCount);
+    const std::string urlTemplate = "http://127.0.0.1:3000/{z}-{x}-{y}.vector.pbf";
+    EXPECT_EQ(4u, test.db.getRegionCheckpoints(region->getID()).at(urlTemplate).position);
+
+    // Once the source starts at z0, the cover starts with the z0 tile. The old
+    // position would skip it along with three of the z1 tiles.
+    minzoom = 0;
+    requestedTiles.clear();
+    download(status);
+    EXPECT_EQ(5u, status.requiredTileCount);
+    EXPECT_EQ(5u, status.completedTileCount);
+    EXPECT_EQ(1u, requestedTiles.count("0/0/0"));
+
+    const auto checkpoint = test.db.getRegionCheckpoints(region->getID()).at(urlTemplate);
+    EXPECT_EQ(0u, checkpoint.zoomRange.min);
+    EXPECT_EQ(1u, checkpoint.zoomRange.max);
+    EXPECT_EQ(5u, checkpoint.position);
+}
+
 TEST(OfflineDownload, NoFreezingOnCachedTilesAndNewStyle) {
     OfflineTest test;
     auto region = test.createRegion();
@@ -589,6 +589,42 @@ TEST(OnlineFileSource, TEST_REQUIRES_SERVER(LowHighPriorityRequestsMany)) {
     loop.run();
 }
 
+TEST(OnlineFileSource, TEST_REQUIRES_SERVER(ChangePriority)) {
+    util::RunLoop loop;
+    std::unique_ptr<FileSource> fs = std::make_unique<OnlineFileSource>(ResourceOptions::Default(), ClientOptions());
+    std::vector<std::string> responses;
+
+    NetworkStatus::Set(NetworkStatus::Status::Offline);
+    fs->setProperty(MAX_CONCURRENT_REQUESTS_KEY, 1u);
+    fs->pause();
+
+    std::vector<std::unique_ptr<AsyncRequest>> requests;
+    auto request = [&](const std::string& name, Resource::Priority priority) {
+        Resource resource{Resource::Unknown, "http://127.0.0.1:3000/load/" + name};
+        resource.setPriority(priority);
+        requests.push_back(fs->request(resource, [&, name](Response) {
+            responses.push_back(name);
+            if (responses.size() == 4) {
+                loop.stop();
+            }
+        }));
+    };
+
+    request("1", Resource::Priority::Regular);
+    request("2", Resource::Priority::Low);
+    request("3", Resource::priorityAt(200));
+    request("4", Resource::priorityAt(64));
+
+    // Raised above all other requests before any of them was sent.
+    requests[1]->setPriority(Resource::Priority::High);
+
+    fs->resume();
+    NetworkStatus::Set(NetworkStatus::Status::Online);
+    loop.run();
+
+    EXPECT_EQ((std::vector<std::string>{"2", "4", "1", "3"}), responses);
+}
+
 TEST(OnlineFileSource, TEST_REQUIRES_SERVER(MaximumConcurrentRequests)) {
     util::RunLoop loop;
     std::unique_ptr<FileSource> fs = std::make_unique<OnlineFileSource>(ResourceOptions::Default(), ClientOptions());
@@ -0,0 +1,65 @@
+#include <mbgl/storage/response_buffer_pool.hpp>
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+using namespace mbgl;
+
+TEST(ResponseBufferPool, Reuse) {
+    auto pool = std::make_shared<ResponseBufferPool>();
+
+    auto buffer = pool->acquire(4096);
+    EXPECT_LE(4096u, buffer->capacity());
+    buffer->append(4096, 'x');
+    const std::string* released = buffer.get();
+    buffer.reset();
+    EXPECT_EQ(1u, pool->size());
+
+    // The buffer comes back empty, keeping its capacity
+    buffer = pool->acquire(1024);
+    EXPECT_EQ(released, buffer.get());
+    EXPECT_TRUE(buffer->empty());
+    EXPECT_LE(4096u, buffer->capacity());
+    EXPECT_EQ(0u, pool->size());
+}
+
+TEST(ResponseBufferPool, CapacityBound) {
+    auto pool = std::make_shared<ResponseBufferPool>();
+
+    auto large = pool->acquire(512 * 1024);
+    const std::string* released = large.get();
+    large.reset();
+    EXPECT_EQ(1u, pool->size());
+
+    // A small response doesn't pin the large buffer
+    auto small = pool->acquire(300);
+    EXPECT_NE(released, small.get());
+    EXPECT_GE(ResponseBufferPool::minReuseCapacity, small->capacity());
+    EXPECT_EQ(1u, pool->size());
+
+    // A response of about its size does reuse it
+    auto similar = pool->acquire(300 * 1024);
+    EXPECT_EQ(released, similar.get());
+    EXPECT_EQ(0u, pool->size());
+
+    // Buffers that grew too large aren't kept
+    similar->reserve(ResponseBufferPool::maxPooledCapacity + 1);
+    similar.reset();
+    EXPECT_EQ(0u, pool->size());
+}
+
+TEST(ResponseBufferPool, ReleaseOnOtherThread) {
+    auto pool = std::make_shared<ResponseBufferPool>();
+
+    auto buffer = pool->acquire(4096);
+    const std::string* released = buffer.get();
+    std::thread([data = std::move(buffer)]() mutable { data.reset(); }).join();
+    EXPECT_EQ(1u, pool->size());
+    EXPECT_EQ(released, pool->acquire(4096).get());
+
+    // Buffers released after the pool is gone are freed
+    buffer = pool->acquire(4096);
+    pool.reset();
+    buffer.reset();
+}
@@ -438,3 +438,40 @@ TEST(GlyphManager, ImmediateFileSource) {
 
     test.run("test/fixtures/resources/glyphs.pbf", GlyphDependencies{{{{"Test Stack"}}, {u'a', u'å', u' '}}});
 }
+
+TEST(GlyphManager, LoadLocalCJKGlyphForConcurrentRequestors) {
+    GlyphManagerTest test;
+    StubGlyphRequestor secondRequestor;
+    int notifications = 0;
+
+    test.fileSource.glyphsResponse = [&](const Resource&) {
+        ADD_FAILURE() << "Local glyphs should not be requested";
+        return std::optional<Response>();
+    };
+
+    auto checkGlyphs = [&](GlyphMap glyphs) {
+        const auto& testPositions = glyphs.at(FontStackHasher()({{"Test Stack"}}));
+
+        ASSERT_EQ(testPositions.size(), 1u);
+        ASSERT_TRUE(bool(testPositions.at(u'中')));
+
+        Immutable<Glyph> glyph = *testPositions.at(u'中');
+        EXPECT_EQ(glyph->bitmap.size, Size(30, 30));
+        EXPECT_EQ(glyph->bitmap.data[0], sdfBitmap[0]);
+
+        if (++notifications == 2) {
+            test.end();
+        }
+    };
+
+    test.requestor.glyphsAvailable = checkGlyphs;
+    secondRequestor.glyphsAvailable = checkGlyphs;
+
+    // The second request arrives while the SDF of the first is still being
+    // generated, and must be notified once it is available.
+    test.glyphManager.getGlyphs(
+        secondRequestor, GlyphDependencies{{{{"Test Stack"}}, {u'中'}}}, test.fileSource);
+    test.run("test/fixtures/resources/glyphs.pbf", GlyphDependencies{{{{"Test Stack"}}, {u'中'}}});
+
+    EXPECT_EQ(notifications, 2);
+}
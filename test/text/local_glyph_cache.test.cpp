@@ -0,0 +1,230 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/text/local_glyph_cache.hpp>
+#include <mbgl/util/io.hpp>
+
+using namespace mbgl;
+
+namespace {
+
+constexpr const char* cachePath = "test/fixtures/local_glyphs/local_glyph_cache.tmp";
+
+// Removes the cache file and the lock file its writers leave next to it
+void deleteCache() {
+    util::deleteFile(cachePath);
+    util::deleteFile(std::string(cachePath) + ".lock");
+}
+
+Immutable<Glyph> makeGlyph(GlyphID id, uint8_t fill) {
+    auto glyph = makeMutable<Glyph>();
+    glyph->id = id;
+    glyph->metrics.width = 24;
+    glyph->metrics.height = 24;
+    glyph->metrics.left = 0;
+    glyph->metrics.top = -8;
+    glyph->metrics.advance = 24;
+    glyph->bitmap = AlphaImage(Size(30, 30));
+    std::fill(glyph->bitmap.data.get(), glyph->bitmap.data.get() + glyph->bitmap.bytes(), fill);
+    return glyph;
+}
+
+} // namespace
+
+TEST(LocalGlyphCache, PersistsAcrossInstances) {
+    deleteCache();
+    const FontStack fontStack{"Test Stack"};
+
+    {
+        LocalGlyphCache cache(cachePath, std::string("sans-serif"));
+        EXPECT_FALSE(cache.get(fontStack, u'中'));
+
+        cache.put(fontStack, makeGlyph(u'中', 42));
+        cache.put(fontStack, makeGlyph(u'テ', 7));
+        cache.flush();
+    }
+
+    // Nothing is read from the file until it's loaded
+    LocalGlyphCache cache(cachePath, std::string("sans-serif"));
+    EXPECT_FALSE(cache.get(fontStack, u'中'));
+    cache.load();
+    EXPECT_EQ(2u, cache.size());
+    EXPECT_FALSE(cache.get(FontStack{"Other Stack"}, u'中'));
+
+    auto glyph = cache.get(fontStack, u'中');
+    ASSERT_TRUE(glyph);
+    EXPECT_EQ(u'中', (*glyph)->id);
+    EXPECT_EQ(makeGlyph(u'中', 42)->metrics, (*glyph)->metrics);
+    EXPECT_EQ(Size(30, 30), (*glyph)->bitmap.size);
+    EXPECT_EQ(makeGlyph(u'中', 42)->bitmap, (*glyph)->bitmap);
+
+    deleteCache();
+}
+
+TEST(LocalGlyphCache, DiscardsOtherFontFamily) {
+    deleteCache();
+    const FontStack fontStack{"Test Stack"};
+
+    {
+        LocalGlyphCache cache(cachePath, std::string("sans-serif"));
+        cache.put(fontStack, makeGlyph(u'中', 42));
+        cache.flush();
+    }
+
+    LocalGlyphCache cache(cachePath, std::string("serif"));
+    cache.load();
+    EXPECT_EQ(0u, cache.size());
+    EXPECT_FALSE(cache.get(fontStack, u'中'));
+
+    deleteCache();
+}
+
+TEST(LocalGlyphCache, IgnoresCorruptFile) {
+    util::write_file(cachePath, "MLNG garbage");
+
+    LocalGlyphCache cache(cachePath, std::string("sans-serif"));
+    cache.load();
+    EXPECT_EQ(0u, cache.size());
+
+    deleteCache();
+}
+
+TEST(LocalGlyphCache, AppendsEachFlush) {
+    deleteCache();
+    const FontStack fontStack{"Test Stack"};
+
+    LocalGlyphCache cache(cachePath, std::string("sans-serif"));
+    cache.put(fontStack, makeGlyph(u'中', 42));
+    cache.flush();
+    const std::string first = util::read_file(cachePath);
+
+    // Only the new glyph is written, after what's already there
+    cache.put(fontStack, makeGlyph(u'テ', 7));
+    cache.flush();
+    const std::string second = util::read_file(cachePath);
+    EXPECT_EQ(first, second.substr(0, first.size()));
+    EXPECT_LT(first.size(), second.size());
+
+    // Flushing without new glyphs writes nothing
+    cache.flush();
+    EXPECT_EQ(second, util::read_file(cachePath));
+
+    LocalGlyphCache reloaded(cachePath, std::string("sans-serif"));
+    reloaded.load();
+    EXPECT_EQ(2u, reloaded.size());
+    EXPECT_TRUE(reloaded.get(fontStack, u'テ'));
+
+    deleteCache();
+}
+
+TEST(LocalGlyphCache, KeepsBatchesBeforeTruncation) {
+    deleteCache();
+    const FontStack fontStack{"Test Stack"};
+
+    {
+        LocalGlyphCache cache(cachePath, std::string("sans-serif"));
+        cache.put(fontStack, makeGlyph(u'中', 42));
+        cache.flush();
+        cache.put(fontStack, makeGlyph(u'テ', 7));
+        cache.flush();
+    }
+
+    // As if the last append was interrupted
+    const std::string data = util::read_file(cachePath);
+    util::write_file(cachePath, data.substr(0, data.size() - 10));
+
+    {
+        LocalGlyphCache cache(cachePath, std::string("sans-serif"));
+        cache.load();
+        EXPECT_EQ(1u, cache.size());
+        EXPECT_TRUE(cache.get(fontStack, u'中'));
+
+        // The next flush rewrites the file rather than appending after the broken batch
+        cache.put(fontStack, makeGlyph(u'ア', 1));
+        cache.flush();
+    }
+
+    LocalGlyphCache cache(cachePath, std::string("sans-serif"));
+    cache.load();
+    EXPECT_EQ(2u, cache.size());
+    EXPECT_TRUE(cache.get(fontStack, u'中'));
+    EXPECT_TRUE(cache.get(fontStack, u'ア'));
+
+    deleteCache();
+}
+
+TEST(LocalGlyphCache, EvictsLeastRecentlyUsed) {
+    deleteCache();
+    const FontStack fontStack{"Test Stack"};
+
+    // Room for about three glyphs of 30x30 pixels
+    constexpr std::size_t maxSize = 3 * 1024;
+
+    {
+        LocalGlyphCache cache(cachePath, std::string("sans-serif"), maxSize);
+        cache.put(fontStack, makeGlyph(u'一', 1));
+        cache.put(fontStack, makeGlyph(u'二', 2));
+        cache.put(fontStack, makeGlyph(u'三', 3));
+        EXPECT_EQ(3u, cache.size());
+
+        EXPECT_TRUE(cache.get(fontStack, u'一'));
+        cache.put(fontStack, makeGlyph(u'四', 4));
+        EXPECT_EQ(3u, cache.size());
+        EXPECT_TRUE(cache.get(fontStack, u'一'));
+        EXPECT_FALSE(cache.get(fontStack, u'二'));
+        cache.flush();
+
+        // The file is rewritten once it holds about twice the glyphs the cache keeps
+        for (char16_t id = u'a'; id <= u'z'; ++id) {
+            cache.put(fontStack, makeGlyph(id, 5));
+            cache.flush();
+        }
+    }
+
+    LocalGlyphCache cache(cachePath, std::string("sans-serif"));
+    cache.load();
+    EXPECT_LE(3u, cache.size());
+    EXPECT_GE(6u, cache.size());
+    EXPECT_TRUE(cache.get(fontStack, u'z'));
+    EXPECT_FALSE(cache.get(fontStack, u'一'));
+
+    deleteCache();
+}
+
+TEST(LocalGlyphCache, SharesFileWithOtherCaches) {
+    deleteCache();
+    const FontStack fontStack{"Test Stack"};
+
+    // Two renderers with the same cache path, and one with another font family
+    LocalGlyphCache first(cachePath, std::string("sans-serif"));
+    LocalGlyphCache second(cachePath, std::string("sans-serif"));
+    LocalGlyphCache other(cachePath, std::string("serif"));
+    first.load();
+    second.load();
+
+    first.put(fontStack, makeGlyph(u'中', 42));
+    first.flush();
+    second.put(fontStack, makeGlyph(u'テ', 7));
+    second.flush();
+
+    {
+        LocalGlyphCache reloaded(cachePath, std::string("sans-serif"));
+        reloaded.load();
+        EXPECT_TRUE(reloaded.get(fontStack, u'中'));
+        EXPECT_TRUE(reloaded.get(fontStack, u'テ'));
+    }
+
+    // The other font family replaces the file, so the next flush of the first
+    // cache rewrites it rather than appending to a file for another family
+    other.put(fontStack, makeGlyph(u'ア', 1));
+    other.flush();
+    first.put(fontStack, makeGlyph(u'一', 2));
+    first.flush();
+
+    LocalGlyphCache reloaded(cachePath, std::string("sans-serif"));
+    reloaded.load();
+    EXPECT_TRUE(reloaded.get(fontStack, u'中'));
+    EXPECT_TRUE(reloaded.get(fontStack, u'一'));
+    EXPECT_FALSE(reloaded.get(fontStack, u'ア'));
+
+    deleteCache();
+}
@@ -275,3 +275,34 @@ TEST(getIconQuads, style) {
         EXPECT_FLOAT_EQ(quad.br.y, 26.666666f);
     }
 }
+
+TEST(PackedSymbolQuad, FixedPointEncoding) {
+    const SymbolQuad quad({-14.0f, -10.0f},
+                          {1.0f, -10.0f},
+                          {-14.0f, 1.25f},
+                          {1.0f, 1.25f},
+                          {2, 3, 15, 11},
+                          WritingModeType::Horizontal,
+                          {3.5f, -0.5f},
+                          true,
+                          {-1.0f, 0.5f},
+                          {2.0f, 1.5f},
+                          {0.5f, 1.0f},
+                          7);
+    const PackedSymbolQuad packed(quad);
+
+    EXPECT_EQ(packed.tl, Point<int16_t>(-448, -336));
+    EXPECT_EQ(packed.tr, Point<int16_t>(32, -336));
+    EXPECT_EQ(packed.bl, Point<int16_t>(-448, 24));
+    EXPECT_EQ(packed.br, Point<int16_t>(32, 24));
+    EXPECT_EQ(packed.tex, quad.tex);
+    EXPECT_EQ(packed.pixelOffsetTL, Point<int16_t>(-16, 8));
+    EXPECT_EQ(packed.pixelOffsetBR, Point<int16_t>(32, 24));
+    EXPECT_EQ(packed.minFontScale, Point<int16_t>(128, 256));
+    EXPECT_FLOAT_EQ(packed.glyphOffsetX, 3.5f);
+    EXPECT_EQ(packed.sectionIndex, 7);
+    EXPECT_TRUE(packed.isSDF);
+
+    // The packed form is what symbol instances retain until bucket creation.
+    EXPECT_LE(sizeof(PackedSymbolQuad) * 2, sizeof(SymbolQuad));
+}
@@ -72,6 +72,49 @@ TEST(VectorTile, Issue8542) {
     tile.querySourceFeatures(result, {{{"layer"}}, {}});
 }
 
+namespace {
+
+class CacheFakeFileSource : public FakeFileSource {
+public:
+    bool supportsCacheOnlyRequests() const override { return true; }
+};
+
+} // namespace
+
+TEST(VectorTile, StaleWhileRevalidate) {
+    using namespace std::chrono_literals;
+
+    for (const bool staleWhileRevalidate : {false, true}) {
+        VectorTileTest test;
+        auto fileSource = std::make_shared<CacheFakeFileSource>();
+        test.tileParameters.fileSource = fileSource;
+
+        VectorTile tile(OverscaledTileID(0, 0, 0), "source", test.tileParameters, test.tileset);
+        tile.setUpdateParameters({Duration::zero(), false, staleWhileRevalidate});
+        tile.setNecessity(TileNecessity::Required);
+
+        // The cached tile has expired and must be revalidated.
+        Response cached;
+        cached.data = std::make_shared<std::string>("data");
+        cached.etag = "etag";
+        cached.expires = util::now() - 1h;
+        cached.mustRevalidate = true;
+        cached.error = std::make_unique<Response::Error>(Response::Error::Reason::NotFound,
+                                                         "Cached resource is unusable");
+        ASSERT_EQ(1u, fileSource->requests.size());
+        EXPECT_EQ(Resource::LoadingMethod::CacheOnly, fileSource->requests.front()->resource.loadingMethod);
+        ASSERT_TRUE(fileSource->respond(Resource::Tile, cached));
+
+        // The tile is revalidated either way, but only shows the stale data in the meantime when allowed to.
+        ASSERT_EQ(1u, fileSource->requests.size());
+        const Resource& revalidation = fileSource->requests.front()->resource;
+        EXPECT_EQ(Resource::LoadingMethod::NetworkOnly, revalidation.loadingMethod);
+        EXPECT_EQ(std::optional<std::string>("etag"), revalidation.priorEtag);
+        EXPECT_EQ(staleWhileRevalidate, bool(tile.expires));
+        EXPECT_EQ(staleWhileRevalidate, !revalidation.priorData);
+    }
+}
+
 TEST(VectorTileData, ParseResults) {
     VectorTileData data(std::make_shared<std::string>(util::read_file("test/fixtures/map/issue12432/0-0-0.mvt")));
 
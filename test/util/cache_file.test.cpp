@@ -0,0 +1,73 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/util/cache_file.hpp>
+#include <mbgl/util/io.hpp>
+
+#include <thread>
+#include <vector>
+
+using namespace mbgl;
+using namespace mbgl::util::cache_file;
+
+namespace {
+
+constexpr const char* cachePath = "test/fixtures/cache_file.tmp";
+
+} // namespace
+
+TEST(CacheFile, ReadsWhatWasWritten) {
+    std::string data;
+    write<uint32_t>(data, 42);
+    writeString(data, "value");
+    write<int16_t>(data, -1);
+
+    Reader reader(data);
+    uint32_t number = 0;
+    std::string string;
+    int16_t negative = 0;
+    EXPECT_TRUE(reader.read(number));
+    EXPECT_TRUE(reader.readString(string));
+    EXPECT_TRUE(reader.read(negative));
+    EXPECT_TRUE(reader.empty());
+    EXPECT_EQ(42u, number);
+    EXPECT_EQ("value", string);
+    EXPECT_EQ(-1, negative);
+
+    // Reads past the end fail rather than reading out of bounds
+    EXPECT_FALSE(reader.read(number));
+    const std::string truncated = data.substr(0, 8);
+    Reader truncatedReader(truncated);
+    EXPECT_TRUE(truncatedReader.read(number));
+    EXPECT_FALSE(truncatedReader.readString(string));
+}
+
+TEST(CacheFile, ConcurrentWriters) {
+    util::deleteFile(cachePath);
+
+    // Each writer replaces the file with its own contents, or appends a record
+    // to it, under the lock. Every record ends up complete.
+    constexpr int writers = 8;
+    const std::string record(4096, 'x');
+    std::vector<std::thread> threads;
+    for (int i = 0; i < writers; ++i) {
+        threads.emplace_back([&, i] {
+            const Lock lock(cachePath);
+            if (i == 0) {
+                EXPECT_TRUE(replace(cachePath, record));
+            } else {
+                EXPECT_TRUE(append(cachePath, record));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    const std::string data = util::read_file(cachePath);
+    EXPECT_EQ(0u, data.size() % record.size());
+    EXPECT_LE(record.size(), data.size());
+    EXPECT_EQ(std::string(data.size(), 'x'), data);
+
+    util::deleteFile(cachePath);
+    util::deleteFile(std::string(cachePath) + ".lock");
+}
@@ -55,3 +55,20 @@ TEST(GridIndex, IndexesFeaturesOverflow) {
     grid.insert(0, {{4500, 4500}, {4900, 4900}});
     EXPECT_EQ(grid.query({{4000, 4000}, {5000, 5000}}), (std::vector<int16_t>{0}));
 }
+
+TEST(GridIndex, Merge) {
+    GridIndex<int16_t> grid(100, 100, 10);
+    grid.insert(0, {{4, 10}, {6, 30}});
+    grid.insert(1, {{50, 50}, 10});
+
+    GridIndex<int16_t> other(100, 100, 10);
+    other.insert(2, {{4, 10}, {30, 12}});
+    other.insert(3, {{60, 60}, 15});
+
+    grid.merge(other);
+
+    EXPECT_EQ(grid.query({{4, 10}, {5, 11}}), (std::vector<int16_t>{0, 2}));
+    EXPECT_EQ(grid.query({{45, 45}, {55, 55}}), (std::vector<int16_t>{1, 3}));
+    EXPECT_EQ(grid.query({{-1000, -1000}, {1000, 1000}}), (std::vector<int16_t>{0, 2, 1, 3}));
+    EXPECT_TRUE(grid.hitTest({{70, 70}, 2}));
+}
@@ -4,6 +4,7 @@
 #include <mbgl/math/angles.hpp>
 
 #include <algorithm>
+#include <limits>
 #include <cstdlib> /* srand, rand */
 #include <ctime>   /* time */
 #include <gtest/gtest.h>
@@ -456,6 +457,112 @@ TEST(TileCover, GeomInvalid) {
               util::tileCover(badPoly, 10));
 }
 
+namespace {
+
+std::vector<UnwrappedTileID> streamedTileCover(const LatLngBounds& bounds, uint8_t minZoom, uint8_t maxZoom) {
+    std::vector<UnwrappedTileID> result;
+    for (uint8_t z = minZoom; z <= maxZoom; z++) {
+        util::TileCover tc(bounds, z);
+        while (tc.hasNext()) {
+            result.push_back(*tc.next());
+        }
+    }
+    return result;
+}
+
+} // namespace
+
+TEST(TileCoverStream, Skip) {
+    const auto expected = streamedTileCover(sanFrancisco, 13, 13);
+    ASSERT_LT(4u, expected.size());
+
+    for (uint64_t count = 0; count <= expected.size() + 1; count++) {
+        util::TileCover tc(sanFrancisco, 13);
+        EXPECT_EQ(std::min<uint64_t>(count, expected.size()), tc.skip(count));
+        if (count < expected.size()) {
+            EXPECT_EQ(expected[count], *tc.next());
+        } else {
+            EXPECT_FALSE(tc.hasNext());
+        }
+    }
+}
+
+TEST(TileCoverIterator, ZoomRange) {
+    const auto expected = streamedTileCover(sanFrancisco, 0, 13);
+
+    util::TileCoverIterator iterator(sanFrancisco, {0, 13});
+    std::vector<UnwrappedTileID> actual;
+    while (iterator.hasNext()) {
+        actual.push_back(*iterator.next());
+    }
+
+    EXPECT_EQ(expected, actual);
+    EXPECT_EQ(expected.size(), iterator.cursor().position);
+    EXPECT_FALSE(iterator.next());
+}
+
+TEST(TileCoverIterator, Resume) {
+    const auto expected = streamedTileCover(sanFrancisco, 10, 13);
+
+    for (size_t interrupted = 0; interrupted <= expected.size(); interrupted++) {
+        std::string saved;
+        {
+            util::TileCoverIterator iterator(sanFrancisco, {10, 13});
+            for (size_t i = 0; i < interrupted; i++) {
+                iterator.next();
+            }
+            saved = iterator.cursor().serialize();
+        }
+
+        const auto cursor = util::TileCoverIterator::Cursor::deserialize(saved);
+        ASSERT_TRUE(cursor);
+        EXPECT_EQ(interrupted, cursor->position);
+
+        util::TileCoverIterator iterator(sanFrancisco, {10, 13}, *cursor);
+        std::vector<UnwrappedTileID> rest;
+        while (iterator.hasNext()) {
+            rest.push_back(*iterator.next());
+        }
+        EXPECT_EQ(std::vector<UnwrappedTileID>(expected.begin() + interrupted, expected.end()), rest);
+    }
+}
+
+TEST(TileCoverIterator, Shards) {
+    const auto expected = streamedTileCover(sanFrancisco, 0, 14);
+    const auto shards = util::TileCoverIterator::shards(expected.size(), 3);
+    ASSERT_EQ(3u, shards.size());
+
+    std::vector<UnwrappedTileID> actual;
+    for (const auto& shard : shards) {
+        util::TileCoverIterator iterator(sanFrancisco, {0, 14}, shard);
+        size_t count = 0;
+        while (iterator.hasNext()) {
+            actual.push_back(*iterator.next());
+            count++;
+        }
+        EXPECT_LE(expected.size() / 3, count);
+        EXPECT_GE(expected.size() / 3 + 1, count);
+    }
+    EXPECT_EQ(expected, actual);
+
+    EXPECT_EQ(std::numeric_limits<uint64_t>::max(), shards.back().end);
+    EXPECT_TRUE(util::TileCoverIterator::shards(10, 0).empty());
+}
+
+TEST(TileCoverIterator, CursorSerialization) {
+    const util::TileCoverIterator::Cursor cursor{12, 345};
+    EXPECT_EQ("12-345", cursor.serialize());
+    EXPECT_EQ(cursor, util::TileCoverIterator::Cursor::deserialize("12-345"));
+
+    const util::TileCoverIterator::Cursor open;
+    EXPECT_EQ(open, util::TileCoverIterator::Cursor::deserialize(open.serialize()));
+
+    for (const auto* invalid :
+         {"", "12", "12-", "-345", "a-345", "12-345-6", "345-12", " 12-345", "1-99999999999999999999"}) {
+        EXPECT_FALSE(util::TileCoverIterator::Cursor::deserialize(invalid)) << invalid;
+    }
+}
+
 TEST(TileCount, World) {
     EXPECT_EQ(1u, util::tileCount(LatLngBounds::world(), 0));
     EXPECT_EQ(4u, util::tileCount(LatLngBounds::world(), 1));